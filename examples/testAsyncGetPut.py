@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+
+#
+# Issues asynchronous puts and gets on a set of channels. All requests
+# are in flight at the same time, and callbacks are invoked as they
+# complete.
+#
+# Usage: testAsyncGetPut.py [channelName ...]
+#
+
+import sys
+import time
+import threading
+
+from pvaccess import *
+
+channelNames = ['float01', 'float02', 'float03']
+if len(sys.argv) > 1:
+    channelNames = sys.argv[1:]
+
+channels = map(Channel, channelNames)
+event = threading.Event()
+nPending = [0]
+
+def requestDone():
+    nPending[0] -= 1
+    if nPending[0] == 0:
+        event.set()
+
+def makeCallbacks(channelName):
+    def putDone():
+        print 'Put done: ', channelName
+        requestDone()
+    def getDone(pv):
+        print 'Got value: ', channelName, pv.getFloat()
+        requestDone()
+    def error(message):
+        print 'Request failed: ', channelName, message
+        requestDone()
+    return (putDone, getDone, error)
+
+startTime = time.time()
+nPending[0] = 2*len(channels)
+for (channelName, c) in zip(channelNames, channels):
+    (putDone, getDone, error) = makeCallbacks(channelName)
+    c.asyncPut(PvFloat(1.1), putDone, error)
+    c.asyncGet(getDone, error)
+
+event.wait(10)
+print 'Completed %d requests in %.3f seconds' % (2*len(channels), time.time()-startTime)
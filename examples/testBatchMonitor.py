@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+
+#
+# Receives monitor updates in batches. Batch subscriber is called with a
+# list of PV objects, so that python GIL is acquired once per batch.
+#
+# Usage: testBatchMonitor.py [channelName [batchSize [batchTime]]]
+#
+
+import sys
+import time
+
+from pvaccess import Channel
+
+channelName = 'float01'
+batchSize = 100
+batchTime = 0.1
+if len(sys.argv) > 1:
+    channelName = sys.argv[1]
+if len(sys.argv) > 2:
+    batchSize = int(sys.argv[2])
+if len(sys.argv) > 3:
+    batchTime = float(sys.argv[3])
+
+nUpdates = 0
+nBatches = 0
+def echoBatch(pvObjects):
+    global nUpdates, nBatches
+    nUpdates += len(pvObjects)
+    nBatches += 1
+    print 'Got %d updates, last value: %s' % (len(pvObjects), pvObjects[-1])
+
+c = Channel(channelName)
+c.setMonitorBatchSize(batchSize)
+c.setMonitorBatchTime(batchTime)
+c.subscribeBatch('echoBatch', echoBatch)
+c.startMonitor()
+time.sleep(10)
+c.stopMonitor()
+c.unsubscribe('echoBatch')
+
+if nBatches > 0:
+    print 'Received %d updates in %d batches (%.2f updates/batch)' % (nUpdates, nBatches, float(nUpdates)/nBatches)
+else:
+    print 'No updates received'
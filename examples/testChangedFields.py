@@ -0,0 +1,34 @@
+#!/usr/bin/env python
+
+#
+# Prints fields changed in each monitor update, and converts only
+# changed fields to python dictionary.
+#
+# Usage: testChangedFields.py [channelName [requestDescriptor]]
+#
+
+import sys
+import time
+
+from pvaccess import Channel
+
+channelName = 'float01'
+requestDescriptor = 'field(value,alarm,timeStamp)'
+if len(sys.argv) > 1:
+    channelName = sys.argv[1]
+if len(sys.argv) > 2:
+    requestDescriptor = sys.argv[2]
+
+def echo(pv):
+    print 'Changed fields: ', pv.getChangedFields()
+    overrunFields = pv.getOverrunFields()
+    if len(overrunFields):
+        print 'Overrun fields: ', overrunFields
+    print 'Changed values: ', pv.toDict(changedOnly=True)
+
+c = Channel(channelName)
+c.subscribe('echo', echo)
+c.startMonitor(requestDescriptor)
+time.sleep(10)
+c.stopMonitor()
+c.unsubscribe('echo')
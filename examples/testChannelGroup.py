@@ -0,0 +1,42 @@
+#!/usr/bin/env python
+
+#
+# Reads and writes a group of channels with a single request per group
+# operation, and compares timing with per-channel get() calls.
+#
+# Usage: testChannelGroup.py [channelName ...]
+#
+
+import sys
+import time
+
+from pvaccess import *
+
+channelNames = ['float01', 'float02', 'float03', 'double01', 'int01']
+if len(sys.argv) > 1:
+    channelNames = sys.argv[1:]
+
+startTime = time.time()
+group = ChannelGroup(channelNames)
+print 'Connected group of %d channels in %.3f seconds' % (len(channelNames), time.time()-startTime)
+for (name,error) in group.getStatus().items():
+    if error:
+        print 'Channel %s error: %s' % (name, error)
+
+startTime = time.time()
+pvDict = group.get()
+print 'Group get completed in %.3f seconds' % (time.time()-startTime)
+for (name,pv) in pvDict.items():
+    print name, pv.getObject('value')
+
+startTime = time.time()
+for name in channelNames:
+    try:
+        Channel(name).get()
+    except Exception, ex:
+        print 'Channel %s error: %s' % (name, ex)
+print 'Sequential get completed in %.3f seconds' % (time.time()-startTime)
+
+# Write values back
+group.put(pvDict)
+print 'Group put status: ', group.getStatus()
@@ -0,0 +1,40 @@
+#!/usr/bin/env python
+
+#
+# Creates channels without waiting for connections, and reports
+# connections as they complete in the background.
+#
+# Usage: testLazyConnect.py [channelName ...]
+#
+
+import sys
+import time
+
+from pvaccess import *
+
+channelNames = ['float01', 'float02', 'float03', 'doesNotExist']
+if len(sys.argv) > 1:
+    channelNames = sys.argv[1:]
+
+def makeCallbacks(channelName):
+    def connected():
+        print 'Connected: ', channelName
+    def failed(message):
+        print 'Failed to connect: ', channelName, message
+    return (connected, failed)
+
+startTime = time.time()
+channels = {}
+for name in channelNames:
+    c = Channel(name, PVA, False)
+    (connected, failed) = makeCallbacks(name)
+    c.asyncConnect(connected, failed)
+    channels[name] = c
+print 'Created %d channels in %.3f seconds' % (len(channelNames), time.time()-startTime)
+
+# First operation on each channel waits for its connection
+for (name,c) in channels.items():
+    try:
+        print name, c.get()
+    except Exception, ex:
+        print 'Get failed: ', name, ex
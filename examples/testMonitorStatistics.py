@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+
+#
+# Monitors channel with a slow subscriber and bounded queue, and prints
+# monitor queue statistics for the selected overflow policy.
+#
+# Usage: testMonitorStatistics.py [channelName [maxQueueLength [policy]]]
+#
+# Policy is one of DROP_OLDEST, DROP_NEWEST, COALESCE_TO_LATEST or
+# BLOCK_PRODUCER.
+#
+
+import sys
+import time
+
+import pvaccess
+from pvaccess import Channel
+
+channelName = 'float01'
+maxQueueLength = 10
+policyName = 'DROP_OLDEST'
+if len(sys.argv) > 1:
+    channelName = sys.argv[1]
+if len(sys.argv) > 2:
+    maxQueueLength = int(sys.argv[2])
+if len(sys.argv) > 3:
+    policyName = sys.argv[3]
+
+def slowEcho(pv):
+    print 'Changed fields: %s' % pv.getChangedFields()
+    time.sleep(0.5)
+
+c = Channel(channelName)
+c.setMonitorMaxQueueLength(maxQueueLength)
+c.setMonitorOverflowPolicy(getattr(pvaccess, policyName))
+c.subscribe('slowEcho', slowEcho)
+c.startMonitor()
+for i in range(0,5):
+    time.sleep(2)
+    print 'Monitor statistics: %s' % c.getMonitorStatistics()
+c.stopMonitor()
+c.unsubscribe('slowEcho')
+
+statistics = c.getMonitorStatistics()
+print 'Final monitor statistics: %s' % statistics
+print 'Received %d updates, delivered %d, dropped %d' % (statistics['received'], statistics['delivered'], statistics['dropped'])
@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+
+#
+# Creates large NT table from NumPy arrays and compares column transfer
+# costs of NumPy and list based NtTable methods.
+#
+# Usage: testNtTableNumpy.py [nRows]
+#
+
+import sys
+import time
+import collections
+import numpy
+
+from pvaccess import NtTable
+from pvaccess import DOUBLE
+
+nRows = 100000
+if len(sys.argv) > 1:
+    nRows = int(sys.argv[1])
+
+# Table from dictionary of column arrays
+columns = collections.OrderedDict()
+columns['id'] = numpy.arange(nRows, dtype=numpy.int32)
+columns['x'] = numpy.random.uniform(0, 1, nRows)
+columns['y'] = numpy.random.uniform(0, 1, nRows).astype(numpy.float32)
+startTime = time.time()
+ntTable = NtTable(columns)
+print 'Created %d x %d table from arrays in %.3f s' % (nRows, ntTable.getNColumns(), time.time()-startTime)
+print 'Labels: ', ntTable.getLabels()
+print 'Column types: ', [ntTable.getColumnAsNumpy(i).dtype for i in range(0, ntTable.getNColumns())]
+
+# Table from record array
+recordArray = numpy.zeros(nRows, dtype=[('name', 'S8'), ('value', numpy.float64), ('valid', numpy.bool_)])
+recordArray['name'] = 'row'
+recordArray['value'] = numpy.random.uniform(0, 1, nRows)
+recordArray['valid'] = recordArray['value'] > 0.5
+ntTable2 = NtTable(recordArray)
+print 'Created %d x %d table from record array' % (nRows, ntTable2.getNColumns())
+print 'Labels: ', ntTable2.getLabels()
+
+# Column transfer costs
+values = numpy.random.uniform(0, 1, nRows)
+valueList = values.tolist()
+ntTable3 = NtTable(1, DOUBLE)
+
+startTime = time.time()
+ntTable3.setColumn(0, valueList)
+listSetDuration = time.time()-startTime
+startTime = time.time()
+ntTable3.setColumn(0, values)
+numpySetDuration = time.time()-startTime
+print 'setColumn(): list %.4f s, NumPy array %.4f s' % (listSetDuration, numpySetDuration)
+
+startTime = time.time()
+ntTable3.getColumn(0)
+listGetDuration = time.time()-startTime
+startTime = time.time()
+column = ntTable3.getColumnAsNumpy(0)
+numpyGetDuration = time.time()-startTime
+print 'getColumn(): %.4f s, getColumnAsNumpy(): %.4f s' % (listGetDuration, numpyGetDuration)
+print 'Column data matches: ', numpy.array_equal(column, values)
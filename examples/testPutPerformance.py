@@ -0,0 +1,42 @@
+#!/usr/bin/env python
+
+#
+# Measures average cost of a channel put. Typed puts (e.g., putDouble())
+# write values directly into the channel PV, while putString() exercises
+# string formatting/parsing that all scalar puts used to go through.
+#
+# Usage: testPutPerformance.py [channelName [nPuts]]
+#
+
+import sys
+import time
+
+from pvaccess import Channel
+
+channelName = 'double01'
+nPuts = 10000
+if len(sys.argv) > 1:
+    channelName = sys.argv[1]
+if len(sys.argv) > 2:
+    nPuts = int(sys.argv[2])
+
+c = Channel(channelName)
+
+def measure(description, putMethod, convert):
+    # Warm up connection and cached put objects
+    putMethod(convert(0.0))
+    startTime = time.time()
+    for i in range(0,nPuts):
+        putMethod(convert(i*1.1))
+    duration = time.time() - startTime
+    print '%-30s %10.2f us/put' % (description, duration/nPuts*1000000)
+    return duration
+
+print 'Channel %s, %d puts' % (channelName, nPuts)
+stringDuration = measure('putString(str(value)):', c.putString, str)
+doubleDuration = measure('putDouble(value):', c.putDouble, float)
+print 'Speedup: %.2f' % (stringDuration/doubleDuration)
+
+value = 1.0/3.0
+c.putDouble(value)
+print 'Precision check (1/3): put %r, got %r' % (value, c.get().getDouble())
@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+
+#
+# Compares costs of creating PV objects of the same type from structure
+# dictionary, with PvObject.fromTemplate(), and with PvObject.clone().
+#
+# Usage: testPvObjectCreation.py [nObjects]
+#
+
+import sys
+import time
+
+from pvaccess import PvObject
+from pvaccess import NtTable
+from pvaccess import INT
+from pvaccess import DOUBLE
+from pvaccess import STRING
+
+nObjects = 10000
+if len(sys.argv) > 1:
+    nObjects = int(sys.argv[1])
+
+structureDict = {'nRows' : INT, 'name' : STRING, 'values' : [DOUBLE], 'limits' : {'low' : DOUBLE, 'high' : DOUBLE}}
+templatePv = PvObject(structureDict)
+templatePv.set({'nRows' : 3, 'name' : 'template', 'values' : [1.0, 2.0, 3.0]})
+
+def measure(description, createMethod):
+    startTime = time.time()
+    for i in range(0,nObjects):
+        createMethod()
+    duration = time.time() - startTime
+    print '%-30s %10.2f us/object' % (description, duration/nObjects*1000000)
+    return duration
+
+print 'Creating %d objects' % nObjects
+dictDuration = measure('PvObject(structureDict):', lambda: PvObject(structureDict))
+templateDuration = measure('PvObject.fromTemplate(pv):', lambda: PvObject.fromTemplate(templatePv))
+measure('pv.clone():', templatePv.clone)
+measure('NtTable(10, DOUBLE):', lambda: NtTable(10, DOUBLE))
+print 'Template speedup: %.2f' % (dictDuration/templateDuration)
+
+pv = templatePv.clone()
+pv.setString('name', 'clone')
+print 'Template: ', templatePv.toDict()
+print 'Clone: ', pv.toDict()
+print 'From template: ', PvObject.fromTemplate(templatePv).toDict()
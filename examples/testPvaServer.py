@@ -0,0 +1,32 @@
+#!/usr/bin/env python
+
+#
+# Publishes PV object as a channel and updates it periodically. Channel
+# can be monitored with, e.g., 'pvget -m pair' or testChannelMonitor.py.
+#
+# Usage: testPvaServer.py [channelName [nUpdates]]
+#
+
+import sys
+import time
+
+from pvaccess import PvaServer
+from pvaccess import PvObject
+from pvaccess import INT
+
+channelName = 'pair'
+nUpdates = 100
+if len(sys.argv) > 1:
+    channelName = sys.argv[1]
+if len(sys.argv) > 2:
+    nUpdates = int(sys.argv[2])
+
+pv = PvObject({'x' : INT, 'y' : INT}, {'x' : 0, 'y' : 0})
+server = PvaServer(channelName, pv)
+print 'Serving channels: %s' % server.getRecordNames()
+for i in range(0,nUpdates):
+    time.sleep(1)
+    pv = PvObject({'x' : INT, 'y' : INT}, {'x' : i, 'y' : 2*i})
+    server.update(pv)
+    print 'Updated channel %s: %s' % (channelName, pv.toDict())
+server.stop()
@@ -0,0 +1,45 @@
+#!/usr/bin/env python
+
+#
+# Issues many asynchronous requests to createNtTable service (see
+# testRpcServer.py), and waits for all responses.
+#
+# Usage: testRpcClientAsync.py [nRequests]
+#
+
+import sys
+import time
+import threading
+
+import pvaccess
+
+nRequests = 1000
+if len(sys.argv) > 1:
+    nRequests = int(sys.argv[1])
+
+lock = threading.Lock()
+nResponses = [0]
+nErrors = [0]
+
+def echo(response):
+    lock.acquire()
+    nResponses[0] += 1
+    lock.release()
+
+def error(message):
+    lock.acquire()
+    nErrors[0] += 1
+    lock.release()
+    print 'Request failed: %s' % message
+
+rpc = pvaccess.RpcClient('createNtTable')
+request = pvaccess.PvObject({'nRows' : pvaccess.INT, 'nColumns' : pvaccess.INT})
+request.set({'nRows' : 10, 'nColumns' : 10})
+
+startTime = time.time()
+for i in range(0,nRequests):
+    rpc.invokeAsync(request, echo, error, 5.0)
+while nResponses[0] + nErrors[0] < nRequests:
+    time.sleep(0.01)
+runTime = time.time() - startTime
+print 'Received %d responses and %d errors in %.3f seconds (%.1f requests/second)' % (nResponses[0], nErrors[0], runTime, nRequests/runTime)
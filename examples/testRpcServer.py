@@ -3,6 +3,13 @@
 import pvaccess
 import random
 
+# NumPy columns are transferred in bulk; without NumPy, columns are
+# built as lists
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 srv = pvaccess.RpcServer()
 def createNtTable(x):
     nRows = x.getInt('nRows')
@@ -12,9 +19,10 @@ def createNtTable(x):
     labels = []
     for j in range (0, nColumns):
         labels.append('Column%s' % j)
-        column = []
-        for i in range (0, nRows):
-            column.append(random.uniform(0,1))
+        if numpy is not None:
+            column = numpy.random.uniform(0, 1, nRows)
+        else:
+            column = [random.uniform(0,1) for i in range (0, nRows)]
         ntTable.setColumn(j, column)
     ntTable.setLabels(labels)
     ntTable.setDescriptor('Automatically created by RPC Server')
@@ -0,0 +1,40 @@
+#!/usr/bin/env python
+
+#
+# Serves createNtTable requests in the background listener thread,
+# prints service metrics periodically, and shuts down gracefully.
+#
+# Usage: testRpcServerMetrics.py [runTime]
+#
+
+import sys
+import time
+import random
+
+import pvaccess
+
+runTime = 60
+if len(sys.argv) > 1:
+    runTime = int(sys.argv[1])
+
+def createNtTable(x):
+    nRows = x.getInt('nRows')
+    nColumns = x.getInt('nColumns')
+    ntTable = pvaccess.NtTable(nColumns, pvaccess.DOUBLE)
+    for j in range (0, nColumns):
+        ntTable.setColumn(j, [random.uniform(0,1) for i in range(0, nRows)])
+    return ntTable
+
+srv = pvaccess.RpcServer()
+srv.registerService('createNtTable', createNtTable)
+srv.startListener()
+startTime = time.time()
+while time.time() - startTime < runTime:
+    time.sleep(5)
+    metrics = srv.getServiceMetrics('createNtTable')
+    print 'Requests: %d, errors: %d, rate: %.1f requests/s, average latency: %.6f s' % (metrics['requests'], metrics['errors'], metrics['requestRate'], metrics['averageLatency'])
+    print 'Latency histogram: %s' % zip(metrics['latencyHistogramBounds'] + [float('inf')], metrics['latencyHistogram'])
+
+# Requests accepted so far are completed before server is destroyed
+srv.stopListener(10.0)
+print 'Final metrics: %s' % srv.getMetrics()
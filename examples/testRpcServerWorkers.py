@@ -0,0 +1,38 @@
+#!/usr/bin/env python
+
+#
+# RPC server whose requests are processed by a pool of worker threads.
+# Slow service is limited to two concurrent requests, so that it cannot
+# hold up requests for the fast service.
+#
+# Usage: testRpcServerWorkers.py [workerPoolSize]
+#
+# Test with, e.g., several 'eget -s slow -a x=1' clients running in
+# parallel with 'eget -s fast -a x=1'.
+#
+
+import sys
+import time
+
+import pvaccess
+from pvaccess import PvObject
+from pvaccess import STRING
+
+workerPoolSize = 8
+if len(sys.argv) > 1:
+    workerPoolSize = int(sys.argv[1])
+
+def slow(x):
+    time.sleep(5)
+    return PvObject({'result' : STRING}, {'result' : 'slow done'})
+
+def fast(x):
+    return PvObject({'result' : STRING}, {'result' : 'fast done'})
+
+srv = pvaccess.RpcServer()
+srv.setWorkerPoolSize(workerPoolSize)
+srv.setMaxPendingRequests(100)
+srv.registerService('slow', slow, 2)
+srv.registerService('fast', fast)
+print 'Serving requests with %d workers, slow service limited to %d concurrent requests' % (srv.getWorkerPoolSize(), srv.getServiceConcurrencyLimit('slow'))
+srv.listen()
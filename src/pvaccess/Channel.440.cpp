@@ -7,6 +7,7 @@
 
 #include "Channel.h"
 #include "epicsThread.h"
+#include "epicsTime.h"
 #include "ChannelGetRequesterImpl.h"
 #include "ChannelPutRequesterImpl.h"
 #include "GetFieldRequesterImpl.h"
@@ -18,18 +19,24 @@
 #include "InvalidArgument.h"
 #include "ObjectNotFound.h"
 #include "PyGilManager.h"
+#include "PyGilRelease.h"
+#include "ChannelMonitorDispatcher.h"
 #include "PvUtility.h"
 #include "PyUtility.h"
+#include "PyPvDataUtility.h"
+#include "PvaConstants.h"
 
 const char* Channel::DefaultRequestDescriptor("field(value)");
 const double Channel::DefaultTimeout(3.0);
-const double Channel::ShutdownWaitTime(0.1);
+const int Channel::DefaultMonitorBatchSize(1);
 
 PvaPyLogger Channel::logger("Channel");
 PvaClient Channel::pvaClient;
 CaClient Channel::caClient;
 
-Channel::Channel(const std::string& channelName, PvProvider::ProviderType providerType) :
+// Connection is initiated when pvAccess channel is created, and each
+// request waits for it to complete, so channel is never waited for here
+Channel::Channel(const std::string& channelName, PvProvider::ProviderType providerType, bool waitForConnection) :
     requester(new RequesterImpl(channelName)),
     requesterImpl(new ChannelRequesterImpl(true)),
     channelGetRequester(channelName),
@@ -39,11 +46,18 @@ Channel::Channel(const std::string& channelName, PvProvider::ProviderType provid
     monitor(),
     monitorThreadDone(true),
     pvObjectMonitorQueue(),
+    monitorQueueLockFree(false),
+    monitorCopyOnChange(false),
     subscriberMap(),
+    batchSubscriberMap(),
+    monitorBatchSize(DefaultMonitorBatchSize),
+    monitorBatchTime(0),
+    monitorBatchPvObjects(),
+    monitorBatchStartTime(),
     subscriberMutex(),
     monitorElementProcessingMutex(),
     monitorThreadMutex(),
-    monitorThreadExitEvent(),
+    processingThreadExitEvent(),
     timeout(DefaultTimeout)
 {
 }
@@ -54,26 +68,68 @@ Channel::Channel(const Channel& c) :
     monitorRequester(c.monitorRequester),
     monitorThreadDone(true),
     pvObjectMonitorQueue(),
+    monitorQueueLockFree(false),
+    monitorCopyOnChange(false),
     subscriberMap(),
+    batchSubscriberMap(),
+    monitorBatchSize(DefaultMonitorBatchSize),
+    monitorBatchTime(0),
+    monitorBatchPvObjects(),
+    monitorBatchStartTime(),
     subscriberMutex(),
-    monitorThreadExitEvent(),
+    processingThreadExitEvent(),
     timeout(DefaultTimeout)
 {
 }
 
 Channel::~Channel()
 {
-    stopMonitor();
+    // Monitor workers are done with channel once monitor is stopped
+    try {
+        stopMonitor();
+    }
+    catch (const std::exception& ex) {
+        logger.error("Error stopping monitor for channel %s: %s", getName().c_str(), ex.what());
+    }
     channel->destroy();
-    epicsThreadSleep(ShutdownWaitTime);
 }
  
+void Channel::issueConnect()
+{
+}
+
+void Channel::waitConnect(double timeout)
+{
+    std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
+    if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+        PyGilRelease pyGilRelease;
+        if (!channelRequesterImpl->waitUntilConnected(timeout)) {
+            throw ChannelTimeout("Channel %s connection timed out", channel->getChannelName().c_str());
+        }
+    }
+}
+
+bool Channel::isConnected()
+{
+    return channel->getConnectionState() == epics::pvAccess::Channel::CONNECTED;
+}
+
 PvObject* Channel::get()
 {
     return get(DefaultRequestDescriptor);
 }
 
 PvObject* Channel::get(const std::string& requestDescriptor) 
+{
+    epics::pvData::PVStructurePtr pvStructurePtr;
+    {
+        PyGilRelease pyGilRelease;
+        pvStructurePtr = getPvStructure(requestDescriptor);
+    }
+    return new PvObject(pvStructurePtr);
+}
+
+epics::pvData::PVStructurePtr Channel::getPvStructure(const std::string& requestDescriptor) 
 {
     epics::pvData::PVStructure::shared_pointer pvRequest = epics::pvData::CreateRequest::create()->createRequest(requestDescriptor);
 
@@ -106,10 +162,10 @@ PvObject* Channel::get(const std::string& requestDescriptor)
 
 	std::tr1::shared_ptr<ChannelGetRequesterImpl> getRequesterImpl(new ChannelGetRequesterImpl(channel->getChannelName()));
 	epics::pvAccess::ChannelGet::shared_pointer channelGet = channel->createChannelGet(getRequesterImpl, pvRequest);
-	if (getRequesterImpl->waitUntilGet(timeout)) {
-	    return new PvObject(getRequesterImpl->getPVStructure());
+	if (!getRequesterImpl->waitUntilGet(timeout)) {
+        throw ChannelTimeout("Channel %s get request timed out", channel->getChannelName().c_str());
     }
-    throw ChannelTimeout("Channel %s get request timed out", channel->getChannelName().c_str());
+    return getRequesterImpl->getPVStructure();
 }
 
 void Channel::put(const PvObject& pvObject)
@@ -119,6 +175,7 @@ void Channel::put(const PvObject& pvObject)
 
 void Channel::put(const PvObject& pvObject, const std::string& requestDescriptor) 
 {
+    PyGilRelease pyGilRelease;
     epics::pvData::PVStructure::shared_pointer pvRequest = epics::pvData::CreateRequest::create()->createRequest(requestDescriptor);
     std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
 
@@ -149,6 +206,7 @@ void Channel::put(const std::vector<std::string>& values)
 
 void Channel::put(const std::vector<std::string>& values, const std::string& requestDescriptor) 
 {
+    PyGilRelease pyGilRelease;
     epics::pvData::PVStructure::shared_pointer pvRequest = epics::pvData::CreateRequest::create()->createRequest(requestDescriptor);
     std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
 
@@ -187,12 +245,9 @@ void Channel::put(const std::string& value, const std::string& requestDescriptor
 
 void Channel::put(const boost::python::list& pyList, const std::string& requestDescriptor) 
 {
-    int listSize = boost::python::len(pyList);
-    std::vector<std::string> values(listSize);
-    for (int i = 0; i < listSize; i++) {
-        values[i] = PyUtility::extractStringFromPyObject(pyList[i]);
-    }
-    put(values, requestDescriptor);
+    // List elements are converted directly to the channel array type
+    const boost::python::object& pyObject = pyList;
+    put(pyObject, requestDescriptor);
 }
 
 void Channel::put(const boost::python::list& pyList)
@@ -200,9 +255,82 @@ void Channel::put(const boost::python::list& pyList)
     put(pyList, DefaultRequestDescriptor);
 }
 
+void Channel::put(const boost::python::object& pyObject, const std::string& requestDescriptor) 
+{
+    epics::pvData::PVStructure::shared_pointer pvRequest = epics::pvData::CreateRequest::create()->createRequest(requestDescriptor);
+    std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
+    std::tr1::shared_ptr<ChannelPutRequesterImpl> putRequesterImpl(new ChannelPutRequesterImpl(channel->getChannelName()));
+    epics::pvAccess::ChannelPut::shared_pointer channelPut;
+    {
+        PyGilRelease pyGilRelease;
+        if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+            if (!channelRequesterImpl->waitUntilConnected(timeout)) {
+                throw ChannelTimeout("Channel %s timed out", channel->getChannelName().c_str());
+            }
+        }
+        channelPut = channel->createChannelPut(putRequesterImpl, pvRequest);
+        if (!putRequesterImpl->waitUntilDone(timeout)) {
+            throw ChannelTimeout("Channel %s put request timed out", channel->getChannelName().c_str());
+        }
+    }
+
+    // Python object conversion requires GIL
+    epics::pvData::PVStructurePtr pvStructurePtr = putRequesterImpl->getStructure();
+    PyPvDataUtility::pyObjectToScalarArrayField(pyObject, PvaConstants::ValueFieldKey, pvStructurePtr);
+
+    PyGilRelease pyGilRelease;
+    putRequesterImpl->resetEvent();
+    channelPut->put(pvStructurePtr, putRequesterImpl->getBitSet());
+    if (!putRequesterImpl->waitUntilDone(timeout)) {
+        throw ChannelTimeout("Channel %s put request timed out", channel->getChannelName().c_str());
+    }
+}
+
+void Channel::put(const boost::python::object& pyObject)
+{
+    put(pyObject, DefaultRequestDescriptor);
+}
+
+template<typename T>
+void Channel::putScalar(T value, const std::string& requestDescriptor)
+{
+    PyGilRelease pyGilRelease;
+    epics::pvData::PVStructure::shared_pointer pvRequest = epics::pvData::CreateRequest::create()->createRequest(requestDescriptor);
+    std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
+
+    if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+        if (!channelRequesterImpl->waitUntilConnected(timeout)) {
+            throw ChannelTimeout("Channel %s timed out", channel->getChannelName().c_str());
+        }
+    }
+
+    std::tr1::shared_ptr<ChannelPutRequesterImpl> putRequesterImpl(new ChannelPutRequesterImpl(channel->getChannelName()));
+    epics::pvAccess::ChannelPut::shared_pointer channelPut = channel->createChannelPut(putRequesterImpl, pvRequest);
+    if (putRequesterImpl->waitUntilDone(timeout)) {
+        epics::pvData::PVStructurePtr pvStructurePtr = putRequesterImpl->getStructure();
+        epics::pvData::PVScalarPtr pvScalarPtr = pvStructurePtr->getSubField<epics::pvData::PVScalar>(PvaConstants::ValueFieldKey);
+        if (!pvScalarPtr) {
+            throw InvalidRequest("Channel %s does not have scalar value field", channel->getChannelName().c_str());
+        }
+        try {
+            pvScalarPtr->putFrom<T>(value);
+        }
+        catch (std::runtime_error e) {
+            throw InvalidArgument(e.what());
+        }
+
+        putRequesterImpl->resetEvent();
+        channelPut->put(pvStructurePtr, putRequesterImpl->getBitSet());
+        if (putRequesterImpl->waitUntilDone(timeout)) {
+            return;
+        }
+    }
+    throw ChannelTimeout("Channel %s put request timed out", channel->getChannelName().c_str());
+}
+
 void Channel::put(bool value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<bool>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::boolean>(value), requestDescriptor);
 }
 
 void Channel::put(bool value)
@@ -212,7 +340,7 @@ void Channel::put(bool value)
 
 void Channel::put(char value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<int>(static_cast<int>(value)), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int8>(value), requestDescriptor);
 }
 
 void Channel::put(char value)
@@ -222,7 +350,7 @@ void Channel::put(char value)
 
 void Channel::put(unsigned char value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<int>(static_cast<int>(value)), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint8>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned char value)
@@ -232,7 +360,7 @@ void Channel::put(unsigned char value)
 
 void Channel::put(short value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<short>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int16>(value), requestDescriptor);
 }
 
 void Channel::put(short value)
@@ -242,7 +370,7 @@ void Channel::put(short value)
 
 void Channel::put(unsigned short value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<unsigned short>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint16>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned short value)
@@ -252,7 +380,7 @@ void Channel::put(unsigned short value)
 
 void Channel::put(int value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<int>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int32>(value), requestDescriptor);
 }
 
 void Channel::put(int value)
@@ -262,7 +390,7 @@ void Channel::put(int value)
 
 void Channel::put(unsigned int value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<unsigned int>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint32>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned int value)
@@ -272,7 +400,7 @@ void Channel::put(unsigned int value)
 
 void Channel::put(long long value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<long long>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int64>(value), requestDescriptor);
 }
 
 void Channel::put(long long value)
@@ -282,7 +410,7 @@ void Channel::put(long long value)
 
 void Channel::put(unsigned long long value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<unsigned long long>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint64>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned long long value)
@@ -292,7 +420,7 @@ void Channel::put(unsigned long long value)
 
 void Channel::put(float value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<float>(value), requestDescriptor);
+    putScalar(static_cast<float>(value), requestDescriptor);
 }
 
 void Channel::put(float value)
@@ -302,7 +430,7 @@ void Channel::put(float value)
 
 void Channel::put(double value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<double>(value), requestDescriptor);
+    putScalar(static_cast<double>(value), requestDescriptor);
 }
 
 void Channel::put(double value)
@@ -310,6 +438,312 @@ void Channel::put(double value)
     put(value, DefaultRequestDescriptor);
 }
 
+//
+// Asynchronous requests. Request is created right away if channel is
+// connected; otherwise, the dispatcher creates it once channel state
+// change reports connection. Get and put requesters issue get/put as soon
+// as request is created, so completion requires no further action, and
+// they wake up the dispatcher when request completes or fails.
+//
+class ChannelAsyncGetRequesterImpl : public ChannelGetRequesterImpl
+{
+public:
+    ChannelAsyncGetRequesterImpl(const std::string& channelName);
+    bool isCompleted();
+
+protected:
+    virtual void signalCompletion();
+
+private:
+    epics::pvData::Mutex mutex;
+    bool completed;
+};
+
+ChannelAsyncGetRequesterImpl::ChannelAsyncGetRequesterImpl(const std::string& channelName) :
+    ChannelGetRequesterImpl(channelName),
+    mutex(),
+    completed(false)
+{
+}
+
+bool ChannelAsyncGetRequesterImpl::isCompleted()
+{
+    epics::pvData::Lock lock(mutex);
+    return completed;
+}
+
+void ChannelAsyncGetRequesterImpl::signalCompletion()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        completed = true;
+    }
+    ChannelGetRequesterImpl::signalCompletion();
+    ChannelAsyncRequest::notifyDispatcher();
+}
+
+class ChannelAsyncPutRequesterImpl : public ChannelPutRequesterImpl
+{
+public:
+    ChannelAsyncPutRequesterImpl(const std::string& channelName);
+    bool isCompleted();
+
+protected:
+    virtual void signalCompletion();
+
+private:
+    epics::pvData::Mutex mutex;
+    bool completed;
+};
+
+ChannelAsyncPutRequesterImpl::ChannelAsyncPutRequesterImpl(const std::string& channelName) :
+    ChannelPutRequesterImpl(channelName),
+    mutex(),
+    completed(false)
+{
+}
+
+bool ChannelAsyncPutRequesterImpl::isCompleted()
+{
+    epics::pvData::Lock lock(mutex);
+    return completed;
+}
+
+void ChannelAsyncPutRequesterImpl::signalCompletion()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        completed = true;
+    }
+    ChannelPutRequesterImpl::signalCompletion();
+    ChannelAsyncRequest::notifyDispatcher();
+}
+
+class ChannelAsyncConnectRequest : public ChannelAsyncRequest
+{
+public:
+    ChannelAsyncConnectRequest(const epics::pvAccess::Channel::shared_pointer& channel, double timeout);
+    virtual bool isDone();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    epics::pvAccess::Channel::shared_pointer channel;
+};
+
+ChannelAsyncConnectRequest::ChannelAsyncConnectRequest(const epics::pvAccess::Channel::shared_pointer& channel_, double timeout) :
+    ChannelAsyncRequest(channel_->getChannelName(), timeout),
+    channel(channel_)
+{
+}
+
+bool ChannelAsyncConnectRequest::isDone()
+{
+    return (channel->getConnectionState() == epics::pvAccess::Channel::CONNECTED);
+}
+
+epics::pvData::PVStructurePtr ChannelAsyncConnectRequest::waitForCompletion()
+{
+    std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
+    if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+        channelRequesterImpl->waitUntilConnected(getRemainingTimeout());
+
+        // Connection event may have been consumed by another request
+        if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+            throw ChannelTimeout("Channel %s connection timed out", getChannelName().c_str());
+        }
+    }
+    return epics::pvData::PVStructurePtr();
+}
+
+class ChannelAsyncGetRequest : public ChannelAsyncRequest
+{
+public:
+    ChannelAsyncGetRequest(const epics::pvAccess::Channel::shared_pointer& channel, const std::string& requestDescriptor, double timeout);
+    virtual void tryIssue();
+    virtual void issue();
+    virtual bool isDone();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    void createChannelGet();
+
+    epics::pvAccess::Channel::shared_pointer channel;
+    epics::pvData::PVStructure::shared_pointer pvRequest;
+    std::tr1::shared_ptr<ChannelAsyncGetRequesterImpl> getRequesterImpl;
+    epics::pvAccess::ChannelGet::shared_pointer channelGet;
+};
+
+ChannelAsyncGetRequest::ChannelAsyncGetRequest(const epics::pvAccess::Channel::shared_pointer& channel_, const std::string& requestDescriptor, double timeout) :
+    ChannelAsyncRequest(channel_->getChannelName(), timeout),
+    channel(channel_),
+    pvRequest(epics::pvData::CreateRequest::create()->createRequest(requestDescriptor)),
+    getRequesterImpl(new ChannelAsyncGetRequesterImpl(channel_->getChannelName())),
+    channelGet()
+{
+    if (channel->getConnectionState() == epics::pvAccess::Channel::CONNECTED) {
+        createChannelGet();
+    }
+}
+
+void ChannelAsyncGetRequest::createChannelGet()
+{
+    channelGet = channel->createChannelGet(getRequesterImpl, pvRequest);
+}
+
+void ChannelAsyncGetRequest::tryIssue()
+{
+    if (!channelGet && channel->getConnectionState() == epics::pvAccess::Channel::CONNECTED) {
+        createChannelGet();
+    }
+}
+
+void ChannelAsyncGetRequest::issue()
+{
+    if (channelGet) {
+        return;
+    }
+    std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
+    if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+        channelRequesterImpl->waitUntilConnected(getRemainingTimeout());
+
+        // Connection event may have been consumed by another request
+        if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+            throw ChannelTimeout("Channel %s timed out", getChannelName().c_str());
+        }
+    }
+    createChannelGet();
+}
+
+bool ChannelAsyncGetRequest::isDone()
+{
+    return getRequesterImpl->isCompleted();
+}
+
+epics::pvData::PVStructurePtr ChannelAsyncGetRequest::waitForCompletion()
+{
+    if (!getRequesterImpl->waitUntilGet(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s get request timed out", getChannelName().c_str());
+    }
+    return getRequesterImpl->getPVStructure();
+}
+
+class ChannelAsyncPutRequest : public ChannelAsyncRequest
+{
+public:
+    ChannelAsyncPutRequest(const epics::pvAccess::Channel::shared_pointer& channel, const std::string& requestDescriptor, const epics::pvData::PVStructurePtr& pvStructurePtr, double timeout);
+    virtual void tryIssue();
+    virtual void issue();
+    virtual bool isDone();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    void createChannelPut();
+
+    epics::pvAccess::Channel::shared_pointer channel;
+    epics::pvData::PVStructure::shared_pointer pvRequest;
+    std::tr1::shared_ptr<ChannelAsyncPutRequesterImpl> putRequesterImpl;
+    epics::pvAccess::ChannelPut::shared_pointer channelPut;
+};
+
+ChannelAsyncPutRequest::ChannelAsyncPutRequest(const epics::pvAccess::Channel::shared_pointer& channel_, const std::string& requestDescriptor, const epics::pvData::PVStructurePtr& pvStructurePtr, double timeout) :
+    ChannelAsyncRequest(channel_->getChannelName(), timeout),
+    channel(channel_),
+    pvRequest(epics::pvData::CreateRequest::create()->createRequest(requestDescriptor)),
+    putRequesterImpl(new ChannelAsyncPutRequesterImpl(channel_->getChannelName())),
+    channelPut()
+{
+    putRequesterImpl->setPutData(pvStructurePtr);
+    if (channel->getConnectionState() == epics::pvAccess::Channel::CONNECTED) {
+        createChannelPut();
+    }
+}
+
+void ChannelAsyncPutRequest::createChannelPut()
+{
+    channelPut = channel->createChannelPut(putRequesterImpl, pvRequest);
+}
+
+void ChannelAsyncPutRequest::tryIssue()
+{
+    if (!channelPut && channel->getConnectionState() == epics::pvAccess::Channel::CONNECTED) {
+        createChannelPut();
+    }
+}
+
+void ChannelAsyncPutRequest::issue()
+{
+    if (channelPut) {
+        return;
+    }
+    std::tr1::shared_ptr<ChannelRequesterImpl> channelRequesterImpl = std::tr1::dynamic_pointer_cast<ChannelRequesterImpl>(channel->getChannelRequester());
+    if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+        channelRequesterImpl->waitUntilConnected(getRemainingTimeout());
+
+        // Connection event may have been consumed by another request
+        if (channel->getConnectionState() != epics::pvAccess::Channel::CONNECTED) {
+            throw ChannelTimeout("Channel %s timed out", getChannelName().c_str());
+        }
+    }
+    createChannelPut();
+}
+
+bool ChannelAsyncPutRequest::isDone()
+{
+    return putRequesterImpl->isCompleted();
+}
+
+epics::pvData::PVStructurePtr ChannelAsyncPutRequest::waitForCompletion()
+{
+    if (!putRequesterImpl->waitUntilDone(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s put request timed out", getChannelName().c_str());
+    }
+    return epics::pvData::PVStructurePtr();
+}
+
+ChannelAsyncRequestPtr Channel::createAsyncGetRequest(const std::string& requestDescriptor)
+{
+    return ChannelAsyncRequestPtr(new ChannelAsyncGetRequest(channel, requestDescriptor, timeout));
+}
+
+ChannelAsyncRequestPtr Channel::createAsyncPutRequest(const PvObject& pvObject, const std::string& requestDescriptor)
+{
+    // Put data must be copied, as object may be modified
+    // before request is issued
+    epics::pvData::PVStructurePtr pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(pvObject.getPvStructurePtr());
+    return ChannelAsyncRequestPtr(new ChannelAsyncPutRequest(channel, requestDescriptor, pvStructurePtr, timeout));
+}
+
+void Channel::asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    asyncGet(pyCallback, pyErrorCallback, DefaultRequestDescriptor);
+}
+
+void Channel::asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor)
+{
+    ChannelAsyncRequestPtr request = createAsyncGetRequest(requestDescriptor);
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
+
+void Channel::asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    asyncPut(pvObject, pyCallback, pyErrorCallback, DefaultRequestDescriptor);
+}
+
+void Channel::asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor)
+{
+    ChannelAsyncRequestPtr request = createAsyncPutRequest(pvObject, requestDescriptor);
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
+
+void Channel::asyncConnect(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    ChannelAsyncRequestPtr request(new ChannelAsyncConnectRequest(channel, timeout));
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
+
 ChannelMonitorRequesterImpl* Channel::getMonitorRequester()
 {
     return static_cast<ChannelMonitorRequesterImpl*>(monitorRequester.get());
@@ -317,56 +751,89 @@ ChannelMonitorRequesterImpl* Channel::getMonitorRequester()
 
 void Channel::subscribe(const std::string& subscriberName, const boost::python::object& pySubscriber)
 {
-    //epics::pvData::Lock lock(subscriberMutex);
+    // Subscriber maps are accessed with GIL held
+    batchSubscriberMap.erase(subscriberName);
     subscriberMap[subscriberName] = pySubscriber;
 }
 
+void Channel::subscribeBatch(const std::string& subscriberName, const boost::python::object& pySubscriber)
+{
+    subscriberMap.erase(subscriberName);
+    batchSubscriberMap[subscriberName] = pySubscriber;
+}
+
 void Channel::unsubscribe(const std::string& subscriberName)
 {
-    //epics::pvData::Lock lock(subscriberMutex);
-    boost::python::object pySubscriber = subscriberMap[subscriberName];
-    std::map<std::string,boost::python::object>::const_iterator iterator = subscriberMap.find(subscriberName);
-    if (iterator == subscriberMap.end()) {
+    if (subscriberMap.erase(subscriberName) == 0 && batchSubscriberMap.erase(subscriberName) == 0) {
         throw ObjectNotFound("Subscriber " + subscriberName + " is not registered.");
     }
-    subscriberMap.erase(subscriberName);
     logger.trace("Unsubscribed monitor " + subscriberName);
 }
 
-void Channel::callSubscribers(PvObject& pvObject)
+void Channel::callSubscribers(std::vector<PvObject>& pvObjects)
 {
-    //epics::pvData::Lock lock(subscriberMutex);
+    // Acquire GIL once for all PV objects. This is required because 
+    // callSubscribers() is called in a monitoring thread. Before monitoring
+    // thread is created, one must call PyEval_InitThreads() in the main 
+    // thread to initialize things properly. If this is not done, code will
+    // most likely crash while invoking python from c++, or while
+    // attempting to release GIL.
+    logger.trace("Acquiring python GIL for %d PV objects", int(pvObjects.size()));
+    PyGILState_STATE gilState = PyGilManager::gilStateEnsure();
 
+    // Subscribers may unsubscribe while being called, so maps are copied
+    std::map<std::string,boost::python::object> subscribers(subscriberMap);
+    std::map<std::string,boost::python::object> batchSubscribers(batchSubscriberMap);
     std::map<std::string,boost::python::object>::iterator iter;
-    for (iter = subscriberMap.begin(); iter != subscriberMap.end(); iter++) {
+    for (iter = subscribers.begin(); iter != subscribers.end(); iter++) {
         std::string subscriberName = iter->first;
         boost::python::object pySubscriber = iter->second;
+        logger.debug("Invoking subscriber: " + subscriberName);
+        std::vector<PvObject>::iterator pvObjectIter;
+        for (pvObjectIter = pvObjects.begin(); pvObjectIter != pvObjects.end(); pvObjectIter++) {
+            try {
+                // Call python code
+                pySubscriber(*pvObjectIter);
+            }
+            catch(const boost::python::error_already_set&) {
+                logger.error("Channel subscriber " + subscriberName + " error");
+                PyErr_Print();
+            }
+        }
+    }
 
-        // Acquire GIL. This is required because callSubscribers()
-        // is called in a monitoring thread. Before monitoring thread
-        // is created, one must call PyEval_InitThreads() in the main thread
-        // to initialize things properly. If this is not done, code will
-        // most likely crash while invoking python from c++, or while
-        // attempting to release GIL.
-        // PyGILState_STATE gilState = PyGILState_Ensure();
-        logger.trace("Acquiring python GIL for subscriber " + subscriberName);
-        PyGilManager::gilStateEnsure();
-
+    if (!batchSubscribers.empty()) {
+        // Python list must be created and released with GIL held
+        boost::python::list pyList;
         try {
-            logger.debug("Invoking subscriber: " + subscriberName);
-
-            // Call python code
-            pySubscriber(pvObject);
+            std::vector<PvObject>::iterator pvObjectIter;
+            for (pvObjectIter = pvObjects.begin(); pvObjectIter != pvObjects.end(); pvObjectIter++) {
+                pyList.append(*pvObjectIter);
+            }
         }
         catch(const boost::python::error_already_set&) {
-            logger.error("Channel subscriber " + subscriberName + " error");
+            logger.error("Cannot create PV object list for batch subscribers");
+            PyErr_Print();
+            batchSubscribers.clear();
+        }
+        for (iter = batchSubscribers.begin(); iter != batchSubscribers.end(); iter++) {
+            std::string subscriberName = iter->first;
+            boost::python::object pySubscriber = iter->second;
+            logger.debug("Invoking batch subscriber: " + subscriberName);
+            try {
+                pySubscriber(pyList);
+            }
+            catch(const boost::python::error_already_set&) {
+                logger.error("Channel batch subscriber " + subscriberName + " error");
+                PyErr_Print();
+            }
         }
-
-        // Release GIL. 
-        // PyGILState_Release(gilState);
-        logger.trace("Releasing python GIL");
-        PyGilManager::gilStateRelease();
     }
+
+    subscribers.clear();
+    batchSubscribers.clear();
+    logger.trace("Releasing python GIL");
+    PyGilManager::gilStateRelease(gilState);
     logger.trace("Done calling subscribers");
 }
 
@@ -381,8 +848,13 @@ void Channel::startMonitor(const std::string& requestDescriptor)
     if (monitorThreadDone) {
         monitorThreadDone = false;
         int maxQueueLength = getMonitorRequester()->getPvObjectQueueMaxLength(); 
+        QueueOverflowPolicy::PolicyType overflowPolicy = getMonitorRequester()->getPvObjectQueueOverflowPolicy();
         monitorRequester = epics::pvData::MonitorRequester::shared_pointer(new ChannelMonitorRequesterImpl(getName()));
         getMonitorRequester()->setPvObjectQueueMaxLength(maxQueueLength); 
+        getMonitorRequester()->setPvObjectQueueOverflowPolicy(overflowPolicy);
+        getMonitorRequester()->setPvObjectQueueLockFree(monitorQueueLockFree);
+        getMonitorRequester()->setCopyOnChange(monitorCopyOnChange);
+        getMonitorRequester()->setChannel(this);
 
         // One must call PyEval_InitThreads() in the main thread
         // to initialize thread state, which is needed for proper functioning
@@ -391,7 +863,6 @@ void Channel::startMonitor(const std::string& requestDescriptor)
         PyGilManager::evalInitThreads();
         epics::pvData::PVStructure::shared_pointer pvRequest = epics::pvData::CreateRequest::create()->createRequest(requestDescriptor);
         monitor = channel->createMonitor(monitorRequester, pvRequest);
-        epicsThreadCreate("ChannelMonitorThread", epicsThreadPriorityLow, epicsThreadGetStackSize(epicsThreadStackSmall), (EPICSTHREADFUNC)monitorThread, this);
     }
 }
 
@@ -404,13 +875,75 @@ void Channel::stopMonitor()
     }
     monitorThreadDone = true;
     logger.debug("Stopping monitor");
-    monitor->stop();
-    logger.debug("Monitor stopped, waiting for thread exit");
+
     ChannelMonitorRequesterImpl* monitorRequester = getMonitorRequester();
+    monitor->stop();
+
+    // No data is scheduled after requester is detached, and channel cannot
+    // be destroyed while one of the monitor workers is processing it;
+    // worker may need GIL to complete subscriber calls
+    monitorRequester->setChannel(NULL);
     monitorRequester->cancelGetQueuedPvObject();
-    monitorThreadExitEvent.wait(getTimeout());
+    processingThreadExitEvent.tryWait();
+    if (ChannelMonitorDispatcher::cancel(this)) {
+        // Worker still uses this channel, so it must be waited for
+        // without timeout; channel may be destroyed after this returns
+        logger.debug("Monitor stopped, waiting for processing to complete");
+        PyGilRelease pyGilRelease;
+        processingThreadExitEvent.wait();
+    }
     logger.debug("Clearing requester queue");
     monitorRequester->clearPvObjectQueue();
+    monitorBatchPvObjects.clear();
+}
+
+boost::python::dict Channel::getMonitorStatistics()
+{
+    return getMonitorRequester()->getPvObjectQueueStatistics().toPyDict();
+}
+
+void Channel::setMonitorQueueLockFree(bool lockFree)
+{
+    epics::pvData::Lock lock(monitorThreadMutex);
+    if (!monitorThreadDone) {
+        throw InvalidRequest("Monitor queue type cannot be changed while monitor is running");
+    }
+    monitorQueueLockFree = lockFree;
+}
+
+void Channel::setMonitorCopyOnChange(bool copyOnChange)
+{
+    epics::pvData::Lock lock(monitorThreadMutex);
+    if (!monitorThreadDone) {
+        throw InvalidRequest("Monitor copy mode cannot be changed while monitor is running");
+    }
+    monitorCopyOnChange = copyOnChange;
+}
+
+void Channel::setMonitorBatchSize(int batchSize)
+{
+    if (batchSize < 1) {
+        throw InvalidArgument("Monitor batch size must be positive.");
+    }
+    monitorBatchSize = batchSize;
+}
+
+void Channel::setMonitorBatchTime(double batchTime)
+{
+    if (batchTime < 0) {
+        throw InvalidArgument("Monitor batch time cannot be negative.");
+    }
+    monitorBatchTime = batchTime;
+}
+
+void Channel::setMonitorWorkerPoolSize(int workerPoolSize)
+{
+    ChannelMonitorDispatcher::setWorkerPoolSize(workerPoolSize);
+}
+
+int Channel::getMonitorWorkerPoolSize()
+{
+    return ChannelMonitorDispatcher::getWorkerPoolSize();
 }
 
 bool Channel::isMonitorThreadDone() const
@@ -418,38 +951,54 @@ bool Channel::isMonitorThreadDone() const
     return monitorThreadDone;
 }
 
-bool Channel::processMonitorElement() 
+bool Channel::processMonitorElement(double& retryDelay)
 {
-    //epics::pvData::Lock lock(monitorElementProcessingMutex);
+    retryDelay = 0;
     if (monitorThreadDone) {
-        return true;
+        return false;
     }
 
-    // Handle possible exceptions while retrieving data from empty queue.
-    try {
-        PvObject pvObject = getMonitorRequester()->getQueuedPvObject(getTimeout());
-        callSubscribers(pvObject);
+    // Monitor workers never wait for data that is not queued yet; batch
+    // that is neither full nor past its time budget is kept here, and
+    // dispatcher processes channel again when more data arrives or when
+    // time budget expires
+    int maxBatchSize = monitorBatchSize;
+    int nPreviousObjects = monitorBatchPvObjects.size();
+    if (nPreviousObjects < maxBatchSize) {
+        dequeueMonitorData(monitorBatchPvObjects, maxBatchSize-nPreviousObjects, 0);
+    }
+    int nObjects = monitorBatchPvObjects.size();
+    if (nObjects == 0) {
+        return false;
     }
-    catch (const ChannelTimeout& ex) {
-        // Ignore, no changes received.
+    if (monitorBatchTime > 0 && nObjects < maxBatchSize) {
+        epicsTime currentTime = epicsTime::getCurrent();
+        if (nPreviousObjects == 0) {
+            monitorBatchStartTime = currentTime;
+        }
+        double remainingTime = monitorBatchTime - (currentTime - monitorBatchStartTime);
+        if (remainingTime > 0) {
+            retryDelay = remainingTime;
+            return false;
+        }
+    }
+
+    std::vector<PvObject> pvObjects;
+    pvObjects.swap(monitorBatchPvObjects);
+    try {
+        callSubscribers(pvObjects);
     }
     catch (const std::exception& ex) {
         // Not good.
-        logger.error("Exception caught in monitor thread: %s", ex.what());
+        logger.error("Exception caught in monitor worker: %s", ex.what());
     }
-    return false;
+
+    // Full batch may have left more data in the queue
+    return (nObjects >= maxBatchSize);
 }
 
-void Channel::monitorThread(Channel* channel)
+int Channel::dequeueMonitorData(std::vector<PvObject>& pvObjects, int maxObjects, double timeout)
 {
-    logger.debug("Started monitor thread %s", epicsThreadGetNameSelf());
-    while (true) {
-        if (channel->processMonitorElement()) {
-            break;
-        }
-    }
-    logger.debug("Exiting monitor thread %s", epicsThreadGetNameSelf());
-    channel->notifyMonitorThreadExit();
+    return getMonitorRequester()->getQueuedPvObjects(pvObjects, maxObjects, timeout);
 }
 
-
@@ -8,14 +8,18 @@
 #include <vector>
 
 #include "boost/python/list.hpp"
+#include "boost/python/dict.hpp"
 
+#include "ChannelAsyncRequest.h"
 #include "ChannelGetRequesterImpl.h"
 #include "ChannelMonitorRequesterImpl.h"
 #include "ChannelRequesterImpl.h"
 #include "SynchronizedQueue.h"
+#include "QueueOverflowPolicy.h"
 #include "PvaClient.h"
 #include "CaClient.h"
 #include "epicsEvent.h"
+#include "epicsTime.h"
 #include "PvObject.h"
 #include "PvProvider.h"
 #include "PvaPyLogger.h"
@@ -27,11 +31,14 @@ public:
     static const char* DefaultRequestDescriptor;
     static const double DefaultTimeout;
         
-    Channel(const std::string& channelName, PvProvider::ProviderType providerType=PvProvider::PvaProviderType);
+    Channel(const std::string& channelName, PvProvider::ProviderType providerType=PvProvider::PvaProviderType, bool waitForConnection=true);
     Channel(const Channel& channel);
     virtual ~Channel();
 
     std::string getName() const;
+    virtual void issueConnect();
+    virtual void waitConnect(double timeout);
+    virtual bool isConnected();
     virtual PvObject* get(const std::string& requestDescriptor);
     virtual PvObject* get();
     virtual void put(const PvObject& pvObject, const std::string& requestDescriptor);
@@ -42,6 +49,8 @@ public:
     virtual void put(const std::string& value);
     virtual void put(const boost::python::list& pyList, const std::string& requestDescriptor);
     virtual void put(const boost::python::list& pyList);
+    virtual void put(const boost::python::object& pyObject, const std::string& requestDescriptor);
+    virtual void put(const boost::python::object& pyObject);
 
     virtual void put(bool value, const std::string& requestDescriptor);
     virtual void put(bool value);
@@ -66,9 +75,18 @@ public:
     virtual void put(double value, const std::string& requestDescriptor);
     virtual void put(double value);
 
+    virtual ChannelAsyncRequestPtr createAsyncGetRequest(const std::string& requestDescriptor);
+    virtual ChannelAsyncRequestPtr createAsyncPutRequest(const PvObject& pvObject, const std::string& requestDescriptor);
+    virtual void asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor);
+    virtual void asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+    virtual void asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor);
+    virtual void asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+    virtual void asyncConnect(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+
     virtual void subscribe(const std::string& subscriberName, const boost::python::object& pySubscriber);
+    virtual void subscribeBatch(const std::string& subscriberName, const boost::python::object& pySubscriber);
     virtual void unsubscribe(const std::string& subscriberName);
-    virtual void callSubscribers(PvObject& pvObject);
+    virtual void callSubscribers(std::vector<PvObject>& pvObjects);
     virtual void startMonitor(const std::string& requestDescriptor);
     virtual void startMonitor();
     virtual void stopMonitor();
@@ -77,18 +95,38 @@ public:
     virtual double getTimeout() const;
     virtual void setMonitorMaxQueueLength(int maxLength);
     virtual int getMonitorMaxQueueLength();
+    virtual void setMonitorOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy);
+    virtual QueueOverflowPolicy::PolicyType getMonitorOverflowPolicy();
+    virtual boost::python::dict getMonitorStatistics();
+    virtual void setMonitorQueueLockFree(bool lockFree);
+    virtual bool isMonitorQueueLockFree() const;
+    virtual void setMonitorCopyOnChange(bool copyOnChange);
+    virtual bool isMonitorCopyOnChange() const;
+    virtual void setMonitorBatchSize(int batchSize);
+    virtual int getMonitorBatchSize() const;
+    virtual void setMonitorBatchTime(double batchTime);
+    virtual double getMonitorBatchTime() const;
+
+    static void setMonitorWorkerPoolSize(int workerPoolSize);
+    static int getMonitorWorkerPoolSize();
 
 private:
-    static const double ShutdownWaitTime;
+    friend class ChannelMonitorDispatcher;
+
+    static const int DefaultMonitorBatchSize;
+
+    template<typename T>
+    void putScalar(T value, const std::string& requestDescriptor);
 
     static PvaPyLogger logger;
     static PvaClient pvaClient;
     static CaClient caClient;
-    static void monitorThread(Channel* channel);
 
+    epics::pvData::PVStructurePtr getPvStructure(const std::string& requestDescriptor);
     ChannelMonitorRequesterImpl* getMonitorRequester(); 
-    bool processMonitorElement();
-    void notifyMonitorThreadExit();
+    bool processMonitorElement(double& retryDelay);
+    int dequeueMonitorData(std::vector<PvObject>& pvObjects, int maxObjects, double timeout);
+    void notifyProcessingThreadExit();
 
     epics::pvData::Requester::shared_pointer requester;
     std::tr1::shared_ptr<ChannelRequesterImpl> requesterImpl;
@@ -99,11 +137,18 @@ private:
     epics::pvData::Monitor::shared_pointer monitor;
     bool monitorThreadDone;
     SynchronizedQueue<PvObject> pvObjectMonitorQueue;
+    bool monitorQueueLockFree;
+    bool monitorCopyOnChange;
     std::map<std::string, boost::python::object> subscriberMap;
+    std::map<std::string, boost::python::object> batchSubscriberMap;
+    int monitorBatchSize;
+    double monitorBatchTime;
+    std::vector<PvObject> monitorBatchPvObjects;
+    epicsTime monitorBatchStartTime;
     epics::pvData::Mutex subscriberMutex;
     epics::pvData::Mutex monitorElementProcessingMutex;
     epics::pvData::Mutex monitorThreadMutex;
-    epicsEvent monitorThreadExitEvent;
+    epicsEvent processingThreadExitEvent;
     double timeout;
 };
 
@@ -134,9 +179,41 @@ inline int Channel::getMonitorMaxQueueLength()
     return monitorRequester->getPvObjectQueueMaxLength();
 }
 
-inline void Channel::notifyMonitorThreadExit() 
+inline void Channel::setMonitorOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy) 
+{
+    ChannelMonitorRequesterImpl* monitorRequester = getMonitorRequester();
+    monitorRequester->setPvObjectQueueOverflowPolicy(overflowPolicy);
+}
+
+inline QueueOverflowPolicy::PolicyType Channel::getMonitorOverflowPolicy() 
+{
+    ChannelMonitorRequesterImpl* monitorRequester = getMonitorRequester();
+    return monitorRequester->getPvObjectQueueOverflowPolicy();
+}
+
+inline void Channel::notifyProcessingThreadExit() 
+{
+    processingThreadExitEvent.signal();
+}
+
+inline bool Channel::isMonitorQueueLockFree() const
+{
+    return monitorQueueLockFree;
+}
+
+inline bool Channel::isMonitorCopyOnChange() const
+{
+    return monitorCopyOnChange;
+}
+
+inline int Channel::getMonitorBatchSize() const
+{
+    return monitorBatchSize;
+}
+
+inline double Channel::getMonitorBatchTime() const
 {
-    monitorThreadExitEvent.signal();
+    return monitorBatchTime;
 }
 
 #endif
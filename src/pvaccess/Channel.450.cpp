@@ -7,6 +7,7 @@
 
 #include "Channel.h"
 #include "epicsThread.h"
+#include "epicsTime.h"
 #include "ChannelGetRequesterImpl.h"
 #include "ChannelPutRequesterImpl.h"
 #include "GetFieldRequesterImpl.h"
@@ -19,40 +20,112 @@
 #include "InvalidArgument.h"
 #include "ObjectNotFound.h"
 #include "PyGilManager.h"
+#include "PyGilRelease.h"
 #include "PvUtility.h"
 #include "PyUtility.h"
+#include "PyPvDataUtility.h"
+#include "PvaConstants.h"
+#include "ChannelMonitorDispatcher.h"
 
 const char* Channel::DefaultRequestDescriptor("field(value)");
 const double Channel::DefaultTimeout(3.0);
-const double Channel::ShutdownWaitTime(0.1);
+const int Channel::DefaultMonitorBatchSize(1);
 
 PvaPyLogger Channel::logger("Channel");
 PvaClient Channel::pvaClient;
 CaClient Channel::caClient;
 epics::pvaClient::PvaClientPtr Channel::pvaClientPtr(epics::pvaClient::PvaClient::create());
 
+//
+// Channel state changes advance connection generation, which invalidates
+// cached get/put objects, and wake up asynchronous request dispatcher, as
+// pending requests may be waiting for channel connection.
+//
+class ChannelStateChangeRequester : public epics::pvaClient::PvaClientChannelStateChangeRequester
+{
+public:
+    POINTER_DEFINITIONS(ChannelStateChangeRequester);
+    ChannelStateChangeRequester();
+    virtual void channelStateChange(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannel, bool isConnected);
+    int getConnectionGeneration();
+
+private:
+    epics::pvData::Mutex mutex;
+    int connectionGeneration;
+};
+
+ChannelStateChangeRequester::ChannelStateChangeRequester() :
+    mutex(),
+    connectionGeneration(0)
+{
+}
+
+void ChannelStateChangeRequester::channelStateChange(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannel, bool isConnected)
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        connectionGeneration++;
+    }
+    ChannelAsyncRequest::notifyDispatcher();
+}
+
+int ChannelStateChangeRequester::getConnectionGeneration()
+{
+    epics::pvData::Lock lock(mutex);
+    return connectionGeneration;
+}
 
-Channel::Channel(const std::string& channelName, PvProvider::ProviderType providerType) :
+Channel::Channel(const std::string& channelName, PvProvider::ProviderType providerType, bool waitForConnection) :
     pvaClientChannelPtr(pvaClientPtr->createChannel(channelName,PvProvider::getProviderName(providerType))),
+    stateChangeRequesterPtr(new ChannelStateChangeRequester()),
+    monitorCollectorPtr(),
+    requestCache(new PvaClientRequestCache()),
     pvObjectMonitorQueue(),
+    pvObjectMonitorRingBuffer(0, PvObject(epics::pvData::PVStructurePtr())),
+    monitorQueueLockFree(false),
+    monitorCopyOnChange(false),
+    monitorSnapshotPool(),
     monitorThreadDone(true),
     subscriberMap(),
+    batchSubscriberMap(),
+    monitorBatchSize(DefaultMonitorBatchSize),
+    monitorBatchTime(0),
+    monitorBatchPvObjects(),
+    monitorBatchStartTime(),
     subscriberMutex(),
     monitorElementProcessingMutex(),
     monitorThreadMutex(),
-    monitorThreadExitEvent(),
+    processingThreadExitEvent(),
     timeout(DefaultTimeout)
 {
-    connect();
+    pvaClientChannelPtr->setStateChangeRequester(stateChangeRequesterPtr);
+    if (waitForConnection) {
+        connect();
+    }
+    else {
+        issueConnect();
+    }
 }
     
 Channel::Channel(const Channel& c) :
     pvaClientChannelPtr(c.pvaClientChannelPtr),
+    stateChangeRequesterPtr(c.stateChangeRequesterPtr),
+    monitorCollectorPtr(),
+    requestCache(new PvaClientRequestCache()),
     pvObjectMonitorQueue(),
+    pvObjectMonitorRingBuffer(0, PvObject(epics::pvData::PVStructurePtr())),
+    monitorQueueLockFree(false),
+    monitorCopyOnChange(false),
+    monitorSnapshotPool(),
     monitorThreadDone(true),
     subscriberMap(),
+    batchSubscriberMap(),
+    monitorBatchSize(DefaultMonitorBatchSize),
+    monitorBatchTime(0),
+    monitorBatchPvObjects(),
+    monitorBatchStartTime(),
     subscriberMutex(),
-    monitorThreadExitEvent(),
+    processingThreadExitEvent(),
     timeout(DefaultTimeout)
 {
     connect();
@@ -60,14 +133,20 @@ Channel::Channel(const Channel& c) :
 
 Channel::~Channel()
 {
-    stopMonitor();
-    epicsThreadSleep(ShutdownWaitTime);
+    // Monitor workers are done with channel once monitor is stopped
+    try {
+        stopMonitor();
+    }
+    catch (const std::exception& ex) {
+        logger.error("Error stopping monitor for channel %s: %s", getName().c_str(), ex.what());
+    }
     pvaClientChannelPtr.reset();
 }
 
 void Channel::connect() 
 {
     try {
+        PyGilRelease pyGilRelease;
         pvaClientChannelPtr->connect(timeout);
     } 
     catch (std::runtime_error e) {
@@ -75,6 +154,577 @@ void Channel::connect()
     }
 }
 
+void Channel::issueConnect()
+{
+    try {
+        pvaClientChannelPtr->issueConnect();
+    }
+    catch (std::runtime_error e) {
+        throw PvaException(e.what());
+    }
+}
+
+void Channel::waitConnect(double timeout)
+{
+    PyGilRelease pyGilRelease;
+    waitUntilConnected(timeout);
+}
+
+void Channel::waitUntilConnected(double timeout)
+{
+    epics::pvData::Status status = pvaClientChannelPtr->waitConnect(timeout);
+    if (!status.isOK()) {
+        throw ChannelTimeout("Channel %s connection timed out", pvaClientChannelPtr->getChannelName().c_str());
+    }
+}
+
+// Channel that was created without waiting for connection, or that
+// got disconnected, is waited for before the next request
+void Channel::ensureConnected()
+{
+    if (!isConnected()) {
+        waitUntilConnected(timeout);
+    }
+}
+
+bool Channel::isConnected()
+{
+    epics::pvAccess::Channel::shared_pointer channel = pvaClientChannelPtr->getChannel();
+    return channel && channel->isConnected();
+}
+
+//
+// Request cache
+//
+PvaClientRequestCache::PvaClientRequestCache() :
+    pvaClientGetMap(),
+    pvaClientPutMap(),
+    connectionGeneration(0),
+    mutex()
+{
+}
+
+// Must be called with cache lock held
+void PvaClientRequestCache::checkConnectionGeneration(int connectionGeneration)
+{
+    if (connectionGeneration != this->connectionGeneration) {
+        pvaClientGetMap.clear();
+        pvaClientPutMap.clear();
+        this->connectionGeneration = connectionGeneration;
+    }
+}
+
+epics::pvaClient::PvaClientGetPtr PvaClientRequestCache::acquireGet(const std::string& requestDescriptor, int connectionGeneration)
+{
+    epics::pvData::Lock lock(mutex);
+    checkConnectionGeneration(connectionGeneration);
+    epics::pvaClient::PvaClientGetPtr pvaGet;
+    std::map<std::string, epics::pvaClient::PvaClientGetPtr>::iterator iterator = pvaClientGetMap.find(requestDescriptor);
+    if (iterator != pvaClientGetMap.end()) {
+        pvaGet = iterator->second;
+        pvaClientGetMap.erase(iterator);
+    }
+    return pvaGet;
+}
+
+void PvaClientRequestCache::releaseGet(const std::string& requestDescriptor, const epics::pvaClient::PvaClientGetPtr& pvaGet, int connectionGeneration)
+{
+    epics::pvData::Lock lock(mutex);
+    if (connectionGeneration != this->connectionGeneration) {
+        return;
+    }
+    if (pvaClientGetMap.find(requestDescriptor) == pvaClientGetMap.end()) {
+        pvaClientGetMap[requestDescriptor] = pvaGet;
+    }
+}
+
+epics::pvaClient::PvaClientPutPtr PvaClientRequestCache::acquirePut(const std::string& requestDescriptor, int connectionGeneration)
+{
+    epics::pvData::Lock lock(mutex);
+    checkConnectionGeneration(connectionGeneration);
+    epics::pvaClient::PvaClientPutPtr pvaPut;
+    std::map<std::string, epics::pvaClient::PvaClientPutPtr>::iterator iterator = pvaClientPutMap.find(requestDescriptor);
+    if (iterator != pvaClientPutMap.end()) {
+        pvaPut = iterator->second;
+        pvaClientPutMap.erase(iterator);
+    }
+    return pvaPut;
+}
+
+void PvaClientRequestCache::releasePut(const std::string& requestDescriptor, const epics::pvaClient::PvaClientPutPtr& pvaPut, int connectionGeneration)
+{
+    epics::pvData::Lock lock(mutex);
+    if (connectionGeneration != this->connectionGeneration) {
+        return;
+    }
+    if (pvaClientPutMap.find(requestDescriptor) == pvaClientPutMap.end()) {
+        pvaClientPutMap[requestDescriptor] = pvaPut;
+    }
+}
+
+//
+// Monitor data is collected in pvAccess monitor callbacks. Channel detaches
+// collector when monitor is stopped, which waits for a callback that may
+// still be in progress.
+//
+class ChannelMonitorCollector : public epics::pvaClient::PvaClientMonitorRequester
+{
+public:
+    POINTER_DEFINITIONS(ChannelMonitorCollector);
+    ChannelMonitorCollector(Channel* channel);
+    virtual ~ChannelMonitorCollector();
+    virtual void event(const epics::pvaClient::PvaClientMonitorPtr& monitor);
+    void detach();
+private:
+    Channel* channel;
+    epics::pvData::Mutex mutex;
+};
+
+ChannelMonitorCollector::ChannelMonitorCollector(Channel* channel_) :
+    channel(channel_),
+    mutex()
+{
+}
+
+ChannelMonitorCollector::~ChannelMonitorCollector()
+{
+}
+
+void ChannelMonitorCollector::event(const epics::pvaClient::PvaClientMonitorPtr& monitor)
+{
+    epics::pvData::Lock lock(mutex);
+    if (channel) {
+        channel->collectMonitorData(monitor);
+    }
+}
+
+void ChannelMonitorCollector::detach()
+{
+    epics::pvData::Lock lock(mutex);
+    channel = NULL;
+}
+
+//
+// Asynchronous requests. Get/put objects taken from the channel request
+// cache are connected and can be issued right away; otherwise, the
+// dispatcher creates and connects new objects once the channel is
+// connected, and issues them once they are connected. Requester and
+// channel state callbacks wake up the dispatcher, so that it never waits
+// for any particular request.
+//
+// pvaClient get/put waits have no timeout, so they are only used after
+// requester callbacks have been received, to collect status, and return
+// right away.
+//
+class ChannelAsyncRequestEvents
+{
+public:
+    ChannelAsyncRequestEvents();
+    bool waitConnect(double timeout);
+    bool waitDone(double timeout);
+    bool isConnectDone();
+    bool isDone();
+
+protected:
+    void signalConnect();
+    void signalDone();
+
+private:
+    epicsEvent connectEvent;
+    epicsEvent doneEvent;
+    epics::pvData::Mutex mutex;
+    bool connectDone;
+    bool done;
+};
+
+ChannelAsyncRequestEvents::ChannelAsyncRequestEvents() :
+    connectEvent(),
+    doneEvent(),
+    mutex(),
+    connectDone(false),
+    done(false)
+{
+}
+
+bool ChannelAsyncRequestEvents::waitConnect(double timeout)
+{
+    return isConnectDone() || connectEvent.wait(timeout);
+}
+
+bool ChannelAsyncRequestEvents::waitDone(double timeout)
+{
+    return isDone() || doneEvent.wait(timeout);
+}
+
+bool ChannelAsyncRequestEvents::isConnectDone()
+{
+    epics::pvData::Lock lock(mutex);
+    return connectDone;
+}
+
+bool ChannelAsyncRequestEvents::isDone()
+{
+    epics::pvData::Lock lock(mutex);
+    return done;
+}
+
+void ChannelAsyncRequestEvents::signalConnect()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        connectDone = true;
+    }
+    connectEvent.signal();
+    ChannelAsyncRequest::notifyDispatcher();
+}
+
+void ChannelAsyncRequestEvents::signalDone()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        done = true;
+    }
+    doneEvent.signal();
+    ChannelAsyncRequest::notifyDispatcher();
+}
+
+class ChannelAsyncGetRequester : public epics::pvaClient::PvaClientGetRequester, public ChannelAsyncRequestEvents
+{
+public:
+    virtual void channelGetConnect(const epics::pvData::Status& status, const epics::pvaClient::PvaClientGetPtr& pvaGet);
+    virtual void getDone(const epics::pvData::Status& status, const epics::pvaClient::PvaClientGetPtr& pvaGet);
+};
+
+void ChannelAsyncGetRequester::channelGetConnect(const epics::pvData::Status& status, const epics::pvaClient::PvaClientGetPtr& pvaGet)
+{
+    signalConnect();
+}
+
+void ChannelAsyncGetRequester::getDone(const epics::pvData::Status& status, const epics::pvaClient::PvaClientGetPtr& pvaGet)
+{
+    signalDone();
+}
+
+class ChannelAsyncPutRequester : public epics::pvaClient::PvaClientPutRequester, public ChannelAsyncRequestEvents
+{
+public:
+    virtual void channelPutConnect(const epics::pvData::Status& status, const epics::pvaClient::PvaClientPutPtr& pvaPut);
+    virtual void putDone(const epics::pvData::Status& status, const epics::pvaClient::PvaClientPutPtr& pvaPut);
+};
+
+void ChannelAsyncPutRequester::channelPutConnect(const epics::pvData::Status& status, const epics::pvaClient::PvaClientPutPtr& pvaPut)
+{
+    signalConnect();
+}
+
+void ChannelAsyncPutRequester::putDone(const epics::pvData::Status& status, const epics::pvaClient::PvaClientPutPtr& pvaPut)
+{
+    signalDone();
+}
+
+static bool isChannelConnected(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr)
+{
+    epics::pvAccess::Channel::shared_pointer channel = pvaClientChannelPtr->getChannel();
+    return channel && channel->isConnected();
+}
+
+class ChannelAsyncConnectRequest : public ChannelAsyncRequest
+{
+public:
+    ChannelAsyncConnectRequest(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr, double timeout);
+    virtual bool isDone();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    epics::pvaClient::PvaClientChannelPtr pvaClientChannelPtr;
+};
+
+ChannelAsyncConnectRequest::ChannelAsyncConnectRequest(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr_, double timeout) :
+    ChannelAsyncRequest(pvaClientChannelPtr_->getChannelName(), timeout),
+    pvaClientChannelPtr(pvaClientChannelPtr_)
+{
+}
+
+bool ChannelAsyncConnectRequest::isDone()
+{
+    return isChannelConnected(pvaClientChannelPtr);
+}
+
+epics::pvData::PVStructurePtr ChannelAsyncConnectRequest::waitForCompletion()
+{
+    epics::pvData::Status status = pvaClientChannelPtr->waitConnect(getRemainingTimeout());
+    if (!status.isOK()) {
+        throw ChannelTimeout("Channel %s connection timed out", getChannelName().c_str());
+    }
+    return epics::pvData::PVStructurePtr();
+}
+
+class ChannelAsyncGetRequest : public ChannelAsyncRequest
+{
+public:
+    ChannelAsyncGetRequest(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr, double timeout, const PvaClientRequestCachePtr& requestCache, int connectionGeneration, const std::string& requestDescriptor, const epics::pvaClient::PvaClientGetPtr& pvaGet);
+    virtual void tryIssue();
+    virtual void issue();
+    virtual bool isDone();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    void issueGetConnect();
+    void issueGet();
+
+    epics::pvaClient::PvaClientChannelPtr pvaClientChannelPtr;
+    PvaClientRequestCachePtr requestCache;
+    int connectionGeneration;
+    std::string requestDescriptor;
+    epics::pvaClient::PvaClientGetPtr pvaGet;
+    std::tr1::shared_ptr<ChannelAsyncGetRequester> getRequester;
+    bool issued;
+};
+
+ChannelAsyncGetRequest::ChannelAsyncGetRequest(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr_, double timeout, const PvaClientRequestCachePtr& requestCache_, int connectionGeneration_, const std::string& requestDescriptor_, const epics::pvaClient::PvaClientGetPtr& pvaGet_) :
+    ChannelAsyncRequest(pvaClientChannelPtr_->getChannelName(), timeout),
+    pvaClientChannelPtr(pvaClientChannelPtr_),
+    requestCache(requestCache_),
+    connectionGeneration(connectionGeneration_),
+    requestDescriptor(requestDescriptor_),
+    pvaGet(pvaGet_),
+    getRequester(new ChannelAsyncGetRequester()),
+    issued(false)
+{
+    if (pvaGet) {
+        pvaGet->setRequester(getRequester);
+        pvaGet->issueGet();
+        issued = true;
+    }
+}
+
+void ChannelAsyncGetRequest::issueGetConnect()
+{
+    pvaGet = pvaClientChannelPtr->createGet(requestDescriptor);
+    pvaGet->setRequester(getRequester);
+    pvaGet->issueConnect();
+}
+
+void ChannelAsyncGetRequest::issueGet()
+{
+    epics::pvData::Status status = pvaGet->waitConnect();
+    if (!status.isOK()) {
+        throw PvaException("Channel %s get connect failed: %s", getChannelName().c_str(), status.getMessage().c_str());
+    }
+    pvaGet->issueGet();
+    issued = true;
+}
+
+void ChannelAsyncGetRequest::tryIssue()
+{
+    if (issued) {
+        return;
+    }
+    if (!pvaGet) {
+        if (!isChannelConnected(pvaClientChannelPtr)) {
+            return;
+        }
+        issueGetConnect();
+    }
+    if (getRequester->isConnectDone()) {
+        issueGet();
+    }
+}
+
+void ChannelAsyncGetRequest::issue()
+{
+    if (issued) {
+        return;
+    }
+    if (!pvaGet) {
+        epics::pvData::Status status = pvaClientChannelPtr->waitConnect(getRemainingTimeout());
+        if (!status.isOK()) {
+            throw ChannelTimeout("Channel %s timed out", getChannelName().c_str());
+        }
+        issueGetConnect();
+    }
+    if (!getRequester->waitConnect(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s get connect timed out", getChannelName().c_str());
+    }
+    issueGet();
+}
+
+bool ChannelAsyncGetRequest::isDone()
+{
+    return issued && getRequester->isDone();
+}
+
+epics::pvData::PVStructurePtr ChannelAsyncGetRequest::waitForCompletion()
+{
+    if (!getRequester->waitDone(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s get request timed out", getChannelName().c_str());
+    }
+    epics::pvData::Status status = pvaGet->waitGet();
+    if (!status.isOK()) {
+        throw PvaException("Channel %s get request failed: %s", getChannelName().c_str(), status.getMessage().c_str());
+    }
+    epics::pvData::PVStructurePtr pvStructure = epics::pvData::getPVDataCreate()->createPVStructure(pvaGet->getData()->getPVStructure());
+    requestCache->releaseGet(requestDescriptor, pvaGet, connectionGeneration);
+    return pvStructure;
+}
+
+class ChannelAsyncPutRequest : public ChannelAsyncRequest
+{
+public:
+    ChannelAsyncPutRequest(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr, double timeout, const PvaClientRequestCachePtr& requestCache, int connectionGeneration, const std::string& requestDescriptor, const epics::pvaClient::PvaClientPutPtr& pvaPut, const PvObject& pvObject);
+    virtual void tryIssue();
+    virtual void issue();
+    virtual bool isDone();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    void issuePutConnect();
+    void issuePut();
+
+    epics::pvaClient::PvaClientChannelPtr pvaClientChannelPtr;
+    PvaClientRequestCachePtr requestCache;
+    int connectionGeneration;
+    std::string requestDescriptor;
+    epics::pvaClient::PvaClientPutPtr pvaPut;
+    PvObject pvObject;
+    std::tr1::shared_ptr<ChannelAsyncPutRequester> putRequester;
+    bool issued;
+};
+
+ChannelAsyncPutRequest::ChannelAsyncPutRequest(const epics::pvaClient::PvaClientChannelPtr& pvaClientChannelPtr_, double timeout, const PvaClientRequestCachePtr& requestCache_, int connectionGeneration_, const std::string& requestDescriptor_, const epics::pvaClient::PvaClientPutPtr& pvaPut_, const PvObject& pvObject_) :
+    ChannelAsyncRequest(pvaClientChannelPtr_->getChannelName(), timeout),
+    pvaClientChannelPtr(pvaClientChannelPtr_),
+    requestCache(requestCache_),
+    connectionGeneration(connectionGeneration_),
+    requestDescriptor(requestDescriptor_),
+    pvaPut(pvaPut_),
+    pvObject(pvObject_),
+    putRequester(new ChannelAsyncPutRequester()),
+    issued(false)
+{
+    if (pvaPut) {
+        pvaPut->setRequester(putRequester);
+        epics::pvData::PVStructurePtr pvSend = pvaPut->getData()->getPVStructure();
+        pvSend << pvObject;
+        pvaPut->issuePut();
+        issued = true;
+    }
+}
+
+void ChannelAsyncPutRequest::issuePutConnect()
+{
+    pvaPut = pvaClientChannelPtr->createPut(requestDescriptor);
+    pvaPut->setRequester(putRequester);
+    pvaPut->issueConnect();
+}
+
+void ChannelAsyncPutRequest::issuePut()
+{
+    epics::pvData::Status status = pvaPut->waitConnect();
+    if (!status.isOK()) {
+        throw PvaException("Channel %s put connect failed: %s", getChannelName().c_str(), status.getMessage().c_str());
+    }
+    epics::pvData::PVStructurePtr pvSend = pvaPut->getData()->getPVStructure();
+    pvSend << pvObject;
+    pvaPut->issuePut();
+    issued = true;
+}
+
+void ChannelAsyncPutRequest::tryIssue()
+{
+    if (issued) {
+        return;
+    }
+    if (!pvaPut) {
+        if (!isChannelConnected(pvaClientChannelPtr)) {
+            return;
+        }
+        issuePutConnect();
+    }
+    if (putRequester->isConnectDone()) {
+        issuePut();
+    }
+}
+
+void ChannelAsyncPutRequest::issue()
+{
+    if (issued) {
+        return;
+    }
+    if (!pvaPut) {
+        epics::pvData::Status status = pvaClientChannelPtr->waitConnect(getRemainingTimeout());
+        if (!status.isOK()) {
+            throw ChannelTimeout("Channel %s timed out", getChannelName().c_str());
+        }
+        issuePutConnect();
+    }
+    if (!putRequester->waitConnect(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s put connect timed out", getChannelName().c_str());
+    }
+    issuePut();
+}
+
+bool ChannelAsyncPutRequest::isDone()
+{
+    return issued && putRequester->isDone();
+}
+
+epics::pvData::PVStructurePtr ChannelAsyncPutRequest::waitForCompletion()
+{
+    if (!putRequester->waitDone(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s put request timed out", getChannelName().c_str());
+    }
+    epics::pvData::Status status = pvaPut->waitPut();
+    if (!status.isOK()) {
+        throw PvaException("Channel %s put request failed: %s", getChannelName().c_str(), status.getMessage().c_str());
+    }
+    requestCache->releasePut(requestDescriptor, pvaPut, connectionGeneration);
+    return epics::pvData::PVStructurePtr();
+}
+
+//
+// Channel
+//
+int Channel::getConnectionGeneration()
+{
+    return stateChangeRequesterPtr->getConnectionGeneration();
+}
+
+epics::pvaClient::PvaClientGetPtr Channel::acquirePvaClientGet(const std::string& requestDescriptor, int& connectionGeneration)
+{
+    ensureConnected();
+    connectionGeneration = getConnectionGeneration();
+    epics::pvaClient::PvaClientGetPtr pvaGet = requestCache->acquireGet(requestDescriptor, connectionGeneration);
+    if (!pvaGet) {
+        logger.trace("Creating get object for request descriptor " + requestDescriptor);
+        pvaGet = pvaClientChannelPtr->createGet(requestDescriptor);
+        pvaGet->connect();
+    }
+    return pvaGet;
+}
+
+void Channel::releasePvaClientGet(const std::string& requestDescriptor, const epics::pvaClient::PvaClientGetPtr& pvaGet, int connectionGeneration)
+{
+    requestCache->releaseGet(requestDescriptor, pvaGet, connectionGeneration);
+}
+
+epics::pvaClient::PvaClientPutPtr Channel::acquirePvaClientPut(const std::string& requestDescriptor, int& connectionGeneration)
+{
+    ensureConnected();
+    connectionGeneration = getConnectionGeneration();
+    epics::pvaClient::PvaClientPutPtr pvaPut = requestCache->acquirePut(requestDescriptor, connectionGeneration);
+    if (!pvaPut) {
+        logger.trace("Creating put object for request descriptor " + requestDescriptor);
+        pvaPut = pvaClientChannelPtr->put(requestDescriptor);
+    }
+    return pvaPut;
+}
+
+void Channel::releasePvaClientPut(const std::string& requestDescriptor, const epics::pvaClient::PvaClientPutPtr& pvaPut, int connectionGeneration)
+{
+    requestCache->releasePut(requestDescriptor, pvaPut, connectionGeneration);
+}
+
 PvObject* Channel::get()
 {
     return get(DefaultRequestDescriptor);
@@ -82,15 +732,22 @@ PvObject* Channel::get()
 
 PvObject* Channel::get(const std::string& requestDescriptor) 
 {
+    epics::pvData::PVStructurePtr pvStructure;
     try {
-        epics::pvaClient::PvaClientGetPtr pvaGet = pvaClientChannelPtr->createGet(requestDescriptor);
+        PyGilRelease pyGilRelease;
+        int connectionGeneration;
+        epics::pvaClient::PvaClientGetPtr pvaGet = acquirePvaClientGet(requestDescriptor, connectionGeneration);
         pvaGet->get();
-        epics::pvData::PVStructurePtr pvStructure = pvaGet->getData()->getPVStructure();
-        return new PvObject(pvStructure);
+
+        // Cached get object reuses its data structure, so result
+        // must be copied before the object is returned to cache
+        pvStructure = epics::pvData::getPVDataCreate()->createPVStructure(pvaGet->getData()->getPVStructure());
+        releasePvaClientGet(requestDescriptor, pvaGet, connectionGeneration);
     }
     catch (std::runtime_error e) {
         throw PvaException(e.what());
     }
+    return new PvObject(pvStructure);
 }
 
 void Channel::put(const PvObject& pvObject)
@@ -101,10 +758,13 @@ void Channel::put(const PvObject& pvObject)
 void Channel::put(const PvObject& pvObject, const std::string& requestDescriptor) 
 {
     try {
-        epics::pvaClient::PvaClientPutPtr pvaPut = pvaClientChannelPtr->put(requestDescriptor);
+        PyGilRelease pyGilRelease;
+        int connectionGeneration;
+        epics::pvaClient::PvaClientPutPtr pvaPut = acquirePvaClientPut(requestDescriptor, connectionGeneration);
         epics::pvData::PVStructurePtr pvSend = pvaPut->getData()->getPVStructure();
         pvSend << pvObject;
         pvaPut->put();
+        releasePvaClientPut(requestDescriptor, pvaPut, connectionGeneration);
     } 
     catch (std::runtime_error e) {
         throw PvaException(e.what());
@@ -119,10 +779,13 @@ void Channel::put(const std::vector<std::string>& values)
 void Channel::put(const std::vector<std::string>& values, const std::string& requestDescriptor) 
 {
     try {
-        epics::pvaClient::PvaClientPutPtr pvaPut = pvaClientChannelPtr->put(requestDescriptor);
+        PyGilRelease pyGilRelease;
+        int connectionGeneration;
+        epics::pvaClient::PvaClientPutPtr pvaPut = acquirePvaClientPut(requestDescriptor, connectionGeneration);
         epics::pvaClient::PvaClientPutDataPtr pvaData = pvaPut->getData();
         pvaData->putStringArray(values);
         pvaPut->put();
+        releasePvaClientPut(requestDescriptor, pvaPut, connectionGeneration);
     } 
     catch (std::runtime_error e) {
         throw PvaException(e.what());
@@ -140,10 +803,13 @@ void Channel::put(const std::string& value, const std::string& requestDescriptor
     //values.push_back(value);
     //put(values, requestDescriptor);
     try {
-        epics::pvaClient::PvaClientPutPtr pvaPut = pvaClientChannelPtr->put(requestDescriptor);
+        PyGilRelease pyGilRelease;
+        int connectionGeneration;
+        epics::pvaClient::PvaClientPutPtr pvaPut = acquirePvaClientPut(requestDescriptor, connectionGeneration);
         epics::pvData::PVScalarPtr pvScalar = pvaPut->getData()->getScalarValue();
         epics::pvData::getConvert()->fromString(pvScalar,value);
         pvaPut->put();
+        releasePvaClientPut(requestDescriptor, pvaPut, connectionGeneration);
     } 
     catch (std::runtime_error e) {
         throw PvaException(e.what());
@@ -152,12 +818,9 @@ void Channel::put(const std::string& value, const std::string& requestDescriptor
 
 void Channel::put(const boost::python::list& pyList, const std::string& requestDescriptor) 
 {
-    int listSize = boost::python::len(pyList);
-    std::vector<std::string> values(listSize);
-    for (int i = 0; i < listSize; i++) {
-        values[i] = PyUtility::extractStringFromPyObject(pyList[i]);
-    }
-    put(values, requestDescriptor);
+    // List elements are converted directly to the channel array type
+    const boost::python::object& pyObject = pyList;
+    put(pyObject, requestDescriptor);
 }
 
 void Channel::put(const boost::python::list& pyList)
@@ -165,9 +828,54 @@ void Channel::put(const boost::python::list& pyList)
     put(pyList, DefaultRequestDescriptor);
 }
 
+void Channel::put(const boost::python::object& pyObject, const std::string& requestDescriptor) 
+{
+    try {
+        epics::pvaClient::PvaClientPutPtr pvaPut;
+        int connectionGeneration;
+        {
+            PyGilRelease pyGilRelease;
+            pvaPut = acquirePvaClientPut(requestDescriptor, connectionGeneration);
+        }
+
+        // Python object conversion requires GIL
+        epics::pvData::PVStructurePtr pvSend = pvaPut->getData()->getPVStructure();
+        PyPvDataUtility::pyObjectToScalarArrayField(pyObject, PvaConstants::ValueFieldKey, pvSend);
+
+        PyGilRelease pyGilRelease;
+        pvaPut->put();
+        releasePvaClientPut(requestDescriptor, pvaPut, connectionGeneration);
+    } 
+    catch (std::runtime_error e) {
+        throw PvaException(e.what());
+    }
+}
+
+void Channel::put(const boost::python::object& pyObject)
+{
+    put(pyObject, DefaultRequestDescriptor);
+}
+
+template<typename T>
+void Channel::putScalar(T value, const std::string& requestDescriptor)
+{
+    try {
+        PyGilRelease pyGilRelease;
+        int connectionGeneration;
+        epics::pvaClient::PvaClientPutPtr pvaPut = acquirePvaClientPut(requestDescriptor, connectionGeneration);
+        epics::pvData::PVScalarPtr pvScalar = pvaPut->getData()->getScalarValue();
+        pvScalar->putFrom<T>(value);
+        pvaPut->put();
+        releasePvaClientPut(requestDescriptor, pvaPut, connectionGeneration);
+    } 
+    catch (std::runtime_error e) {
+        throw PvaException(e.what());
+    }
+}
+
 void Channel::put(bool value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<bool>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::boolean>(value), requestDescriptor);
 }
 
 void Channel::put(bool value)
@@ -177,7 +885,7 @@ void Channel::put(bool value)
 
 void Channel::put(char value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<int>(static_cast<int>(value)), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int8>(value), requestDescriptor);
 }
 
 void Channel::put(char value)
@@ -187,7 +895,7 @@ void Channel::put(char value)
 
 void Channel::put(unsigned char value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<int>(static_cast<int>(value)), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint8>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned char value)
@@ -197,7 +905,7 @@ void Channel::put(unsigned char value)
 
 void Channel::put(short value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<short>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int16>(value), requestDescriptor);
 }
 
 void Channel::put(short value)
@@ -207,7 +915,7 @@ void Channel::put(short value)
 
 void Channel::put(unsigned short value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<unsigned short>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint16>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned short value)
@@ -217,7 +925,7 @@ void Channel::put(unsigned short value)
 
 void Channel::put(int value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<int>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int32>(value), requestDescriptor);
 }
 
 void Channel::put(int value)
@@ -227,7 +935,7 @@ void Channel::put(int value)
 
 void Channel::put(unsigned int value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<unsigned int>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint32>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned int value)
@@ -237,7 +945,7 @@ void Channel::put(unsigned int value)
 
 void Channel::put(long long value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<long long>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::int64>(value), requestDescriptor);
 }
 
 void Channel::put(long long value)
@@ -247,7 +955,7 @@ void Channel::put(long long value)
 
 void Channel::put(unsigned long long value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<unsigned long long>(value), requestDescriptor);
+    putScalar(static_cast<epics::pvData::uint64>(value), requestDescriptor);
 }
 
 void Channel::put(unsigned long long value)
@@ -257,7 +965,7 @@ void Channel::put(unsigned long long value)
 
 void Channel::put(float value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<float>(value), requestDescriptor);
+    putScalar(static_cast<float>(value), requestDescriptor);
 }
 
 void Channel::put(float value)
@@ -267,7 +975,7 @@ void Channel::put(float value)
 
 void Channel::put(double value, const std::string& requestDescriptor)
 {
-    put(StringUtility::toString<double>(value), requestDescriptor);
+    putScalar(static_cast<double>(value), requestDescriptor);
 }
 
 void Channel::put(double value)
@@ -275,58 +983,154 @@ void Channel::put(double value)
     put(value, DefaultRequestDescriptor);
 }
 
+ChannelAsyncRequestPtr Channel::createAsyncGetRequest(const std::string& requestDescriptor)
+{
+    try {
+        PyGilRelease pyGilRelease;
+        int connectionGeneration = getConnectionGeneration();
+        epics::pvaClient::PvaClientGetPtr pvaGet = requestCache->acquireGet(requestDescriptor, connectionGeneration);
+        return ChannelAsyncRequestPtr(new ChannelAsyncGetRequest(pvaClientChannelPtr, timeout, requestCache, connectionGeneration, requestDescriptor, pvaGet));
+    }
+    catch (std::runtime_error e) {
+        throw PvaException(e.what());
+    }
+}
+
+ChannelAsyncRequestPtr Channel::createAsyncPutRequest(const PvObject& pvObject, const std::string& requestDescriptor)
+{
+    try {
+        PyGilRelease pyGilRelease;
+        int connectionGeneration = getConnectionGeneration();
+        epics::pvData::PVStructurePtr pvStructurePtr = pvObject.getPvStructurePtr();
+        epics::pvaClient::PvaClientPutPtr pvaPut = requestCache->acquirePut(requestDescriptor, connectionGeneration);
+        if (!pvaPut) {
+            // Put data must be copied, as object may be modified
+            // before request is issued
+            pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(pvStructurePtr);
+        }
+        return ChannelAsyncRequestPtr(new ChannelAsyncPutRequest(pvaClientChannelPtr, timeout, requestCache, connectionGeneration, requestDescriptor, pvaPut, PvObject(pvStructurePtr)));
+    }
+    catch (std::runtime_error e) {
+        throw PvaException(e.what());
+    }
+}
+
+void Channel::asyncConnect(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    ChannelAsyncRequestPtr request(new ChannelAsyncConnectRequest(pvaClientChannelPtr, timeout));
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
+
+void Channel::asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    asyncGet(pyCallback, pyErrorCallback, DefaultRequestDescriptor);
+}
+
+void Channel::asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor)
+{
+    ChannelAsyncRequestPtr request = createAsyncGetRequest(requestDescriptor);
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
+
+void Channel::asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    asyncPut(pvObject, pyCallback, pyErrorCallback, DefaultRequestDescriptor);
+}
+
+void Channel::asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor)
+{
+    ChannelAsyncRequestPtr request = createAsyncPutRequest(pvObject, requestDescriptor);
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
+
 void Channel::subscribe(const std::string& subscriberName, const boost::python::object& pySubscriber)
 {
-    //epics::pvData::Lock lock(subscriberMutex);
+    // Subscriber maps are accessed with GIL held
+    batchSubscriberMap.erase(subscriberName);
     subscriberMap[subscriberName] = pySubscriber;
 }
 
+void Channel::subscribeBatch(const std::string& subscriberName, const boost::python::object& pySubscriber)
+{
+    subscriberMap.erase(subscriberName);
+    batchSubscriberMap[subscriberName] = pySubscriber;
+}
+
 void Channel::unsubscribe(const std::string& subscriberName)
 {
-    //epics::pvData::Lock lock(subscriberMutex);
-    boost::python::object pySubscriber = subscriberMap[subscriberName];
-    std::map<std::string,boost::python::object>::const_iterator iterator = subscriberMap.find(subscriberName);
-    if (iterator == subscriberMap.end()) {
+    if (subscriberMap.erase(subscriberName) == 0 && batchSubscriberMap.erase(subscriberName) == 0) {
         throw ObjectNotFound("Subscriber " + subscriberName + " is not registered.");
     }
-    subscriberMap.erase(subscriberName);
     logger.trace("Unsubscribed monitor " + subscriberName);
 }
 
-void Channel::callSubscribers(PvObject& pvObject)
+void Channel::callSubscribers(std::vector<PvObject>& pvObjects)
 {
-    //epics::pvData::Lock lock(subscriberMutex);
+    // Acquire GIL once for all PV objects. This is required because 
+    // callSubscribers() is called in a monitoring thread. Before monitoring
+    // thread is created, one must call PyEval_InitThreads() in the main 
+    // thread to initialize things properly. If this is not done, code will
+    // most likely crash while invoking python from c++, or while
+    // attempting to release GIL.
+    logger.trace("Acquiring python GIL for %d PV objects", int(pvObjects.size()));
+    PyGILState_STATE gilState = PyGilManager::gilStateEnsure();
 
+    // Subscribers may unsubscribe while being called, so maps are copied
+    std::map<std::string,boost::python::object> subscribers(subscriberMap);
+    std::map<std::string,boost::python::object> batchSubscribers(batchSubscriberMap);
     std::map<std::string,boost::python::object>::iterator iter;
-    for (iter = subscriberMap.begin(); iter != subscriberMap.end(); iter++) {
+    for (iter = subscribers.begin(); iter != subscribers.end(); iter++) {
         std::string subscriberName = iter->first;
         boost::python::object pySubscriber = iter->second;
+        logger.debug("Invoking subscriber: " + subscriberName);
+        std::vector<PvObject>::iterator pvObjectIter;
+        for (pvObjectIter = pvObjects.begin(); pvObjectIter != pvObjects.end(); pvObjectIter++) {
+            try {
+                // Call python code
+                pySubscriber(*pvObjectIter);
+            }
+            catch(const boost::python::error_already_set&) {
+                logger.error("Channel subscriber " + subscriberName + " error");
+                PyErr_Print();
+            }
+        }
+    }
 
-        // Acquire GIL. This is required because callSubscribers()
-        // is called in a monitoring thread. Before monitoring thread
-        // is created, one must call PyEval_InitThreads() in the main thread
-        // to initialize things properly. If this is not done, code will
-        // most likely crash while invoking python from c++, or while
-        // attempting to release GIL.
-        // PyGILState_STATE gilState = PyGILState_Ensure();
-        logger.trace("Acquiring python GIL for subscriber " + subscriberName);
-        PyGilManager::gilStateEnsure();
-
+    if (!batchSubscribers.empty()) {
+        // Python list must be created and released with GIL held
+        boost::python::list pyList;
         try {
-            logger.debug("Invoking subscriber: " + subscriberName);
-
-            // Call python code
-            pySubscriber(pvObject);
+            std::vector<PvObject>::iterator pvObjectIter;
+            for (pvObjectIter = pvObjects.begin(); pvObjectIter != pvObjects.end(); pvObjectIter++) {
+                pyList.append(*pvObjectIter);
+            }
         }
         catch(const boost::python::error_already_set&) {
-            logger.error("Channel subscriber " + subscriberName + " error");
+            logger.error("Cannot create PV object list for batch subscribers");
+            PyErr_Print();
+            batchSubscribers.clear();
+        }
+        for (iter = batchSubscribers.begin(); iter != batchSubscribers.end(); iter++) {
+            std::string subscriberName = iter->first;
+            boost::python::object pySubscriber = iter->second;
+            logger.debug("Invoking batch subscriber: " + subscriberName);
+            try {
+                pySubscriber(pyList);
+            }
+            catch(const boost::python::error_already_set&) {
+                logger.error("Channel batch subscriber " + subscriberName + " error");
+                PyErr_Print();
+            }
         }
-
-        // Release GIL. 
-        // PyGILState_Release(gilState);
-        logger.trace("Releasing python GIL");
-        PyGilManager::gilStateRelease();
     }
+
+    subscribers.clear();
+    batchSubscribers.clear();
+    logger.trace("Releasing python GIL");
+    PyGilManager::gilStateRelease(gilState);
     logger.trace("Done calling subscribers");
 }
 
@@ -337,6 +1141,10 @@ void Channel::startMonitor()
 
 void Channel::startMonitor(const std::string& requestDescriptor)
 {
+    {
+        PyGilRelease pyGilRelease;
+        ensureConnected();
+    }
     epics::pvData::Lock lock(monitorThreadMutex);
     if (monitorThreadDone) {
         monitorThreadDone = false;
@@ -346,17 +1154,41 @@ void Channel::startMonitor(const std::string& requestDescriptor)
         // of PyGILState_Ensure()/PyGILState_Release().
         // PyEval_InitThreads();
         PyGilManager::evalInitThreads();
+
+        // Lock-free queue is preallocated, so its slots are only
+        // allocated, if it is selected, while monitor is not running;
+        // it always drops newest updates on overflow
+        if (monitorQueueLockFree) {
+            pvObjectMonitorRingBuffer.setCapacity(getMonitorMaxQueueLength());
+            if (getMonitorMaxQueueLength() <= 0) {
+                logger.warn("Lock-free monitor queue for channel %s cannot be unlimited, its capacity is %d", getName().c_str(), pvObjectMonitorRingBuffer.getCapacity());
+            }
+            if (getMonitorOverflowPolicy() != QueueOverflowPolicy::DropNewest) {
+                logger.warn("Lock-free monitor queue for channel %s ignores overflow policy and drops newest updates", getName().c_str());
+            }
+        }
+        pvObjectMonitorQueue.resetStatistics();
+        pvObjectMonitorRingBuffer.resetStatistics();
+
+        // Pool must be able to hold all queued snapshots, as well as the
+        // batch being processed and the one being filled in
+        int maxQueueLength = getMonitorMaxQueueLength();
+        monitorSnapshotPool.setMaxSize(maxQueueLength > 0 ? maxQueueLength+monitorBatchSize+1 : MonitorSnapshotPool::DefaultMaxSize);
         try {
             pvaClientMonitorPtr = pvaClientChannelPtr->createMonitor(requestDescriptor);
+            monitorCollectorPtr = ChannelMonitorCollector::shared_pointer(new ChannelMonitorCollector(this));
+            pvaClientMonitorPtr->setRequester(monitorCollectorPtr);
             pvaClientMonitorPtr->connect();
             pvaClientMonitorPtr->start();
         } 
         catch (std::runtime_error e) {
             logger.error(e.what());
+            if (monitorCollectorPtr) {
+                monitorCollectorPtr->detach();
+            }
+            monitorThreadDone = true;
             throw PvaException(e.what());
         }
-        epicsThreadCreate("ChannelMonitorThread", epicsThreadPriorityLow, epicsThreadGetStackSize(epicsThreadStackSmall), (EPICSTHREADFUNC)monitorThread, this);
-        epicsThreadCreate("ChannelProcessingThread", epicsThreadPriorityHigh, epicsThreadGetStackSize(epicsThreadStackSmall), (EPICSTHREADFUNC)processingThread, this);
     }
 }
 
@@ -369,15 +1201,86 @@ void Channel::stopMonitor()
     }
     monitorThreadDone = true;
     logger.debug("Stopping monitor");
+
+    std::string error;
     try {
         pvaClientMonitorPtr->stop();
     } 
     catch (std::runtime_error e) {
         logger.error(e.what());
-        throw PvaException(e.what());
+        error = e.what();
+    }
+
+    // No data is queued after collector is detached, and channel cannot
+    // be destroyed while one of the monitor workers is processing it;
+    // worker may need GIL to complete subscriber calls
+    monitorCollectorPtr->detach();
+    pvObjectMonitorQueue.cancelWaitForItem();
+    pvObjectMonitorRingBuffer.cancelWaitForItem();
+    processingThreadExitEvent.tryWait();
+    if (ChannelMonitorDispatcher::cancel(this)) {
+        // Worker still uses this channel, so it must be waited for
+        // without timeout; channel may be destroyed after this returns
+        logger.debug("Monitor stopped, waiting for processing to complete");
+        PyGilRelease pyGilRelease;
+        processingThreadExitEvent.wait();
+    }
+    pvObjectMonitorQueue.clear();
+    pvObjectMonitorRingBuffer.clear();
+    monitorSnapshotPool.clear();
+    monitorBatchPvObjects.clear();
+    if (!error.empty()) {
+        throw PvaException(error);
+    }
+}
+
+void Channel::setMonitorQueueLockFree(bool lockFree)
+{
+    epics::pvData::Lock lock(monitorThreadMutex);
+    if (!monitorThreadDone) {
+        throw InvalidRequest("Monitor queue type cannot be changed while monitor is running");
     }
-    logger.debug("Monitor stopped, waiting for thread exit");
-    monitorThreadExitEvent.wait(getTimeout());
+    monitorQueueLockFree = lockFree;
+
+    // Lock-free queue slots are allocated when monitor starts
+    if (!lockFree) {
+        pvObjectMonitorRingBuffer.releaseSlots();
+    }
+}
+
+void Channel::setMonitorCopyOnChange(bool copyOnChange)
+{
+    epics::pvData::Lock lock(monitorThreadMutex);
+    if (!monitorThreadDone) {
+        throw InvalidRequest("Monitor copy mode cannot be changed while monitor is running");
+    }
+    monitorCopyOnChange = copyOnChange;
+}
+
+void Channel::setMonitorBatchSize(int batchSize)
+{
+    if (batchSize < 1) {
+        throw InvalidArgument("Monitor batch size must be positive.");
+    }
+    monitorBatchSize = batchSize;
+}
+
+void Channel::setMonitorBatchTime(double batchTime)
+{
+    if (batchTime < 0) {
+        throw InvalidArgument("Monitor batch time cannot be negative.");
+    }
+    monitorBatchTime = batchTime;
+}
+
+void Channel::setMonitorWorkerPoolSize(int workerPoolSize)
+{
+    ChannelMonitorDispatcher::setWorkerPoolSize(workerPoolSize);
+}
+
+int Channel::getMonitorWorkerPoolSize()
+{
+    return ChannelMonitorDispatcher::getWorkerPoolSize();
 }
 
 bool Channel::isMonitorThreadDone() const
@@ -385,70 +1288,125 @@ bool Channel::isMonitorThreadDone() const
     return monitorThreadDone;
 }
 
-bool Channel::processMonitorElement() 
+bool Channel::processMonitorElement(double& retryDelay)
 {
-    //epics::pvData::Lock lock(monitorElementProcessingMutex);
+    retryDelay = 0;
+    if (monitorThreadDone) {
+        return false;
+    }
 
-    // Handle possible exceptions while retrieving data from empty queue.
-    try {
-        try {
-            PvObject pvObject = pvObjectMonitorQueue.frontAndPop(timeout);
-            callSubscribers(pvObject);
+    // Monitor workers never wait for data that is not queued yet; batch
+    // that is neither full nor past its time budget is kept here, and
+    // dispatcher processes channel again when more data arrives or when
+    // time budget expires
+    int maxBatchSize = monitorBatchSize;
+    int nPreviousObjects = monitorBatchPvObjects.size();
+    if (nPreviousObjects < maxBatchSize) {
+        dequeueMonitorData(monitorBatchPvObjects, maxBatchSize-nPreviousObjects, 0);
+    }
+    int nObjects = monitorBatchPvObjects.size();
+    if (nObjects == 0) {
+        return false;
+    }
+    if (monitorBatchTime > 0 && nObjects < maxBatchSize) {
+        epicsTime currentTime = epicsTime::getCurrent();
+        if (nPreviousObjects == 0) {
+            monitorBatchStartTime = currentTime;
         }
-        catch (InvalidState& ex) {
-            throw ChannelTimeout("No PV changes received.");
+        double remainingTime = monitorBatchTime - (currentTime - monitorBatchStartTime);
+        if (remainingTime > 0) {
+            retryDelay = remainingTime;
+            return false;
         }
     }
-    catch (const ChannelTimeout& ex) {
-        // Ignore, no changes received.
+
+    std::vector<PvObject> pvObjects;
+    pvObjects.swap(monitorBatchPvObjects);
+    try {
+        callSubscribers(pvObjects);
     }
     catch (const std::exception& ex) {
         // Not good.
-        logger.error("Exception caught in monitor thread: %s", ex.what());
+        logger.error("Exception caught in monitor worker: %s", ex.what());
     }
-    return false;
+
+    // Full batch may have left more data in the queue
+    return (nObjects >= maxBatchSize);
 }
 
-void Channel::monitorThread(Channel* channel)
+int Channel::dequeueMonitorData(std::vector<PvObject>& pvObjects, int maxObjects, double timeout)
 {
-    logger.debug("Started monitor thread %s", epicsThreadGetNameSelf());
-    epics::pvaClient::PvaClientMonitorPtr monitor = channel->getMonitor();
-    epics::pvaClient::PvaClientMonitorDataPtr pvaData = monitor->getData();
-    while (true) {
-        if (channel->isMonitorThreadDone()) {
-            break;
+    if (monitorQueueLockFree) {
+        if (pvObjectMonitorRingBuffer.empty() && !pvObjectMonitorRingBuffer.waitForItem(timeout)) {
+            return 0;
         }
-
-        monitor->waitEvent();
-        PvObject pvObject(pvaData->getPVStructure());
-        channel->queueMonitorData(pvObject);
-        monitor->releaseEvent();
+        return pvObjectMonitorRingBuffer.popBatch(pvObjects, maxObjects);
+    }
+    int nObjects = pvObjectMonitorQueue.frontAndPopBatch(pvObjects, maxObjects);
+    if (nObjects == 0) {
+        pvObjectMonitorQueue.waitForItem(timeout);
+        nObjects = pvObjectMonitorQueue.frontAndPopBatch(pvObjects, maxObjects);
     }
-    logger.debug("Exiting monitor thread %s", epicsThreadGetNameSelf());
-    channel->notifyMonitorThreadExit();
+    if (nObjects > 0 && pvObjectMonitorQueue.resumeProducer()) {
+        // Collector stopped polling on full queue; updates held back
+        // by pvAccess are collected now that there is room for them
+        ChannelMonitorCollector::shared_pointer collector = monitorCollectorPtr;
+        epics::pvaClient::PvaClientMonitorPtr monitor = pvaClientMonitorPtr;
+        if (collector && monitor) {
+            collector->event(monitor);
+        }
+    }
+    return nObjects;
 }
 
-void Channel::processingThread(Channel* channel)
+void Channel::collectMonitorData(const epics::pvaClient::PvaClientMonitorPtr& monitor)
 {
-    logger.debug("Started processing thread %s", epicsThreadGetNameSelf());
-    epics::pvaClient::PvaClientMonitorPtr monitor = channel->getMonitor();
-    epics::pvaClient::PvaClientMonitorDataPtr pvaData = monitor->getData();
     while (true) {
-        if (channel->isMonitorThreadDone()) {
+        // Callback never waits for room in the queue; updates that are
+        // not polled stay in pvAccess, which applies its own flow control
+        if (!monitorQueueLockFree && !pvObjectMonitorQueue.checkProducerSpace()) {
+            break;
+        }
+        if (!monitor->poll()) {
             break;
         }
-        channel->processMonitorElement();
+        epics::pvaClient::PvaClientMonitorDataPtr pvaData = monitor->getData();
+
+        // Monitor data structure is overwritten by the next update, so
+        // queued objects always get their own snapshots; without
+        // copy-on-change, entire structure is copied into snapshot
+        epics::pvData::BitSet::shared_pointer copyBitSetPtr;
+        if (monitorCopyOnChange) {
+            copyBitSetPtr = pvaData->getChangedBitSet();
+        }
+        epics::pvData::PVStructurePtr pvStructurePtr = monitorSnapshotPool.createSnapshot(pvaData->getPVStructure(), copyBitSetPtr);
+        PvObject pvObject(pvStructurePtr);
+        pvObject.setChangedBitSet(pvaData->getChangedBitSet());
+        pvObject.setOverrunBitSet(pvaData->getOverrunBitSet());
+        queueMonitorData(pvObject);
+        monitor->releaseEvent();
+
+        // Channel is scheduled for each update, so that workers start
+        // processing while further updates are collected
+        ChannelMonitorDispatcher::schedule(this);
     }
-    logger.debug("Exiting processing thread %s", epicsThreadGetNameSelf());
 }
 
-epics::pvaClient::PvaClientMonitorPtr Channel::getMonitor() 
+boost::python::dict Channel::getMonitorStatistics()
 {
-    return pvaClientChannelPtr->monitor("");
+    if (monitorQueueLockFree) {
+        return pvObjectMonitorRingBuffer.getStatistics().toPyDict();
+    }
+    return pvObjectMonitorQueue.getStatistics().toPyDict();
 }
 
 void Channel::queueMonitorData(PvObject& pvObject) 
 {
-    pvObjectMonitorQueue.push(pvObject);
+    if (monitorQueueLockFree) {
+        pvObjectMonitorRingBuffer.push(pvObject);
+    }
+    else {
+        pvObjectMonitorQueue.push(pvObject);
+    }
 }
 
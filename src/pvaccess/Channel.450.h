@@ -8,19 +8,62 @@
 #include <vector>
 
 #include "boost/python/list.hpp"
+#include "boost/python/dict.hpp"
 #include "pv/pvaClient.h"
 
+#include "ChannelAsyncRequest.h"
 #include "ChannelGetRequesterImpl.h"
 #include "ChannelMonitorRequesterImpl.h"
 #include "ChannelRequesterImpl.h"
 #include "SynchronizedQueue.h"
+#include "SpscRingBuffer.h"
+#include "QueueOverflowPolicy.h"
+#include "MonitorSnapshotPool.h"
 #include "PvaClient.h"
 #include "CaClient.h"
 #include "epicsEvent.h"
+#include "epicsTime.h"
 #include "PvObject.h"
 #include "PvProvider.h"
 #include "PvaPyLogger.h"
 
+//
+// Get/put objects are cached per request descriptor. Object is removed
+// from cache while in use, so that concurrent requests on the same channel
+// never share it. Cache is shared with asynchronous requests, which return
+// objects to it on completion.
+//
+// Cached objects may be stale after reconnect, so they are tagged with the
+// channel connection generation, which changes with every channel state
+// change: cache is cleared when it is used with a generation other than
+// the one it was filled in, and objects acquired in a previous generation
+// are not cached again when released.
+//
+class PvaClientRequestCache
+{
+public:
+    POINTER_DEFINITIONS(PvaClientRequestCache);
+
+    PvaClientRequestCache();
+    epics::pvaClient::PvaClientGetPtr acquireGet(const std::string& requestDescriptor, int connectionGeneration);
+    void releaseGet(const std::string& requestDescriptor, const epics::pvaClient::PvaClientGetPtr& pvaGet, int connectionGeneration);
+    epics::pvaClient::PvaClientPutPtr acquirePut(const std::string& requestDescriptor, int connectionGeneration);
+    void releasePut(const std::string& requestDescriptor, const epics::pvaClient::PvaClientPutPtr& pvaPut, int connectionGeneration);
+
+private:
+    void checkConnectionGeneration(int connectionGeneration);
+
+    std::map<std::string, epics::pvaClient::PvaClientGetPtr> pvaClientGetMap;
+    std::map<std::string, epics::pvaClient::PvaClientPutPtr> pvaClientPutMap;
+    int connectionGeneration;
+    epics::pvData::Mutex mutex;
+};
+
+typedef PvaClientRequestCache::shared_pointer PvaClientRequestCachePtr;
+
+class ChannelMonitorCollector;
+class ChannelStateChangeRequester;
+
 class Channel
 {
 public:
@@ -28,11 +71,14 @@ public:
     static const char* DefaultRequestDescriptor;
     static const double DefaultTimeout;
         
-    Channel(const std::string& channelName, PvProvider::ProviderType providerType=PvProvider::PvaProviderType);
+    Channel(const std::string& channelName, PvProvider::ProviderType providerType=PvProvider::PvaProviderType, bool waitForConnection=true);
     Channel(const Channel& channel);
     virtual ~Channel();
 
     std::string getName() const;
+    virtual void issueConnect();
+    virtual void waitConnect(double timeout);
+    virtual bool isConnected();
     virtual PvObject* get(const std::string& requestDescriptor);
     virtual PvObject* get();
     virtual void put(const PvObject& pvObject, const std::string& requestDescriptor);
@@ -43,6 +89,8 @@ public:
     virtual void put(const std::string& value);
     virtual void put(const boost::python::list& pyList, const std::string& requestDescriptor);
     virtual void put(const boost::python::list& pyList);
+    virtual void put(const boost::python::object& pyObject, const std::string& requestDescriptor);
+    virtual void put(const boost::python::object& pyObject);
 
     virtual void put(bool value, const std::string& requestDescriptor);
     virtual void put(bool value);
@@ -67,9 +115,18 @@ public:
     virtual void put(double value, const std::string& requestDescriptor);
     virtual void put(double value);
 
+    virtual ChannelAsyncRequestPtr createAsyncGetRequest(const std::string& requestDescriptor);
+    virtual ChannelAsyncRequestPtr createAsyncPutRequest(const PvObject& pvObject, const std::string& requestDescriptor);
+    virtual void asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor);
+    virtual void asyncGet(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+    virtual void asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, const std::string& requestDescriptor);
+    virtual void asyncPut(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+    virtual void asyncConnect(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+
     virtual void subscribe(const std::string& subscriberName, const boost::python::object& pySubscriber);
+    virtual void subscribeBatch(const std::string& subscriberName, const boost::python::object& pySubscriber);
     virtual void unsubscribe(const std::string& subscriberName);
-    virtual void callSubscribers(PvObject& pvObject);
+    virtual void callSubscribers(std::vector<PvObject>& pvObjects);
     virtual void startMonitor(const std::string& requestDescriptor);
     virtual void startMonitor();
     virtual void stopMonitor();
@@ -78,34 +135,72 @@ public:
     virtual double getTimeout() const;
     virtual void setMonitorMaxQueueLength(int maxLength);
     virtual int getMonitorMaxQueueLength();
+    virtual void setMonitorOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy);
+    virtual QueueOverflowPolicy::PolicyType getMonitorOverflowPolicy();
+    virtual boost::python::dict getMonitorStatistics();
+    virtual void setMonitorQueueLockFree(bool lockFree);
+    virtual bool isMonitorQueueLockFree() const;
+    virtual void setMonitorCopyOnChange(bool copyOnChange);
+    virtual bool isMonitorCopyOnChange() const;
+    virtual void setMonitorBatchSize(int batchSize);
+    virtual int getMonitorBatchSize() const;
+    virtual void setMonitorBatchTime(double batchTime);
+    virtual double getMonitorBatchTime() const;
+
+    static void setMonitorWorkerPoolSize(int workerPoolSize);
+    static int getMonitorWorkerPoolSize();
 
 private:
-    static const double ShutdownWaitTime;
+    friend class ChannelMonitorCollector;
+    friend class ChannelMonitorDispatcher;
+
+    static const int DefaultMonitorBatchSize;
+
+    template<typename T>
+    void putScalar(T value, const std::string& requestDescriptor);
 
     static PvaPyLogger logger;
     static PvaClient pvaClient;
     static CaClient caClient;
-    static void monitorThread(Channel* channel);
-    static void processingThread(Channel* channel);
 
     void connect();
-    epics::pvaClient::PvaClientMonitorPtr getMonitor();
+    void waitUntilConnected(double timeout);
+    void ensureConnected();
+    int getConnectionGeneration();
+    epics::pvaClient::PvaClientGetPtr acquirePvaClientGet(const std::string& requestDescriptor, int& connectionGeneration);
+    void releasePvaClientGet(const std::string& requestDescriptor, const epics::pvaClient::PvaClientGetPtr& pvaGet, int connectionGeneration);
+    epics::pvaClient::PvaClientPutPtr acquirePvaClientPut(const std::string& requestDescriptor, int& connectionGeneration);
+    void releasePvaClientPut(const std::string& requestDescriptor, const epics::pvaClient::PvaClientPutPtr& pvaPut, int connectionGeneration);
+    void collectMonitorData(const epics::pvaClient::PvaClientMonitorPtr& monitor);
     void queueMonitorData(PvObject& pvObject);
 
-    bool processMonitorElement();
-    void notifyMonitorThreadExit();
+    bool processMonitorElement(double& retryDelay);
+    int dequeueMonitorData(std::vector<PvObject>& pvObjects, int maxObjects, double timeout);
+    void notifyProcessingThreadExit();
 
     static epics::pvaClient::PvaClientPtr pvaClientPtr;
     epics::pvaClient::PvaClientChannelPtr  pvaClientChannelPtr;
+    std::tr1::shared_ptr<ChannelStateChangeRequester> stateChangeRequesterPtr;
     epics::pvaClient::PvaClientMonitorPtr pvaClientMonitorPtr;
+    std::tr1::shared_ptr<ChannelMonitorCollector> monitorCollectorPtr;
+    PvaClientRequestCachePtr requestCache;
     SynchronizedQueue<PvObject> pvObjectMonitorQueue;
+    SpscRingBuffer<PvObject> pvObjectMonitorRingBuffer;
+    bool monitorQueueLockFree;
+    bool monitorCopyOnChange;
+    MonitorSnapshotPool monitorSnapshotPool;
 
     bool monitorThreadDone;
     std::map<std::string, boost::python::object> subscriberMap;
+    std::map<std::string, boost::python::object> batchSubscriberMap;
+    int monitorBatchSize;
+    double monitorBatchTime;
+    std::vector<PvObject> monitorBatchPvObjects;
+    epicsTime monitorBatchStartTime;
     epics::pvData::Mutex subscriberMutex;
     epics::pvData::Mutex monitorElementProcessingMutex;
     epics::pvData::Mutex monitorThreadMutex;
-    epicsEvent monitorThreadExitEvent;
+    epicsEvent processingThreadExitEvent;
     double timeout;
 };
 
@@ -134,9 +229,39 @@ inline int Channel::getMonitorMaxQueueLength()
     return pvObjectMonitorQueue.getMaxLength();
 }
 
-inline void Channel::notifyMonitorThreadExit() 
+inline void Channel::setMonitorOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy) 
+{
+    pvObjectMonitorQueue.setOverflowPolicy(overflowPolicy);
+}
+
+inline QueueOverflowPolicy::PolicyType Channel::getMonitorOverflowPolicy() 
+{
+    return pvObjectMonitorQueue.getOverflowPolicy();
+}
+
+inline void Channel::notifyProcessingThreadExit() 
+{
+    processingThreadExitEvent.signal();
+}
+
+inline bool Channel::isMonitorQueueLockFree() const
+{
+    return monitorQueueLockFree;
+}
+
+inline bool Channel::isMonitorCopyOnChange() const
+{
+    return monitorCopyOnChange;
+}
+
+inline int Channel::getMonitorBatchSize() const
+{
+    return monitorBatchSize;
+}
+
+inline double Channel::getMonitorBatchTime() const
 {
-    monitorThreadExitEvent.signal();
+    return monitorBatchTime;
 }
 
 #endif
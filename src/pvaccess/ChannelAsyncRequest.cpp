@@ -0,0 +1,235 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include <algorithm>
+
+#include "ChannelAsyncRequest.h"
+#include "epicsThread.h"
+#include "PvObject.h"
+#include "PyGilManager.h"
+
+const double ChannelAsyncRequest::MinWaitTime(0.001);
+
+PvaPyLogger ChannelAsyncRequest::logger("ChannelAsyncRequest");
+SynchronizedQueue<ChannelAsyncRequestPtr> ChannelAsyncRequest::requestQueue;
+SynchronizedQueue<ChannelAsyncRequestPtr> ChannelAsyncRequest::callbackQueue;
+epicsEvent ChannelAsyncRequest::dispatcherEvent;
+epics::pvData::Mutex ChannelAsyncRequest::dispatcherMutex;
+bool ChannelAsyncRequest::dispatcherThreadStarted(false);
+
+ChannelAsyncRequest::ChannelAsyncRequest(const std::string& channelName_, double timeout_) :
+    channelName(channelName_),
+    timeout(timeout_),
+    creationTime(epicsTime::getCurrent()),
+    result(),
+    error(),
+    pyCallback(),
+    pyErrorCallback()
+{
+}
+
+ChannelAsyncRequest::~ChannelAsyncRequest()
+{
+}
+
+void ChannelAsyncRequest::tryIssue()
+{
+}
+
+void ChannelAsyncRequest::issue()
+{
+}
+
+bool ChannelAsyncRequest::isDone()
+{
+    return true;
+}
+
+double ChannelAsyncRequest::getRemainingTimeout() const
+{
+    double elapsedTime = epicsTime::getCurrent() - creationTime;
+    return std::max(timeout - elapsedTime, MinWaitTime);
+}
+
+void ChannelAsyncRequest::setCallbacks(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback)
+{
+    this->pyCallback = pyCallback;
+    this->pyErrorCallback = pyErrorCallback;
+}
+
+void ChannelAsyncRequest::dispatch(const ChannelAsyncRequestPtr& request)
+{
+    startDispatcherThread();
+    requestQueue.push(request);
+    notifyDispatcher();
+}
+
+void ChannelAsyncRequest::notifyDispatcher()
+{
+    dispatcherEvent.signal();
+}
+
+void ChannelAsyncRequest::startDispatcherThread()
+{
+    epics::pvData::Lock lock(dispatcherMutex);
+    if (dispatcherThreadStarted) {
+        return;
+    }
+
+    // Callbacks acquire GIL from the callback thread, so python
+    // thread state must be initialized in the calling (python) thread.
+    PyGilManager::evalInitThreads();
+    epicsThreadCreate("ChannelAsyncDispatcherThread", epicsThreadPriorityLow, epicsThreadGetStackSize(epicsThreadStackSmall), (EPICSTHREADFUNC)dispatcherThread, NULL);
+    epicsThreadCreate("ChannelAsyncCallbackThread", epicsThreadPriorityLow, epicsThreadGetStackSize(epicsThreadStackMedium), (EPICSTHREADFUNC)callbackThread, NULL);
+    dispatcherThreadStarted = true;
+}
+
+void ChannelAsyncRequest::dispatcherThread(void*)
+{
+    logger.debug("Started dispatcher thread %s", epicsThreadGetNameSelf());
+    std::vector<ChannelAsyncRequestPtr> requests;
+    while (true) {
+        requestQueue.frontAndPopAll(requests);
+        double waitTime = processRequests(requests);
+        if (requests.empty()) {
+            dispatcherEvent.wait();
+        }
+        else {
+            dispatcherEvent.wait(waitTime);
+        }
+    }
+}
+
+void ChannelAsyncRequest::callbackThread(void*)
+{
+    logger.debug("Started callback thread %s", epicsThreadGetNameSelf());
+    std::vector<ChannelAsyncRequestPtr> requests;
+    while (true) {
+        callbackQueue.waitForItem();
+        callbackQueue.frontAndPopAll(requests);
+        std::vector<ChannelAsyncRequestPtr>::iterator iter;
+        for (iter = requests.begin(); iter != requests.end(); iter++) {
+            (*iter)->invokeCallback();
+        }
+        requests.clear();
+    }
+}
+
+void ChannelAsyncRequest::issueRequests(const std::vector<ChannelAsyncRequestPtr>& requests)
+{
+    std::vector<ChannelAsyncRequestPtr>::const_iterator iter;
+    for (iter = requests.begin(); iter != requests.end(); iter++) {
+        ChannelAsyncRequestPtr request = *iter;
+        try {
+            request->tryIssue();
+        }
+        catch (const std::exception& ex) {
+            request->error = ex.what();
+        }
+    }
+    for (iter = requests.begin(); iter != requests.end(); iter++) {
+        ChannelAsyncRequestPtr request = *iter;
+        if (!request->error.empty()) {
+            continue;
+        }
+        try {
+            request->issue();
+        }
+        catch (const std::exception& ex) {
+            request->error = ex.what();
+        }
+    }
+}
+
+void ChannelAsyncRequest::complete()
+{
+    if (!error.empty()) {
+        return;
+    }
+    try {
+        issue();
+        result = waitForCompletion();
+    }
+    catch (const std::exception& ex) {
+        error = ex.what();
+        if (error.empty()) {
+            error = "Channel " + channelName + " request failed";
+        }
+    }
+}
+
+// Completes requests that are done, failed or timed out, and hands them
+// over to the callback thread; returns time until the earliest timeout
+// of the remaining requests expires. Requests that are about to be
+// completed are all issued before waiting for any of them.
+double ChannelAsyncRequest::processRequests(std::vector<ChannelAsyncRequestPtr>& requests)
+{
+    logger.trace("Processing %d requests", int(requests.size()));
+    double waitTime = 0;
+    std::vector<ChannelAsyncRequestPtr> completedRequests;
+    std::vector<ChannelAsyncRequestPtr>::iterator iter = requests.begin();
+    while (iter != requests.end()) {
+        ChannelAsyncRequestPtr request = *iter;
+        if (request->error.empty()) {
+            try {
+                request->tryIssue();
+            }
+            catch (const std::exception& ex) {
+                request->error = ex.what();
+            }
+        }
+        double remainingTimeout = request->getRemainingTimeout();
+        if (!request->error.empty() || request->isDone() || remainingTimeout <= MinWaitTime) {
+            completedRequests.push_back(request);
+            iter = requests.erase(iter);
+            continue;
+        }
+        if (waitTime == 0 || remainingTimeout < waitTime) {
+            waitTime = remainingTimeout;
+        }
+        iter++;
+    }
+
+    issueRequests(completedRequests);
+    for (iter = completedRequests.begin(); iter != completedRequests.end(); iter++) {
+        (*iter)->complete();
+        callbackQueue.push(*iter);
+    }
+    return waitTime;
+}
+
+void ChannelAsyncRequest::invokeCallback()
+{
+    logger.trace("Acquiring python GIL for channel %s callback", channelName.c_str());
+    PyGILState_STATE gilState = PyGilManager::gilStateEnsure();
+    try {
+        if (!error.empty()) {
+            if (pyErrorCallback.ptr() != Py_None) {
+                pyErrorCallback(error);
+            }
+            else {
+                logger.error("Channel %s request failed: %s", channelName.c_str(), error.c_str());
+            }
+        }
+        else if (pyCallback.ptr() != Py_None) {
+            if (result) {
+                PvObject pvObject(result);
+                pyCallback(pvObject);
+            }
+            else {
+                pyCallback();
+            }
+        }
+    }
+    catch (const boost::python::error_already_set&) {
+        logger.error("Channel %s callback error", channelName.c_str());
+        PyErr_Print();
+    }
+
+    // Callback objects must be released with GIL held; request may
+    // be destroyed by dispatcher thread after this returns
+    pyCallback = boost::python::object();
+    pyErrorCallback = boost::python::object();
+    logger.trace("Releasing python GIL");
+    PyGilManager::gilStateRelease(gilState);
+}
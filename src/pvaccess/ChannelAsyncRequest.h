@@ -0,0 +1,129 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef CHANNEL_ASYNC_REQUEST_H
+#define CHANNEL_ASYNC_REQUEST_H
+
+#include <string>
+#include <vector>
+#include "boost/python/object.hpp"
+#include "pv/pvData.h"
+#include "epicsEvent.h"
+#include "epicsTime.h"
+#include "SynchronizedQueue.h"
+#include "PvaPyLogger.h"
+
+//
+// Base class for channel get/put requests that complete asynchronously.
+//
+// Request is issued without waiting for the server. Completion is handled
+// in a single process-wide dispatcher thread, which never waits for any
+// particular request: it advances all pending requests as far as they go
+// without waiting, completes those that are done or have timed out, and
+// sleeps until requester callbacks report progress, a new request arrives,
+// or the earliest timeout expires. Python callbacks are invoked from a
+// separate callback thread with the GIL acquired, in order of completion.
+//
+class ChannelAsyncRequest
+{
+public:
+    POINTER_DEFINITIONS(ChannelAsyncRequest);
+
+    ChannelAsyncRequest(const std::string& channelName, double timeout);
+    virtual ~ChannelAsyncRequest();
+
+    std::string getChannelName() const;
+    double getTimeout() const;
+
+    // Advances request setup as far as possible without waiting (e.g.,
+    // connects request once channel is connected, and issues it once it
+    // is connected). Called again whenever requests may have progressed.
+    virtual void tryIssue();
+
+    // Completes request setup (e.g., waits for connection) and issues
+    // request, unless this was already done.
+    virtual void issue();
+
+    // Returns true if request was issued and waitForCompletion() will
+    // return without waiting. Requests that cannot tell are completed
+    // as soon as dispatcher gets to them; requests completed together
+    // are all issued before any of them is waited for.
+    virtual bool isDone();
+
+    // Waits for request to complete. Get requests return result structure,
+    // put requests return null pointer. Failures are reported by throwing
+    // exception.
+    virtual epics::pvData::PVStructurePtr waitForCompletion() = 0;
+
+    // Starts setup of all requests before waiting for any of them, and
+    // then issues them one by one; after complete(), request outcome is
+    // available via getResult() and getError(). Must be called without
+    // holding GIL.
+    static void issueRequests(const std::vector<shared_pointer>& requests);
+    void complete();
+    epics::pvData::PVStructurePtr getResult() const;
+    std::string getError() const;
+
+    // Callbacks must be set with GIL held.
+    void setCallbacks(const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback);
+
+    // Queues request for completion processing in the dispatcher thread.
+    static void dispatch(const shared_pointer& request);
+
+    // Wakes up dispatcher thread; called from requester and channel
+    // callbacks whenever pending requests may have progressed.
+    static void notifyDispatcher();
+
+protected:
+    // Time left until request timeout expires, measured from request
+    // creation, so that requests created together wait in parallel.
+    double getRemainingTimeout() const;
+
+private:
+    static const double MinWaitTime;
+    static PvaPyLogger logger;
+    static SynchronizedQueue<shared_pointer> requestQueue;
+    static SynchronizedQueue<shared_pointer> callbackQueue;
+    static epicsEvent dispatcherEvent;
+    static epics::pvData::Mutex dispatcherMutex;
+    static bool dispatcherThreadStarted;
+
+    static void startDispatcherThread();
+    static void dispatcherThread(void*);
+    static void callbackThread(void*);
+    static double processRequests(std::vector<shared_pointer>& requests);
+
+    void invokeCallback();
+
+    std::string channelName;
+    double timeout;
+    epicsTime creationTime;
+    epics::pvData::PVStructurePtr result;
+    std::string error;
+    boost::python::object pyCallback;
+    boost::python::object pyErrorCallback;
+};
+
+typedef ChannelAsyncRequest::shared_pointer ChannelAsyncRequestPtr;
+
+inline std::string ChannelAsyncRequest::getChannelName() const
+{
+    return channelName;
+}
+
+inline double ChannelAsyncRequest::getTimeout() const
+{
+    return timeout;
+}
+
+inline epics::pvData::PVStructurePtr ChannelAsyncRequest::getResult() const
+{
+    return result;
+}
+
+inline std::string ChannelAsyncRequest::getError() const
+{
+    return error;
+}
+
+#endif
@@ -50,7 +50,7 @@ void ChannelGetRequesterImpl::channelGetConnect(const epics::pvData::Status& sta
     }
     else {
         std::cerr << "[" << channelName << "] failed to create channel get: " << status.getMessage() << std::endl;
-        event.signal();
+        signalCompletion();
     }
 }
 
@@ -76,6 +76,11 @@ void ChannelGetRequesterImpl::getDone(const epics::pvData::Status& status,
         std::cerr << "[" << channelName << "] failed to get: " << status.getMessage() << std::endl;
     }
 
+    signalCompletion();
+}
+
+void ChannelGetRequesterImpl::signalCompletion()
+{
     event.signal();
 }
 
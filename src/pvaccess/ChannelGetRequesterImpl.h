@@ -30,6 +30,10 @@ public:
     bool waitUntilGet(double timeOut);
     std::string getChannelName() const;
 
+protected:
+    // Wakes up caller waiting for request completion or failure
+    virtual void signalCompletion();
+
 private:
     static PvaClient pvaClient;
 
@@ -0,0 +1,196 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include <algorithm>
+
+#include "ChannelGroup.h"
+#include "epicsTime.h"
+#include "ChannelTimeout.h"
+#include "ObjectNotFound.h"
+#include "PyGilRelease.h"
+#include "PyUtility.h"
+
+const double ChannelGroup::MinWaitTime(0.001);
+
+PvaPyLogger ChannelGroup::logger("ChannelGroup");
+
+ChannelGroup::ChannelGroup(const boost::python::list& pyChannelNames, PvProvider::ProviderType providerType) :
+    channelNames(),
+    channelMap(),
+    statusMap(),
+    timeout(Channel::DefaultTimeout)
+{
+    int nChannels = boost::python::len(pyChannelNames);
+    for (int i = 0; i < nChannels; i++) {
+        std::string channelName = PyUtility::extractValueFromPyObject<std::string>(pyChannelNames[i]);
+        if (channelMap.find(channelName) != channelMap.end()) {
+            continue;
+        }
+
+        // Channel only initiates connection here; all channels are
+        // waited for afterwards
+        channelNames.push_back(channelName);
+        channelMap[channelName] = ChannelPtr(new Channel(channelName, providerType, false));
+        statusMap[channelName] = "";
+    }
+    connect();
+}
+
+ChannelGroup::~ChannelGroup()
+{
+}
+
+boost::python::list ChannelGroup::getChannelNames() const
+{
+    boost::python::list pyList;
+    std::vector<std::string>::const_iterator iter;
+    for (iter = channelNames.begin(); iter != channelNames.end(); iter++) {
+        pyList.append(*iter);
+    }
+    return pyList;
+}
+
+boost::python::dict ChannelGroup::getStatus() const
+{
+    boost::python::dict pyDict;
+    std::map<std::string, std::string>::const_iterator iter;
+    for (iter = statusMap.begin(); iter != statusMap.end(); iter++) {
+        pyDict[iter->first] = iter->second;
+    }
+    return pyDict;
+}
+
+void ChannelGroup::connect()
+{
+    // Channels connect in parallel, so each wait is limited to the
+    // time remaining until the overall timeout expires
+    epicsTime startTime = epicsTime::getCurrent();
+    std::vector<std::string>::const_iterator iter;
+    for (iter = channelNames.begin(); iter != channelNames.end(); iter++) {
+        const std::string& channelName = *iter;
+        ChannelPtr channel = channelMap[channelName];
+        if (channel->isConnected()) {
+            statusMap[channelName] = "";
+            continue;
+        }
+        double waitTime = std::max(timeout - (epicsTime::getCurrent() - startTime), MinWaitTime);
+        try {
+            channel->waitConnect(waitTime);
+            statusMap[channelName] = "";
+        }
+        catch (const ChannelTimeout& ex) {
+            logger.debug("Channel %s is not connected", channelName.c_str());
+            statusMap[channelName] = ex.what();
+        }
+    }
+}
+
+ChannelGroup::ChannelPtr ChannelGroup::getChannel(const std::string& channelName)
+{
+    std::map<std::string, ChannelPtr>::iterator iter = channelMap.find(channelName);
+    if (iter == channelMap.end()) {
+        throw ObjectNotFound("Channel " + channelName + " is not a member of channel group.");
+    }
+    return iter->second;
+}
+
+bool ChannelGroup::checkConnected(const std::string& channelName, const ChannelPtr& channel)
+{
+    if (channel->isConnected()) {
+        return true;
+    }
+    statusMap[channelName] = "Channel " + channelName + " is not connected";
+    return false;
+}
+
+boost::python::dict ChannelGroup::get()
+{
+    return get(Channel::DefaultRequestDescriptor);
+}
+
+boost::python::dict ChannelGroup::get(const std::string& requestDescriptor)
+{
+    std::vector<std::string> requestChannelNames;
+    std::vector<ChannelAsyncRequestPtr> requests;
+    std::vector<std::string>::const_iterator iter;
+    for (iter = channelNames.begin(); iter != channelNames.end(); iter++) {
+        const std::string& channelName = *iter;
+        ChannelPtr channel = channelMap[channelName];
+        if (!checkConnected(channelName, channel)) {
+            continue;
+        }
+        try {
+            requests.push_back(channel->createAsyncGetRequest(requestDescriptor));
+            requestChannelNames.push_back(channelName);
+        }
+        catch (const std::exception& ex) {
+            statusMap[channelName] = ex.what();
+        }
+    }
+
+    boost::python::dict pyDict;
+    completeRequests(requestChannelNames, requests, pyDict);
+    return pyDict;
+}
+
+void ChannelGroup::put(const boost::python::dict& pyDict)
+{
+    put(pyDict, Channel::DefaultRequestDescriptor);
+}
+
+void ChannelGroup::put(const boost::python::dict& pyDict, const std::string& requestDescriptor)
+{
+    // Make sure all channels are group members before issuing any request
+    boost::python::list pyChannelNames = pyDict.keys();
+    int nChannels = boost::python::len(pyChannelNames);
+    std::vector<std::string> putChannelNames;
+    for (int i = 0; i < nChannels; i++) {
+        std::string channelName = PyUtility::extractValueFromPyObject<std::string>(pyChannelNames[i]);
+        getChannel(channelName);
+        putChannelNames.push_back(channelName);
+    }
+
+    std::vector<std::string> requestChannelNames;
+    std::vector<ChannelAsyncRequestPtr> requests;
+    std::vector<std::string>::const_iterator iter;
+    for (iter = putChannelNames.begin(); iter != putChannelNames.end(); iter++) {
+        const std::string& channelName = *iter;
+        ChannelPtr channel = getChannel(channelName);
+        PvObject pvObject = PyUtility::extractValueFromPyObject<PvObject>(pyDict[channelName]);
+        if (!checkConnected(channelName, channel)) {
+            continue;
+        }
+        try {
+            requests.push_back(channel->createAsyncPutRequest(pvObject, requestDescriptor));
+            requestChannelNames.push_back(channelName);
+        }
+        catch (const std::exception& ex) {
+            statusMap[channelName] = ex.what();
+        }
+    }
+
+    boost::python::dict pyResultDict;
+    completeRequests(requestChannelNames, requests, pyResultDict);
+}
+
+void ChannelGroup::completeRequests(const std::vector<std::string>& requestChannelNames, const std::vector<ChannelAsyncRequestPtr>& requests, boost::python::dict& pyDict)
+{
+    {
+        PyGilRelease pyGilRelease;
+        ChannelAsyncRequest::issueRequests(requests);
+        std::vector<ChannelAsyncRequestPtr>::const_iterator iter;
+        for (iter = requests.begin(); iter != requests.end(); iter++) {
+            (*iter)->complete();
+        }
+    }
+
+    for (unsigned int i = 0; i < requests.size(); i++) {
+        const std::string& channelName = requestChannelNames[i];
+        std::string error = requests[i]->getError();
+        statusMap[channelName] = error;
+        epics::pvData::PVStructurePtr pvStructurePtr = requests[i]->getResult();
+        if (error.empty() && pvStructurePtr) {
+            pyDict[channelName] = PvObject(pvStructurePtr);
+        }
+    }
+}
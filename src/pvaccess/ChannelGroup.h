@@ -0,0 +1,67 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef CHANNEL_GROUP_H
+#define CHANNEL_GROUP_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "boost/python/list.hpp"
+#include "boost/python/dict.hpp"
+
+#include "Channel.h"
+#include "PvProvider.h"
+#include "PvaPyLogger.h"
+
+//
+// Group of channels that are connected, read and written together. All
+// connections and requests are issued before waiting for any of them, so
+// group operation takes roughly a single network round trip regardless of
+// the number of channels.
+//
+class ChannelGroup
+{
+public:
+    static const double MinWaitTime;
+
+    ChannelGroup(const boost::python::list& pyChannelNames, PvProvider::ProviderType providerType=PvProvider::PvaProviderType);
+    virtual ~ChannelGroup();
+
+    virtual boost::python::list getChannelNames() const;
+    virtual boost::python::dict get(const std::string& requestDescriptor);
+    virtual boost::python::dict get();
+    virtual void put(const boost::python::dict& pyDict, const std::string& requestDescriptor);
+    virtual void put(const boost::python::dict& pyDict);
+    virtual boost::python::dict getStatus() const;
+    virtual void connect();
+    virtual void setTimeout(double timeout);
+    virtual double getTimeout() const;
+
+private:
+    typedef std::tr1::shared_ptr<Channel> ChannelPtr;
+
+    static PvaPyLogger logger;
+
+    ChannelPtr getChannel(const std::string& channelName);
+    bool checkConnected(const std::string& channelName, const ChannelPtr& channel);
+    void completeRequests(const std::vector<std::string>& requestChannelNames, const std::vector<ChannelAsyncRequestPtr>& requests, boost::python::dict& pyDict);
+
+    std::vector<std::string> channelNames;
+    std::map<std::string, ChannelPtr> channelMap;
+    std::map<std::string, std::string> statusMap;
+    double timeout;
+};
+
+inline void ChannelGroup::setTimeout(double timeout)
+{
+    this->timeout = timeout;
+}
+
+inline double ChannelGroup::getTimeout() const
+{
+    return timeout;
+}
+
+#endif
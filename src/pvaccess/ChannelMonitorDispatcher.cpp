@@ -0,0 +1,198 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include <algorithm>
+
+#include "ChannelMonitorDispatcher.h"
+#include "Channel.h"
+
+const int ChannelMonitorDispatcher::DefaultWorkerPoolSize(4);
+
+PvaPyLogger ChannelMonitorDispatcher::logger("ChannelMonitorDispatcher");
+epics::pvData::Mutex ChannelMonitorDispatcher::mutex;
+epicsEvent ChannelMonitorDispatcher::readyEvent;
+std::deque<Channel*> ChannelMonitorDispatcher::readyChannels;
+std::set<Channel*> ChannelMonitorDispatcher::scheduledChannels;
+std::map<Channel*, epicsThreadId> ChannelMonitorDispatcher::runningChannels;
+std::map<Channel*, bool> ChannelMonitorDispatcher::cancelledChannels;
+std::map<Channel*, epicsTime> ChannelMonitorDispatcher::delayedChannels;
+int ChannelMonitorDispatcher::workerPoolSize(DefaultWorkerPoolSize);
+int ChannelMonitorDispatcher::nWorkers(0);
+
+void ChannelMonitorDispatcher::setWorkerPoolSize(int workerPoolSize)
+{
+    if (workerPoolSize < 1) {
+        workerPoolSize = DefaultWorkerPoolSize;
+    }
+    epics::pvData::Lock lock(mutex);
+    ChannelMonitorDispatcher::workerPoolSize = workerPoolSize;
+    if (nWorkers > 0) {
+        // Add missing workers right away; surplus workers exit when
+        // they wake up
+        startWorkers();
+        readyEvent.signal();
+    }
+}
+
+int ChannelMonitorDispatcher::getWorkerPoolSize()
+{
+    epics::pvData::Lock lock(mutex);
+    return workerPoolSize;
+}
+
+// Must be called with mutex held
+void ChannelMonitorDispatcher::startWorkers()
+{
+    while (nWorkers < workerPoolSize) {
+        epicsThreadCreate("ChannelMonitorWorkerThread", epicsThreadPriorityHigh, epicsThreadGetStackSize(epicsThreadStackSmall), (EPICSTHREADFUNC)workerThread, NULL);
+        nWorkers++;
+    }
+}
+
+void ChannelMonitorDispatcher::schedule(Channel* channel)
+{
+    epics::pvData::Lock lock(mutex);
+    startWorkers();
+    delayedChannels.erase(channel);
+    if (scheduledChannels.find(channel) != scheduledChannels.end()) {
+        return;
+    }
+    scheduledChannels.insert(channel);
+
+    // Running channel is queued again by its worker
+    if (runningChannels.find(channel) == runningChannels.end()) {
+        readyChannels.push_back(channel);
+        readyEvent.signal();
+    }
+}
+
+bool ChannelMonitorDispatcher::cancel(Channel* channel)
+{
+    epics::pvData::Lock lock(mutex);
+    delayedChannels.erase(channel);
+    if (scheduledChannels.erase(channel) > 0) {
+        readyChannels.erase(std::remove(readyChannels.begin(), readyChannels.end(), channel), readyChannels.end());
+    }
+    std::map<Channel*, epicsThreadId>::const_iterator iter = runningChannels.find(channel);
+    if (iter == runningChannels.end()) {
+        return false;
+    }
+
+    // Worker that calls subscriber which cancels channel must not be
+    // waited for, but it must not schedule channel again either
+    bool notify = (iter->second != epicsThreadGetIdSelf());
+    cancelledChannels[channel] = notify;
+    return notify;
+}
+
+// Must be called with mutex held; returns time until the next delayed
+// channel is due, or negative value if there are no delayed channels
+double ChannelMonitorDispatcher::scheduleDelayedChannels()
+{
+    double waitTime = -1;
+    epicsTime currentTime = epicsTime::getCurrent();
+    std::map<Channel*, epicsTime>::iterator iter = delayedChannels.begin();
+    while (iter != delayedChannels.end()) {
+        double remainingTime = iter->second - currentTime;
+        if (remainingTime > 0) {
+            if (waitTime < 0 || remainingTime < waitTime) {
+                waitTime = remainingTime;
+            }
+            ++iter;
+            continue;
+        }
+        Channel* channel = iter->first;
+        delayedChannels.erase(iter++);
+        if (scheduledChannels.find(channel) == scheduledChannels.end()) {
+            scheduledChannels.insert(channel);
+            readyChannels.push_back(channel);
+        }
+    }
+    return waitTime;
+}
+
+Channel* ChannelMonitorDispatcher::waitForChannel()
+{
+    while (true) {
+        double waitTime = -1;
+        {
+            epics::pvData::Lock lock(mutex);
+            waitTime = scheduleDelayedChannels();
+            if (nWorkers > workerPoolSize) {
+                nWorkers--;
+                // Wake up other workers, which may also need to exit
+                readyEvent.signal();
+                return NULL;
+            }
+            if (!readyChannels.empty()) {
+                Channel* channel = readyChannels.front();
+                readyChannels.pop_front();
+                scheduledChannels.erase(channel);
+                runningChannels[channel] = epicsThreadGetIdSelf();
+
+                // Event is binary, so the next waiting worker is woken
+                // up here if there is more work, or if it needs to
+                // keep track of delayed channels instead of this one
+                if (!readyChannels.empty() || !delayedChannels.empty()) {
+                    readyEvent.signal();
+                }
+                return channel;
+            }
+        }
+        if (waitTime < 0) {
+            readyEvent.wait();
+        }
+        else {
+            readyEvent.wait(waitTime);
+        }
+    }
+}
+
+void ChannelMonitorDispatcher::completeChannel(Channel* channel, bool moreData, double retryDelay)
+{
+    bool notify = false;
+    {
+        epics::pvData::Lock lock(mutex);
+        runningChannels.erase(channel);
+        std::map<Channel*, bool>::iterator iter = cancelledChannels.find(channel);
+        if (iter != cancelledChannels.end()) {
+            notify = iter->second;
+            cancelledChannels.erase(iter);
+        }
+        else {
+            if (moreData) {
+                scheduledChannels.insert(channel);
+            }
+            if (scheduledChannels.find(channel) != scheduledChannels.end()) {
+                readyChannels.push_back(channel);
+                readyEvent.signal();
+            }
+            else if (retryDelay > 0) {
+                // Waiting worker must recompute its wait time
+                delayedChannels[channel] = epicsTime::getCurrent() + retryDelay;
+                readyEvent.signal();
+            }
+        }
+    }
+
+    // Channel that cancelled processing waits for this notification,
+    // and may be destroyed right after it
+    if (notify) {
+        channel->notifyProcessingThreadExit();
+    }
+}
+
+void ChannelMonitorDispatcher::workerThread(void*)
+{
+    logger.debug("Started monitor worker thread %s", epicsThreadGetNameSelf());
+    while (true) {
+        Channel* channel = waitForChannel();
+        if (!channel) {
+            break;
+        }
+        double retryDelay = 0;
+        bool moreData = channel->processMonitorElement(retryDelay);
+        completeChannel(channel, moreData, retryDelay);
+    }
+    logger.debug("Exiting monitor worker thread %s", epicsThreadGetNameSelf());
+}
@@ -0,0 +1,69 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef CHANNEL_MONITOR_DISPATCHER_H
+#define CHANNEL_MONITOR_DISPATCHER_H
+
+#include <deque>
+#include <map>
+#include <set>
+#include "pv/pvData.h"
+#include "epicsEvent.h"
+#include "epicsThread.h"
+#include "epicsTime.h"
+#include "PvaPyLogger.h"
+
+class Channel;
+
+//
+// Process-wide pool of worker threads that deliver queued monitor data
+// to channel subscribers.
+//
+// Monitor data is collected in pvAccess callbacks, which queue it and
+// schedule the channel here. Each worker takes the next scheduled channel
+// and processes one batch of its queue. Channel is never processed by more
+// than one worker at a time, so that updates are delivered in order; if it
+// is scheduled again while being processed, it is put back at the end of
+// the queue once the worker is done with it.
+//
+// Workers never wait for monitor data: channel that collects a batch of
+// updates over time is put aside until its batch time expires, unless
+// more data arrives for it earlier.
+//
+class ChannelMonitorDispatcher
+{
+public:
+    static const int DefaultWorkerPoolSize;
+
+    static void setWorkerPoolSize(int workerPoolSize);
+    static int getWorkerPoolSize();
+
+    // Schedules channel for processing; called after monitor data is queued.
+    static void schedule(Channel* channel);
+
+    // Removes channel from schedule. Returns true if channel is currently
+    // being processed by another thread, in which case processing worker
+    // notifies channel via notifyProcessingThreadExit() when it is done.
+    // Channel cancelled from its own subscriber is not waited for.
+    static bool cancel(Channel* channel);
+
+private:
+    static PvaPyLogger logger;
+    static epics::pvData::Mutex mutex;
+    static epicsEvent readyEvent;
+    static std::deque<Channel*> readyChannels;
+    static std::set<Channel*> scheduledChannels;
+    static std::map<Channel*, epicsThreadId> runningChannels;
+    static std::map<Channel*, bool> cancelledChannels;
+    static std::map<Channel*, epicsTime> delayedChannels;
+    static int workerPoolSize;
+    static int nWorkers;
+
+    static void startWorkers();
+    static void workerThread(void*);
+    static Channel* waitForChannel();
+    static double scheduleDelayedChannels();
+    static void completeChannel(Channel* channel, bool moreData, double retryDelay);
+};
+
+#endif
@@ -2,18 +2,33 @@
 // found in the file LICENSE that is included with the distribution
 
 #include "ChannelMonitorRequesterImpl.h"
+#include "ChannelMonitorDispatcher.h"
 
 PvaPyLogger ChannelMonitorRequesterImpl::logger("ChannelMonitorRequesterImpl");
 
 ChannelMonitorRequesterImpl::ChannelMonitorRequesterImpl(const std::string& channelName_) : 
     channelName(channelName_),
-    pvObjectQueue()
+    pvObjectQueue(),
+    pvObjectRingBuffer(0, PvObject(epics::pvData::PVStructurePtr())),
+    pvObjectQueueLockFree(false),
+    snapshotPool(),
+    copyOnChange(false),
+    channel(NULL),
+    channelMutex(),
+    monitorWeakPtr()
 {
 }
 
 ChannelMonitorRequesterImpl::ChannelMonitorRequesterImpl(const ChannelMonitorRequesterImpl& channelMonitor) : 
     channelName(channelMonitor.channelName),
-    pvObjectQueue()
+    pvObjectQueue(),
+    pvObjectRingBuffer(0, PvObject(epics::pvData::PVStructurePtr())),
+    pvObjectQueueLockFree(false),
+    snapshotPool(),
+    copyOnChange(false),
+    channel(NULL),
+    channelMutex(),
+    monitorWeakPtr()
 {
 }
 
@@ -34,6 +49,10 @@ void ChannelMonitorRequesterImpl::message(const std::string& message, epics::pvD
 void ChannelMonitorRequesterImpl::monitorConnect(const epics::pvData::Status& status, const epics::pvData::Monitor::shared_pointer& monitor, const epics::pvData::StructureConstPtr&) 
 {
     if (status.isSuccess()) {
+        {
+            epics::pvData::Lock lock(channelMutex);
+            monitorWeakPtr = monitor;
+        }
         epics::pvData::Status startStatus = monitor->start();
         if (!startStatus.isSuccess()) {
             std::cerr << "[" << channelName << "] channel monitor start: " << startStatus.getMessage() << std::endl;
@@ -46,12 +65,42 @@ void ChannelMonitorRequesterImpl::monitorConnect(const epics::pvData::Status& st
 
 void ChannelMonitorRequesterImpl::monitorEvent(const epics::pvData::Monitor::shared_pointer& monitor)
 {
+    // Channel cannot be detached while data is being queued
+    epics::pvData::Lock lock(channelMutex);
     epics::pvData::MonitorElement::shared_pointer element;
-    while (element = monitor->poll()) {
-        epics::pvData::PVStructurePtr pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(element->pvStructurePtr);
+    while (true) {
+        // Callback never waits for room in the queue; elements that are
+        // not polled stay in pvAccess, which applies its own flow control
+        if (!pvObjectQueueLockFree && !pvObjectQueue.checkProducerSpace()) {
+            break;
+        }
+        element = monitor->poll();
+        if (!element) {
+            break;
+        }
+        epics::pvData::PVStructurePtr pvStructurePtr;
+        if (copyOnChange) {
+            pvStructurePtr = snapshotPool.createSnapshot(element->pvStructurePtr, element->changedBitSet);
+        }
+        else {
+            pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(element->pvStructurePtr);
+        }
         PvObject pvObject(pvStructurePtr); 
-        pvObjectQueue.push(pvObject);
+        pvObject.setChangedBitSet(element->changedBitSet);
+        pvObject.setOverrunBitSet(element->overrunBitSet);
+        if (pvObjectQueueLockFree) {
+            pvObjectRingBuffer.push(pvObject);
+        }
+        else {
+            pvObjectQueue.push(pvObject);
+        }
         monitor->release(element);
+
+        // Channel is scheduled for each element, so that workers start
+        // processing while further elements are queued
+        if (channel) {
+            ChannelMonitorDispatcher::schedule(channel);
+        }
     }
     logger.debug("Pushed new monitor element into the queue: %d elements have not been processed.", pvObjectQueue.size());
 }
@@ -62,30 +111,60 @@ void ChannelMonitorRequesterImpl::unlisten(const epics::pvData::Monitor::shared_
 
 PvObject ChannelMonitorRequesterImpl::getQueuedPvObject(double timeout) throw(ChannelTimeout)
 {
-    try {
-        return pvObjectQueue.frontAndPop(timeout);
-    }
-    catch (InvalidState& ex) {
+    std::vector<PvObject> pvObjects;
+    if (getQueuedPvObjects(pvObjects, 1, timeout) == 0) {
         throw ChannelTimeout("No PV changes for channel %s received.", channelName.c_str());
     }
+    return pvObjects[0];
+}
+
+int ChannelMonitorRequesterImpl::getQueuedPvObjects(std::vector<PvObject>& pvObjects, int maxObjects, double timeout)
+{
+    if (pvObjectQueueLockFree) {
+        if (pvObjectRingBuffer.empty() && !pvObjectRingBuffer.waitForItem(timeout)) {
+            return 0;
+        }
+        return pvObjectRingBuffer.popBatch(pvObjects, maxObjects);
+    }
+    int nObjects = pvObjectQueue.frontAndPopBatch(pvObjects, maxObjects);
+    if (nObjects == 0) {
+        pvObjectQueue.waitForItem(timeout);
+        nObjects = pvObjectQueue.frontAndPopBatch(pvObjects, maxObjects);
+    }
+    if (nObjects > 0 && pvObjectQueue.resumeProducer()) {
+        resumeMonitorEvents();
+    }
+    return nObjects;
+}
+
+void ChannelMonitorRequesterImpl::resumeMonitorEvents()
+{
+    epics::pvData::Monitor::shared_pointer monitor;
+    {
+        epics::pvData::Lock lock(channelMutex);
+        monitor = monitorWeakPtr.lock();
+    }
+    if (monitor) {
+        monitorEvent(monitor);
+    }
 }
 
 void ChannelMonitorRequesterImpl::cancelGetQueuedPvObject()
 {
     pvObjectQueue.cancelWaitForItem();
+    pvObjectRingBuffer.cancelWaitForItem();
 }
 
 void ChannelMonitorRequesterImpl::clearPvObjectQueue()
 {
-    logger.debug("Clearing pv object monitor queue: %d elements have not been processed.", pvObjectQueue.size());
-    try {
-        while (!pvObjectQueue.empty()) {
-            pvObjectQueue.frontAndPop();
-        }
-    }
-    catch (const InvalidState& ex) {
-        // OK, we are done.
+    snapshotPool.clear();
+    if (pvObjectQueueLockFree) {
+        logger.debug("Clearing lock-free pv object monitor queue: %d elements have not been processed, %llu elements were dropped.", pvObjectRingBuffer.size(), pvObjectRingBuffer.getDropCount());
+        pvObjectRingBuffer.clear();
+        return;
     }
+    logger.debug("Clearing pv object monitor queue: %d elements have not been processed.", pvObjectQueue.size());
+    pvObjectQueue.clear();
 }
 
 void ChannelMonitorRequesterImpl::setPvObjectQueueMaxLength(int maxLength)
@@ -98,3 +177,61 @@ int ChannelMonitorRequesterImpl::getPvObjectQueueMaxLength()
     return pvObjectQueue.getMaxLength();
 }
 
+void ChannelMonitorRequesterImpl::setPvObjectQueueOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy)
+{
+    pvObjectQueue.setOverflowPolicy(overflowPolicy);
+}
+
+QueueOverflowPolicy::PolicyType ChannelMonitorRequesterImpl::getPvObjectQueueOverflowPolicy()
+{
+    return pvObjectQueue.getOverflowPolicy();
+}
+
+QueueStatistics ChannelMonitorRequesterImpl::getPvObjectQueueStatistics()
+{
+    if (pvObjectQueueLockFree) {
+        return pvObjectRingBuffer.getStatistics();
+    }
+    return pvObjectQueue.getStatistics();
+}
+
+void ChannelMonitorRequesterImpl::setPvObjectQueueLockFree(bool lockFree)
+{
+    pvObjectQueueLockFree = lockFree;
+    if (lockFree) {
+        pvObjectRingBuffer.setCapacity(pvObjectQueue.getMaxLength());
+        if (pvObjectQueue.getMaxLength() <= 0) {
+            logger.warn("Lock-free monitor queue for channel %s cannot be unlimited, its capacity is %d", channelName.c_str(), pvObjectRingBuffer.getCapacity());
+        }
+        if (pvObjectQueue.getOverflowPolicy() != QueueOverflowPolicy::DropNewest) {
+            logger.warn("Lock-free monitor queue for channel %s ignores overflow policy and drops newest updates", channelName.c_str());
+        }
+    }
+}
+
+bool ChannelMonitorRequesterImpl::isPvObjectQueueLockFree() const
+{
+    return pvObjectQueueLockFree;
+}
+
+void ChannelMonitorRequesterImpl::setChannel(Channel* channel)
+{
+    epics::pvData::Lock lock(channelMutex);
+    this->channel = channel;
+}
+
+void ChannelMonitorRequesterImpl::setCopyOnChange(bool copyOnChange)
+{
+    this->copyOnChange = copyOnChange;
+    if (copyOnChange) {
+        // Pool must be able to hold all queued snapshots, as well as
+        // the ones being processed
+        int maxLength = pvObjectQueue.getMaxLength();
+        snapshotPool.setMaxSize(maxLength > 0 ? maxLength+2 : MonitorSnapshotPool::DefaultMaxSize);
+    }
+}
+
+bool ChannelMonitorRequesterImpl::isCopyOnChange() const
+{
+    return copyOnChange;
+}
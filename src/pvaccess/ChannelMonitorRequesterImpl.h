@@ -5,6 +5,7 @@
 #define CHANNEL_MONITOR_REQUESTER_IMPL_H
 
 #include <string>
+#include <vector>
 #include <map>
 #include <utility>
 #include "pv/pvData.h"
@@ -13,8 +14,14 @@
 #include "PvaClient.h"
 #include "PvaPyLogger.h"
 #include "SynchronizedQueue.h"
+#include "SpscRingBuffer.h"
+#include "QueueOverflowPolicy.h"
+#include "QueueStatistics.h"
+#include "MonitorSnapshotPool.h"
 #include "ChannelTimeout.h"
 
+class Channel;
+
 class ChannelMonitorRequesterImpl : public epics::pvData::MonitorRequester
 {
 public:
@@ -29,16 +36,46 @@ public:
     virtual void unlisten(const epics::pvData::Monitor::shared_pointer& monitor);
 
     virtual PvObject getQueuedPvObject(double timeout) throw(ChannelTimeout);
+
+    // Appends up to maxObjects queued PV objects, waiting for timeout only
+    // if queue is empty; returns number of appended objects.
+    virtual int getQueuedPvObjects(std::vector<PvObject>& pvObjects, int maxObjects, double timeout);
     virtual void cancelGetQueuedPvObject();
     virtual void clearPvObjectQueue();
 
     virtual void setPvObjectQueueMaxLength(int maxLength);
     virtual int getPvObjectQueueMaxLength();
+    virtual void setPvObjectQueueOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy);
+    virtual QueueOverflowPolicy::PolicyType getPvObjectQueueOverflowPolicy();
+    virtual QueueStatistics getPvObjectQueueStatistics();
+
+    // Lock-free queue must be selected before monitor is created
+    virtual void setPvObjectQueueLockFree(bool lockFree);
+    virtual bool isPvObjectQueueLockFree() const;
+
+    // Channel is scheduled for processing whenever monitor data is
+    // queued; null channel detaches requester from it
+    virtual void setChannel(Channel* channel);
+
+    // Copy-on-change mode must be selected before monitor is created
+    virtual void setCopyOnChange(bool copyOnChange);
+    virtual bool isCopyOnChange() const;
 
 private:
     static PvaPyLogger logger;
     std::string channelName;
     SynchronizedQueue<PvObject> pvObjectQueue;
+    SpscRingBuffer<PvObject> pvObjectRingBuffer;
+    bool pvObjectQueueLockFree;
+    MonitorSnapshotPool snapshotPool;
+    bool copyOnChange;
+    Channel* channel;
+    epics::pvData::Mutex channelMutex;
+
+    // Monitor whose elements are left in pvAccess while queue is full
+    // with blocking overflow policy; consumer resumes polling it
+    void resumeMonitorEvents();
+    std::tr1::weak_ptr<epics::pvData::Monitor> monitorWeakPtr;
 };
 
 #endif // CHANNEL_MONITOR_REQUESTER_IMPL_H
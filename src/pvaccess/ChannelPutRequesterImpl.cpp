@@ -2,6 +2,7 @@
 // found in the file LICENSE that is included with the distribution
 
 #include "ChannelPutRequesterImpl.h"
+#include "PyPvDataUtility.h"
 
 PvaClient ChannelPutRequesterImpl::pvaClient;
 
@@ -46,7 +47,7 @@ void ChannelPutRequesterImpl::channelPutConnect(const epics::pvData::Status& sta
     }
     else {
         std::cerr << "[" << channelName << "] failed to create channel put: " << status.getMessage() << std::endl;
-        event->signal();
+        signalCompletion();
     }
 }
 
@@ -57,7 +58,6 @@ void ChannelPutRequesterImpl::getDone(const epics::pvData::Status& status, const
         if (!status.isOK()) {
             std::cerr << "[" << channelName << "] channel get: " << status.getMessage() << std::endl;
         }
-        done = true;
 
         {
             epics::pvData::Lock lock(pointerMutex);
@@ -66,11 +66,32 @@ void ChannelPutRequesterImpl::getDone(const epics::pvData::Status& status, const
             this->bitSet = bitSet;
         }
             
+        if (!putPvStructure) {
+            done = true;
+        }
+        else if (issuePut(channelPut, pvStructure, bitSet)) {
+            // Completion will be signaled by putDone()
+            return;
+        }
     }
     else {
         std::cerr << "[" << channelName << "] failed to get: " << status.getMessage() << std::endl;
     }
-    event->signal();
+    signalCompletion();
+}
+
+bool ChannelPutRequesterImpl::issuePut(const epics::pvAccess::ChannelPut::shared_pointer& channelPut, const epics::pvData::PVStructure::shared_pointer& pvStructure, const epics::pvData::BitSet::shared_pointer& bitSet)
+{
+    try {
+        epics::pvData::PVStructurePtr pvStructurePtr = pvStructure;
+        PyPvDataUtility::copyStructureToStructure(putPvStructure, pvStructurePtr);
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "[" << channelName << "] failed to set put data: " << ex.what() << std::endl;
+        return false;
+    }
+    channelPut->put(pvStructure, bitSet);
+    return true;
 }
 
 void ChannelPutRequesterImpl::putDone(const epics::pvData::Status& status, const epics::pvAccess::ChannelPut::shared_pointer& channelPut)
@@ -85,6 +106,11 @@ void ChannelPutRequesterImpl::putDone(const epics::pvData::Status& status, const
     else {
         std::cerr << "[" << channelName << "] failed to put: " << status.getMessage() << std::endl;
     }
+    signalCompletion();
+}
+
+void ChannelPutRequesterImpl::signalCompletion()
+{
     event->signal();
 }
 
@@ -119,3 +145,7 @@ epics::pvData::BitSet::shared_pointer ChannelPutRequesterImpl::getBitSet()
     return bitSet;
 }
 
+void ChannelPutRequesterImpl::setPutData(const epics::pvData::PVStructurePtr& putPvStructure)
+{
+    this->putPvStructure = putPvStructure;
+}
@@ -28,12 +28,24 @@ public:
     void resetEvent();
     bool waitUntilDone(double timeOut);
 
+    // If put data is set, it is copied into the put structure and sent
+    // to server as soon as current value is received, without waiting
+    // for the caller; waitUntilDone() then waits for put completion
+    void setPutData(const epics::pvData::PVStructurePtr& putPvStructure);
+
+protected:
+    // Wakes up caller waiting for request completion or failure
+    virtual void signalCompletion();
+
 private:
     static PvaClient pvaClient;
 
+    bool issuePut(const epics::pvAccess::ChannelPut::shared_pointer& channelPut, const epics::pvData::PVStructure::shared_pointer& pvStructure, const epics::pvData::BitSet::shared_pointer& bitSet);
+
     epics::pvAccess::ChannelPut::shared_pointer channelPut;
     epics::pvData::PVStructure::shared_pointer pvStructure;
     epics::pvData::BitSet::shared_pointer bitSet;
+    epics::pvData::PVStructurePtr putPvStructure;
     epics::pvData::Mutex pointerMutex;
     epics::pvData::Mutex eventMutex;
     epics::pvData::EventPtr event;
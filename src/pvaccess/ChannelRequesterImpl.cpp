@@ -2,6 +2,7 @@
 // found in the file LICENSE that is included with the distribution
 
 #include "ChannelRequesterImpl.h"
+#include "ChannelAsyncRequest.h"
 
 #include <iostream>
 #include <string>
@@ -41,6 +42,9 @@ void ChannelRequesterImpl::channelStateChange(const epics::pvAccess::Channel::sh
 	if (connectionState == epics::pvAccess::Channel::CONNECTED) {
 		event.signal();
 	}
+
+    // Asynchronous requests may be waiting for connection
+    ChannelAsyncRequest::notifyDispatcher();
 }
     
 bool ChannelRequesterImpl::waitUntilConnected(double timeOut)
@@ -0,0 +1,94 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "MonitorSnapshotPool.h"
+#include "PvUtility.h"
+
+const int MonitorSnapshotPool::DefaultMaxSize(8);
+
+PvaPyLogger MonitorSnapshotPool::logger("MonitorSnapshotPool");
+
+MonitorSnapshotPool::MonitorSnapshotPool(int maxSize_) :
+    snapshots(),
+    structurePtr(),
+    maxSize(maxSize_),
+    mutex()
+{
+}
+
+MonitorSnapshotPool::~MonitorSnapshotPool()
+{
+}
+
+void MonitorSnapshotPool::setMaxSize(int maxSize)
+{
+    epics::pvData::Lock lock(mutex);
+    if (maxSize < 1) {
+        maxSize = DefaultMaxSize;
+    }
+    this->maxSize = maxSize;
+    if (int(snapshots.size()) > maxSize) {
+        snapshots.resize(maxSize);
+    }
+}
+
+void MonitorSnapshotPool::clear()
+{
+    epics::pvData::Lock lock(mutex);
+    snapshots.clear();
+    structurePtr.reset();
+}
+
+epics::pvData::PVStructurePtr MonitorSnapshotPool::createSnapshot(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet::shared_pointer& changedBitSetPtr)
+{
+    epics::pvData::Lock lock(mutex);
+
+    // Pooled snapshots are only valid for the same introspection interface
+    epics::pvData::StructureConstPtr sourceStructurePtr = pvStructurePtr->getStructure();
+    if (sourceStructurePtr != structurePtr) {
+        snapshots.clear();
+        structurePtr = sourceStructurePtr;
+    }
+
+    // Without change information entire structure is considered changed
+    epics::pvData::BitSet allChangedBitSet;
+    if (!changedBitSetPtr) {
+        allChangedBitSet.set(0);
+    }
+    const epics::pvData::BitSet& changedBitSet = (changedBitSetPtr ? *changedBitSetPtr : allChangedBitSet);
+
+    // Snapshot is free if it is referenced only by the pool; all
+    // snapshots remember changes they have missed
+    Snapshot* freeSnapshot = NULL;
+    std::vector<Snapshot>::iterator iter;
+    for (iter = snapshots.begin(); iter != snapshots.end(); iter++) {
+        *(iter->staleBitSetPtr) |= changedBitSet;
+        if (!freeSnapshot && iter->pvStructurePtr.use_count() == 1) {
+            freeSnapshot = &(*iter);
+        }
+    }
+
+    if (freeSnapshot) {
+        PvUtility::copyChangedFields(pvStructurePtr, freeSnapshot->pvStructurePtr, *(freeSnapshot->staleBitSetPtr));
+        freeSnapshot->staleBitSetPtr->clear();
+        return freeSnapshot->pvStructurePtr;
+    }
+
+    epics::pvData::PVStructurePtr snapshotPvStructurePtr = createStructureCopy(pvStructurePtr);
+    if (int(snapshots.size()) < maxSize) {
+        Snapshot snapshot;
+        snapshot.pvStructurePtr = snapshotPvStructurePtr;
+        snapshot.staleBitSetPtr.reset(new epics::pvData::BitSet());
+        snapshots.push_back(snapshot);
+        logger.trace("Added snapshot to pool, pool size is %d", int(snapshots.size()));
+    }
+    else {
+        logger.trace("All %d pooled snapshots are in use, snapshot will not be pooled", maxSize);
+    }
+    return snapshotPvStructurePtr;
+}
+
+epics::pvData::PVStructurePtr MonitorSnapshotPool::createStructureCopy(const epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    return epics::pvData::getPVDataCreate()->createPVStructure(pvStructurePtr);
+}
@@ -0,0 +1,62 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef MONITOR_SNAPSHOT_POOL_H
+#define MONITOR_SNAPSHOT_POOL_H
+
+#include <vector>
+#include "pv/pvData.h"
+#include "pv/bitSet.h"
+#include "PvaPyLogger.h"
+
+//
+// Pool of preallocated monitor snapshot structures.
+//
+// Each snapshot delivered to subscribers is an independent structure, but
+// instead of deep copying the whole monitored structure for every update,
+// pool reuses snapshots that are no longer referenced outside of the pool,
+// and copies into them only fields that changed since they were last
+// filled in. Scalar array fields share the frozen source array data.
+//
+// Fields of delivered snapshots must not be modified by their users, as
+// such changes would not be overwritten when snapshot is reused.
+//
+class MonitorSnapshotPool
+{
+public:
+    static const int DefaultMaxSize;
+
+    MonitorSnapshotPool(int maxSize=DefaultMaxSize);
+    virtual ~MonitorSnapshotPool();
+
+    void setMaxSize(int maxSize);
+    int getMaxSize() const;
+    void clear();
+
+    // Source structure must contain all current field values, and
+    // changed bit set must mark fields changed since the previous call.
+    epics::pvData::PVStructurePtr createSnapshot(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet::shared_pointer& changedBitSetPtr);
+
+private:
+    static PvaPyLogger logger;
+
+    struct Snapshot
+    {
+        epics::pvData::PVStructurePtr pvStructurePtr;
+        epics::pvData::BitSet::shared_pointer staleBitSetPtr;
+    };
+
+    static epics::pvData::PVStructurePtr createStructureCopy(const epics::pvData::PVStructurePtr& pvStructurePtr);
+
+    std::vector<Snapshot> snapshots;
+    epics::pvData::StructureConstPtr structurePtr;
+    int maxSize;
+    epics::pvData::Mutex mutex;
+};
+
+inline int MonitorSnapshotPool::getMaxSize() const
+{
+    return maxSize;
+}
+
+#endif
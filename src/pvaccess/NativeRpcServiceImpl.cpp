@@ -0,0 +1,23 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "NativeRpcServiceImpl.h"
+
+NativeRpcServiceImpl::NativeRpcServiceImpl(const std::string& serviceName, const RpcServiceHandler& handler_, const RpcRequestDispatcherPtr& requestDispatcher, bool processInServerThread) :
+    RpcServiceImpl(serviceName, requestDispatcher, processInServerThread),
+    handler(handler_)
+{
+}
+
+NativeRpcServiceImpl::~NativeRpcServiceImpl()
+{
+}
+
+epics::pvData::PVStructurePtr NativeRpcServiceImpl::processRequest(const epics::pvData::PVStructurePtr& args)
+{
+    epics::pvData::PVStructurePtr result = handler(args);
+    if (!result) {
+        throw epics::pvAccess::RPCRequestException(epics::pvData::Status::STATUSTYPE_ERROR, "Service " + getServiceName() + " did not return response structure.");
+    }
+    return result;
+}
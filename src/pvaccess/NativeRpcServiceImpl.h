@@ -0,0 +1,32 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef NATIVE_RPC_SERVICE_IMPL_H
+#define NATIVE_RPC_SERVICE_IMPL_H
+
+#include <string>
+#include "boost/function.hpp"
+#include "RpcServiceImpl.h"
+
+// Native service handler is any C++ function or function object that
+// maps request arguments into response structure; it is invoked without
+// python GIL, and reports failures by throwing exception.
+typedef boost::function<epics::pvData::PVStructurePtr (const epics::pvData::PVStructurePtr&)> RpcServiceHandler;
+
+//
+// RPC service that invokes native C++ handler.
+//
+class NativeRpcServiceImpl : public RpcServiceImpl
+{
+public:
+    POINTER_DEFINITIONS(NativeRpcServiceImpl);
+    NativeRpcServiceImpl(const std::string& serviceName, const RpcServiceHandler& handler, const RpcRequestDispatcherPtr& requestDispatcher, bool processInServerThread);
+    virtual ~NativeRpcServiceImpl();
+
+    virtual epics::pvData::PVStructurePtr processRequest(const epics::pvData::PVStructurePtr& args);
+
+private:
+    RpcServiceHandler handler;
+};
+
+#endif
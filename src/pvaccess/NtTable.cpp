@@ -4,7 +4,10 @@
 #include "NtTable.h"
 #include "StringUtility.h"
 #include "PyPvDataUtility.h"
+#include "StructureCache.h"
+#include "NumpyUtility.h"
 #include "InvalidArgument.h"
+#include "InvalidDataType.h"
 
 const char* NtTable::StructureId("epics:nt/NTTable:1.0");
 const char* NtTable::LabelsFieldKey("labels");
@@ -62,6 +65,19 @@ boost::python::dict NtTable::createStructureDict(const boost::python::list& scal
     return pyDict;
 }
 
+epics::pvData::StructureConstPtr NtTable::createStructure(int nColumns, PvType::ScalarType scalarType)
+{
+    // Tables with the same number and type of columns share structure,
+    // so that its dictionary does not have to be created and parsed
+    std::string key = std::string(StructureId) + "|" + StringUtility::toString(nColumns) + "|" + StringUtility::toString(int(scalarType));
+    epics::pvData::StructureConstPtr structurePtr = StructureCache::getStructure(key);
+    if (!structurePtr) {
+        structurePtr = PyPvDataUtility::createStructureFromDict(createStructureDict(nColumns, scalarType), StructureId);
+        StructureCache::addStructure(key, structurePtr);
+    }
+    return structurePtr;
+}
+
 std::string NtTable::getColumnName(int column) 
 {
     std::string columnName = "column" + StringUtility::toString(column);
@@ -69,7 +85,7 @@ std::string NtTable::getColumnName(int column)
 }
 
 NtTable::NtTable(int nColumns_, PvType::ScalarType scalarType)
-    : NtType(createStructureDict(nColumns_, scalarType), StructureId),
+    : NtType(epics::pvData::getPVDataCreate()->createPVStructure(createStructure(nColumns_, scalarType))),
     nColumns(nColumns_)
 {
 }
@@ -91,8 +107,30 @@ NtTable::NtTable(const PvObject& pvObject)
     nColumns = pvScalarArrayPtr->getLength();
 }
 
+NtTable::NtTable(const boost::python::object& columns)
+    : NtType(epics::pvData::PVStructurePtr()),
+    nColumns(0)
+{
+    boost::python::list labels;
+    std::vector<boost::python::object> columnObjects;
+    extractColumns(columns, labels, columnObjects);
+
+    boost::python::list scalarTypePyList;
+    for (unsigned int i = 0; i < columnObjects.size(); i++) {
+        scalarTypePyList.append(getColumnScalarType(columnObjects[i]));
+    }
+    pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(StructureCache::getStructureFromDict(createStructureDict(scalarTypePyList), StructureId));
+    nColumns = columnObjects.size();
+
+    setLabels(labels);
+    for (int column = 0; column < nColumns; column++) {
+        setColumn(column, columnObjects[column]);
+    }
+}
+
 NtTable::NtTable(const NtTable& ntTable)
-    : NtType(ntTable.pvStructurePtr)
+    : NtType(ntTable.pvStructurePtr),
+    nColumns(ntTable.nColumns)
 {
 }
 
@@ -113,14 +151,20 @@ void NtTable::setLabels(const boost::python::list& pyList)
     PyPvDataUtility::pyListToScalarArrayField(pyList, LabelsFieldKey, pvStructurePtr);
 }
 
-void NtTable::setColumn(int column, const boost::python::list& pyList)
+void NtTable::checkColumnIndex(int column) const
 {
     if (column < 0 || column >= nColumns) {
         throw InvalidArgument("Column index must be in range [0,%d].", nColumns-1);
     }
+}
+
+void NtTable::setColumn(int column, const boost::python::object& pyObject)
+{
+    // Buffer objects (e.g., NumPy arrays) are copied in bulk
+    checkColumnIndex(column);
     std::string columnName = getColumnName(column);
     epics::pvData::PVStructurePtr pvStructurePtr2 = PyPvDataUtility::getStructureField(ValueFieldKey, pvStructurePtr);
-    PyPvDataUtility::pyListToScalarArrayField(pyList, columnName, pvStructurePtr2);
+    PyPvDataUtility::pyObjectToScalarArrayField(pyObject, columnName, pvStructurePtr2);
 }
 
 boost::python::list NtTable::getLabels() const
@@ -132,15 +176,98 @@ boost::python::list NtTable::getLabels() const
 
 boost::python::list NtTable::getColumn(int column) const
 {
-    if (column < 0 || column >= nColumns) {
-        throw InvalidArgument("Column index must be in range [0,%d].", nColumns-1);
-    }
+    checkColumnIndex(column);
     std::string columnName = getColumnName(column);
     boost::python::list pyList;
     epics::pvData::PVStructurePtr pvStructurePtr2 = PyPvDataUtility::getStructureField(ValueFieldKey, pvStructurePtr);
     PyPvDataUtility::scalarArrayFieldToPyList(columnName, pvStructurePtr2, pyList);
     return pyList;
 }
+
+boost::python::object NtTable::getColumnAsNumpy(int column) const
+{
+    checkColumnIndex(column);
+    std::string columnName = getColumnName(column);
+    epics::pvData::PVStructurePtr pvStructurePtr2 = PyPvDataUtility::getStructureField(ValueFieldKey, pvStructurePtr);
+    return NumpyUtility::scalarArrayFieldToNumpyArray(columnName, pvStructurePtr2);
+}
+
+void NtTable::extractColumns(const boost::python::object& columns, boost::python::list& labels, std::vector<boost::python::object>& columnObjects)
+{
+    // Record array fields are strided views, so they are copied into
+    // contiguous arrays that can be transferred in bulk
+    if (PyObject_HasAttrString(columns.ptr(), "dtype")) {
+        boost::python::object names = columns.attr("dtype").attr("names");
+        if (names.ptr() == Py_None) {
+            throw InvalidArgument("Array used for table columns must have named fields.");
+        }
+        for (int i = 0; i < boost::python::len(names); i++) {
+            boost::python::object label = names[i];
+            labels.append(label);
+            columnObjects.push_back(columns[label].attr("copy")());
+        }
+        return;
+    }
+
+    boost::python::extract<boost::python::dict> dictExtract(columns);
+    if (!dictExtract.check()) {
+        throw InvalidArgument("Table columns must be given as dictionary or NumPy record array.");
+    }
+    boost::python::dict pyDict = dictExtract();
+    boost::python::list pyLabels = pyDict.keys();
+    for (int i = 0; i < boost::python::len(pyLabels); i++) {
+        boost::python::object label = pyLabels[i];
+        labels.append(label);
+        columnObjects.push_back(pyDict[label]);
+    }
+}
+
+PvType::ScalarType NtTable::getColumnScalarType(boost::python::object& columnObject)
+{
+    epics::pvData::ScalarType scalarType;
+    if (PyPvDataUtility::getPyBufferScalarType(columnObject, scalarType)) {
+        return static_cast<PvType::ScalarType>(scalarType);
+    }
+
+    // Arrays of other types (e.g., NumPy string arrays) are used as lists
+    if (PyObject_HasAttrString(columnObject.ptr(), "tolist")) {
+        columnObject = columnObject.attr("tolist")();
+    }
+    boost::python::extract<boost::python::list> listExtract(columnObject);
+    if (!listExtract.check()) {
+        throw InvalidArgument("Table column must be given as list or array.");
+    }
+
+    // Type of list column is determined by its first element
+    boost::python::list pyList = listExtract();
+    if (!boost::python::len(pyList)) {
+        return PvType::Double;
+    }
+    boost::python::object firstElement = pyList[0];
+    PyObject* pyObjectPtr = firstElement.ptr();
+    if (PyBool_Check(pyObjectPtr)) {
+        return PvType::Boolean;
+    }
+#if PY_MAJOR_VERSION < 3
+    if (PyInt_Check(pyObjectPtr) || PyLong_Check(pyObjectPtr)) {
+        return PvType::Long;
+    }
+    if (PyString_Check(pyObjectPtr) || PyUnicode_Check(pyObjectPtr)) {
+        return PvType::String;
+    }
+#else
+    if (PyLong_Check(pyObjectPtr)) {
+        return PvType::Long;
+    }
+    if (PyUnicode_Check(pyObjectPtr)) {
+        return PvType::String;
+    }
+#endif
+    if (PyFloat_Check(pyObjectPtr)) {
+        return PvType::Double;
+    }
+    throw InvalidDataType("Unsupported table column element type.");
+}
 void NtTable::setDescriptor(const std::string& descriptor)
 {
         pvStructurePtr->getSubField<epics::pvData::PVString>(DescriptorFieldKey)->put(descriptor);
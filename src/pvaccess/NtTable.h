@@ -5,6 +5,8 @@
 #define NT_TABLE_H
 
 #include <string>
+#include <vector>
+#include "boost/python/object.hpp"
 #include "boost/python/dict.hpp"
 #include "boost/python/list.hpp"
 #include "PvObject.h"
@@ -28,19 +30,25 @@ public:
     static std::string getColumnName(int column);
     static boost::python::dict createStructureDict(int nColumns, PvType::ScalarType scalarType);
     static boost::python::dict createStructureDict(const boost::python::list& scalarTypePyList);
+    static epics::pvData::StructureConstPtr createStructure(int nColumns, PvType::ScalarType scalarType);
 
     // Instance methods
     NtTable(int nColumns, PvType::ScalarType scalarType);
     NtTable(const boost::python::list& scalarTypePyList);
     NtTable(const PvObject& pvObject);
+
+    // Columns are given as dictionary of lists or arrays keyed by column
+    // label, or as NumPy record array; column types follow array types
+    NtTable(const boost::python::object& columns);
     NtTable(const NtTable& ntTable);
     virtual ~NtTable();
 
     virtual int getNColumns() const;
     virtual void setLabels(const boost::python::list& pyList);
     virtual boost::python::list getLabels() const;
-    virtual void setColumn(int column, const boost::python::list& pyList);
+    virtual void setColumn(int column, const boost::python::object& pyObject);
     virtual boost::python::list getColumn(int column) const;
+    virtual boost::python::object getColumnAsNumpy(int column) const;
     virtual void setDescriptor(const std::string& descriptor);
     virtual std::string getDescriptor() const;
     virtual void setTimeStamp(const PvTimeStamp& pvTimeStamp);
@@ -48,6 +56,11 @@ public:
     virtual void setAlarm(const PvAlarm& pvAlarm);
     virtual PvAlarm getAlarm() const;
 private:
+    static void extractColumns(const boost::python::object& columns, boost::python::list& labels, std::vector<boost::python::object>& columnObjects);
+    static PvType::ScalarType getColumnScalarType(boost::python::object& columnObject);
+
+    void checkColumnIndex(int column) const;
+
     int nColumns;
 };
 
@@ -0,0 +1,151 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "NumpyUtility.h"
+#include "PyPvDataUtility.h"
+#include "PvaException.h"
+#include "InvalidRequest.h"
+#include "InvalidDataType.h"
+#include "boost/python/handle.hpp"
+#include "boost/python/errors.hpp"
+
+#ifdef PVA_PY_HAVE_NUMPY
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include "numpy/arrayobject.h"
+#endif
+
+namespace NumpyUtility
+{
+
+static bool numpyInitialized = false;
+
+void initialize()
+{
+#ifdef PVA_PY_HAVE_NUMPY
+    if (numpyInitialized) {
+        return;
+    }
+    // Module import should not fail if numpy cannot be loaded at runtime;
+    // numpy-related methods will raise exception instead.
+    if (_import_array() < 0) {
+        PyErr_Clear();
+        return;
+    }
+    numpyInitialized = true;
+#endif
+}
+
+bool isAvailable()
+{
+    return numpyInitialized;
+}
+
+void checkAvailable()
+{
+    if (!numpyInitialized) {
+        throw InvalidRequest("NumPy support is not available: pvaccess module was built without NumPy, or numpy module cannot be imported");
+    }
+}
+
+#ifdef PVA_PY_HAVE_NUMPY
+
+template<typename CppType>
+void deleteSharedVector(PyObject* pyCapsule)
+{
+    delete static_cast<epics::pvData::shared_vector<const CppType>*>(PyCapsule_GetPointer(pyCapsule, NULL));
+}
+
+template<typename PvArrayType, typename CppType>
+boost::python::object scalarArrayToNumpyArray(const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr, int numpyType)
+{
+    const typename PvArrayType::const_svector& data = std::tr1::static_pointer_cast<PvArrayType>(pvScalarArrayPtr)->view();
+    npy_intp dims[1] = { static_cast<npy_intp>(data.size()) };
+    PyObject* pyArray = PyArray_SimpleNewFromData(1, dims, numpyType, const_cast<CppType*>(data.data()));
+    if (!pyArray) {
+        boost::python::throw_error_already_set();
+    }
+
+    // Capsule holds reference to the array data and is owned by the numpy
+    // array, so data is released only after the last view goes away
+    epics::pvData::shared_vector<const CppType>* dataHolder = new epics::pvData::shared_vector<const CppType>(data);
+    PyObject* pyCapsule = PyCapsule_New(dataHolder, NULL, deleteSharedVector<CppType>);
+    if (!pyCapsule) {
+        delete dataHolder;
+        Py_DECREF(pyArray);
+        boost::python::throw_error_already_set();
+    }
+    PyArrayObject* pyArrayObject = reinterpret_cast<PyArrayObject*>(pyArray);
+    if (PyArray_SetBaseObject(pyArrayObject, pyCapsule) < 0) {
+        Py_DECREF(pyArray);
+        boost::python::throw_error_already_set();
+    }
+
+    // PV array data is frozen, so it must not be modified in place
+    PyArray_CLEARFLAGS(pyArrayObject, NPY_ARRAY_WRITEABLE);
+    return boost::python::object(boost::python::handle<>(pyArray));
+}
+
+#endif // PVA_PY_HAVE_NUMPY
+
+//
+// Conversion PV Scalar Array => NumPy array
+//
+boost::python::object scalarArrayToNumpyArray(const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr)
+{
+    checkAvailable();
+#ifdef PVA_PY_HAVE_NUMPY
+    epics::pvData::ScalarType scalarType = pvScalarArrayPtr->getScalarArray()->getElementType();
+    switch (scalarType) {
+        case epics::pvData::pvBoolean: {
+            return scalarArrayToNumpyArray<epics::pvData::PVBooleanArray, epics::pvData::boolean>(pvScalarArrayPtr, NPY_BOOL);
+        }
+        case epics::pvData::pvByte: {
+            return scalarArrayToNumpyArray<epics::pvData::PVByteArray, epics::pvData::int8>(pvScalarArrayPtr, NPY_INT8);
+        }
+        case epics::pvData::pvUByte: {
+            return scalarArrayToNumpyArray<epics::pvData::PVUByteArray, epics::pvData::uint8>(pvScalarArrayPtr, NPY_UINT8);
+        }
+        case epics::pvData::pvShort: {
+            return scalarArrayToNumpyArray<epics::pvData::PVShortArray, epics::pvData::int16>(pvScalarArrayPtr, NPY_INT16);
+        }
+        case epics::pvData::pvUShort: {
+            return scalarArrayToNumpyArray<epics::pvData::PVUShortArray, epics::pvData::uint16>(pvScalarArrayPtr, NPY_UINT16);
+        }
+        case epics::pvData::pvInt: {
+            return scalarArrayToNumpyArray<epics::pvData::PVIntArray, epics::pvData::int32>(pvScalarArrayPtr, NPY_INT32);
+        }
+        case epics::pvData::pvUInt: {
+            return scalarArrayToNumpyArray<epics::pvData::PVUIntArray, epics::pvData::uint32>(pvScalarArrayPtr, NPY_UINT32);
+        }
+        case epics::pvData::pvLong: {
+            return scalarArrayToNumpyArray<epics::pvData::PVLongArray, epics::pvData::int64>(pvScalarArrayPtr, NPY_INT64);
+        }
+        case epics::pvData::pvULong: {
+            return scalarArrayToNumpyArray<epics::pvData::PVULongArray, epics::pvData::uint64>(pvScalarArrayPtr, NPY_UINT64);
+        }
+        case epics::pvData::pvFloat: {
+            return scalarArrayToNumpyArray<epics::pvData::PVFloatArray, float>(pvScalarArrayPtr, NPY_FLOAT32);
+        }
+        case epics::pvData::pvDouble: {
+            return scalarArrayToNumpyArray<epics::pvData::PVDoubleArray, double>(pvScalarArrayPtr, NPY_FLOAT64);
+        }
+        case epics::pvData::pvString: {
+            throw InvalidDataType("String arrays cannot be converted to NumPy arrays");
+        }
+        default: {
+            throw PvaException("Unrecognized scalar type: %d", scalarType);
+        }
+    }
+#else
+    return boost::python::object();
+#endif // PVA_PY_HAVE_NUMPY
+}
+
+boost::python::object scalarArrayFieldToNumpyArray(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    epics::pvData::ScalarType scalarType = PyPvDataUtility::getScalarArrayType(fieldName, pvStructurePtr);
+    epics::pvData::PVScalarArrayPtr pvScalarArrayPtr = PyPvDataUtility::getScalarArrayField(fieldName, scalarType, pvStructurePtr);
+    return scalarArrayToNumpyArray(pvScalarArrayPtr);
+}
+
+} // namespace NumpyUtility
@@ -0,0 +1,34 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef NUMPY_UTILITY_H
+#define NUMPY_UTILITY_H
+
+#include <string>
+#include "pv/pvData.h"
+#include "boost/python/object.hpp"
+
+namespace NumpyUtility
+{
+
+//
+// NumPy support is enabled at build time with PVA_PY_HAVE_NUMPY;
+// the NumPy C API must be loaded once when the module is imported
+//
+void initialize();
+bool isAvailable();
+void checkAvailable();
+
+//
+// Conversion PV Scalar Array => NumPy array
+//
+// Resulting array is a read-only view of the (frozen) PV array data; it
+// keeps reference to the underlying shared_vector for as long as it lives,
+// so no data is copied.
+//
+boost::python::object scalarArrayToNumpyArray(const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr);
+boost::python::object scalarArrayFieldToNumpyArray(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr);
+
+} // namespace NumpyUtility
+
+#endif
@@ -6,6 +6,9 @@
 #include "PvaConstants.h"
 #include "PvaException.h"
 #include "PyPvDataUtility.h"
+#include "PyDictConversionPlan.h"
+#include "StructureCache.h"
+#include "NumpyUtility.h"
 #include "StringUtility.h"
 #include "InvalidArgument.h"
 #include "InvalidRequest.h"
@@ -22,19 +25,25 @@ const char* PvObject::StructureId("structure");
 // Constructors
 PvObject::PvObject(const epics::pvData::PVStructurePtr& pvStructurePtr_)
     : pvStructurePtr(pvStructurePtr_),
-    dataType(PvType::Structure)
+    dataType(PvType::Structure),
+    changedBitSetPtr(),
+    overrunBitSetPtr()
 {
 }
 
 PvObject::PvObject(const boost::python::dict& pyDict, const std::string& structureId)
-    : pvStructurePtr(epics::pvData::getPVDataCreate()->createPVStructure(PyPvDataUtility::createStructureFromDict(pyDict, structureId))),
-    dataType(PvType::Structure)
+    : pvStructurePtr(epics::pvData::getPVDataCreate()->createPVStructure(StructureCache::getStructureFromDict(pyDict, structureId))),
+    dataType(PvType::Structure),
+    changedBitSetPtr(),
+    overrunBitSetPtr()
 {
 }
 
 PvObject::PvObject(const PvObject& pvObject)
     : pvStructurePtr(pvObject.pvStructurePtr),
-    dataType(pvObject.dataType)
+    dataType(pvObject.dataType),
+    changedBitSetPtr(pvObject.changedBitSetPtr),
+    overrunBitSetPtr(pvObject.overrunBitSetPtr)
 {
 }
 
@@ -43,6 +52,21 @@ PvObject::~PvObject()
 {
 }
 
+// Copy methods
+PvObject PvObject::clone() const
+{
+    PvObject pvObject(epics::pvData::getPVDataCreate()->createPVStructure(pvStructurePtr));
+    pvObject.dataType = dataType;
+    return pvObject;
+}
+
+PvObject PvObject::fromTemplate(const PvObject& templatePvObject)
+{
+    PvObject pvObject(epics::pvData::getPVDataCreate()->createPVStructure(templatePvObject.getStructurePtr()));
+    pvObject.dataType = templatePvObject.dataType;
+    return pvObject;
+}
+
 // Operators/conversion methods
 epics::pvData::PVStructurePtr PvObject::getPvStructurePtr() const
 {
@@ -71,6 +95,16 @@ boost::python::dict PvObject::toDict() const
     return pyDict;
 }
 
+boost::python::dict PvObject::toDict(bool changedOnly) const
+{
+    if (!changedOnly || !changedBitSetPtr) {
+        return toDict();
+    }
+    boost::python::dict pyDict;
+    PyPvDataUtility::changedStructureToPyDict(pvStructurePtr, *changedBitSetPtr, pyDict);
+    return pyDict;
+}
+
 boost::python::dict PvObject::getStructureDict() 
 {
     boost::python::dict pyDict;
@@ -95,6 +129,82 @@ epics::pvData::PVStructurePtr& operator<<(epics::pvData::PVStructurePtr& pvStruc
     return pvStructurePtr;
 }
 
+//
+// Monitor change information
+//
+epics::pvData::BitSet::shared_pointer PvObject::copyBitSet(const epics::pvData::BitSet::shared_pointer& bitSetPtr)
+{
+    // Monitor bit sets are reused for subsequent updates
+    if (!bitSetPtr) {
+        return epics::pvData::BitSet::shared_pointer();
+    }
+    return epics::pvData::BitSet::shared_pointer(new epics::pvData::BitSet(*bitSetPtr));
+}
+
+void PvObject::setChangedBitSet(const epics::pvData::BitSet::shared_pointer& bitSetPtr)
+{
+    changedBitSetPtr = copyBitSet(bitSetPtr);
+}
+
+epics::pvData::BitSet::shared_pointer PvObject::getChangedBitSet() const
+{
+    return changedBitSetPtr;
+}
+
+void PvObject::setOverrunBitSet(const epics::pvData::BitSet::shared_pointer& bitSetPtr)
+{
+    overrunBitSetPtr = copyBitSet(bitSetPtr);
+}
+
+epics::pvData::BitSet::shared_pointer PvObject::getOverrunBitSet() const
+{
+    return overrunBitSetPtr;
+}
+
+void PvObject::addPreviousChanges(const PvObject& previousPvObject)
+{
+    epics::pvData::BitSet::shared_pointer newOverrunBitSetPtr(new epics::pvData::BitSet());
+    if (overrunBitSetPtr) {
+        *newOverrunBitSetPtr |= *overrunBitSetPtr;
+    }
+    if (previousPvObject.overrunBitSetPtr) {
+        *newOverrunBitSetPtr |= *(previousPvObject.overrunBitSetPtr);
+    }
+
+    // Object without change information is considered entirely changed
+    if (changedBitSetPtr && previousPvObject.changedBitSetPtr) {
+        epics::pvData::BitSet changedTwiceBitSet(*changedBitSetPtr);
+        changedTwiceBitSet &= *(previousPvObject.changedBitSetPtr);
+        *newOverrunBitSetPtr |= changedTwiceBitSet;
+        epics::pvData::BitSet::shared_pointer newChangedBitSetPtr(new epics::pvData::BitSet(*changedBitSetPtr));
+        *newChangedBitSetPtr |= *(previousPvObject.changedBitSetPtr);
+        changedBitSetPtr = newChangedBitSetPtr;
+    }
+    else {
+        changedBitSetPtr.reset();
+    }
+    overrunBitSetPtr = newOverrunBitSetPtr;
+}
+
+boost::python::list PvObject::getChangedFields() const
+{
+    // Without change information all fields are considered changed
+    epics::pvData::BitSet allChangedBitSet;
+    allChangedBitSet.set(0);
+    boost::python::list pyList;
+    PyPvDataUtility::changedFieldNamesToPyList(pvStructurePtr, (changedBitSetPtr ? *changedBitSetPtr : allChangedBitSet), pyList);
+    return pyList;
+}
+
+boost::python::list PvObject::getOverrunFields() const
+{
+    boost::python::list pyList;
+    if (overrunBitSetPtr) {
+        PyPvDataUtility::changedFieldNamesToPyList(pvStructurePtr, *overrunBitSetPtr, pyList);
+    }
+    return pyList;
+}
+
 //
 // Object set/get
 //
@@ -121,7 +231,10 @@ void PvObject::setObject(const boost::python::object& pyObject)
 
 boost::python::object PvObject::getObject(const std::string& key) const
 {
-    return toDict()[key];
+    // Only requested field is converted; missing key raises KeyError
+    boost::python::dict pyDict;
+    PyDictConversionPlan::getPlan(pvStructurePtr->getStructure())->fieldToPyDict(key, pvStructurePtr, pyDict);
+    return pyDict[key];
 }
 
 boost::python::object PvObject::getObject() const
@@ -406,15 +519,15 @@ std::string PvObject::getString() const
 }
 
 // Scalar array modifiers/accessors
-void PvObject::setScalarArray(const std::string& key, const boost::python::list& pyList)
+void PvObject::setScalarArray(const std::string& key, const boost::python::object& pyObject)
 {
-    PyPvDataUtility::pyListToScalarArrayField(pyList, key, pvStructurePtr);
+    PyPvDataUtility::pyObjectToScalarArrayField(pyObject, key, pvStructurePtr);
 }
 
-void PvObject::setScalarArray(const boost::python::list& pyList)
+void PvObject::setScalarArray(const boost::python::object& pyObject)
 {
     std::string key = PyPvDataUtility::getValueOrSingleFieldName(pvStructurePtr);
-    setScalarArray(key, pyList);
+    setScalarArray(key, pyObject);
 }
 
 boost::python::list PvObject::getScalarArray(const std::string& key) const
@@ -430,6 +543,17 @@ boost::python::list PvObject::getScalarArray() const
     return getScalarArray(key);
 }
 
+boost::python::object PvObject::getScalarArrayAsNumpy(const std::string& key) const
+{
+    return NumpyUtility::scalarArrayFieldToNumpyArray(key, pvStructurePtr);
+}
+
+boost::python::object PvObject::getScalarArrayAsNumpy() const
+{
+    std::string key = PyPvDataUtility::getValueOrSingleFieldName(pvStructurePtr);
+    return getScalarArrayAsNumpy(key);
+}
+
 // Structure modifiers/accessors
 void PvObject::setStructure(const std::string& key, const boost::python::dict& pyDict)
 {
@@ -713,4 +837,10 @@ PvObject PvObject::createUnionArrayElementField(const std::string& fieldName) co
     return createUnionArrayElementField(key, fieldName);
 }
 
+void coalesceQueueItem(PvObject& queuedPvObject, const PvObject& pvObject)
+{
+    PvObject previousPvObject = queuedPvObject;
+    queuedPvObject = pvObject;
+    queuedPvObject.addPreviousChanges(previousPvObject);
+}
 
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include "pv/pvData.h"
+#include "pv/bitSet.h"
 #include "boost/python/dict.hpp"
 #include "boost/python/list.hpp"
 
@@ -27,17 +28,35 @@ public:
     // Destructor
     virtual ~PvObject();
 
+    // Copy methods; new objects share introspection interface with
+    // the original, clone also copies field values
+    PvObject clone() const;
+    static PvObject fromTemplate(const PvObject& templatePvObject);
+
     // Operators
     epics::pvData::PVStructurePtr getPvStructurePtr() const;
     epics::pvData::StructureConstPtr getStructurePtr() const;
     operator epics::pvData::PVStructurePtr();
     operator boost::python::dict() const;
     boost::python::dict toDict() const;
+    boost::python::dict toDict(bool changedOnly) const;
     boost::python::dict getStructureDict();
     PvType::DataType getDataType();
     friend std::ostream& operator<<(std::ostream& out, const PvObject& pvObject);
     friend epics::pvData::PVStructurePtr& operator<<(epics::pvData::PVStructurePtr& pvStructurePtr, const PvObject& pvObject);
 
+    // Monitor change information; bit sets are copied
+    void setChangedBitSet(const epics::pvData::BitSet::shared_pointer& bitSetPtr);
+    epics::pvData::BitSet::shared_pointer getChangedBitSet() const;
+    void setOverrunBitSet(const epics::pvData::BitSet::shared_pointer& bitSetPtr);
+    epics::pvData::BitSet::shared_pointer getOverrunBitSet() const;
+
+    // Adds changes of the previous update which this object replaces;
+    // fields changed in both updates are marked as overrun.
+    void addPreviousChanges(const PvObject& previousPvObject);
+    boost::python::list getChangedFields() const;
+    boost::python::list getOverrunFields() const;
+
     // Object set/get
     void set(const boost::python::dict& pyDict);
     boost::python::dict get() const;
@@ -120,10 +139,12 @@ public:
     std::string getString() const;
 
     // Scalar array fields
-    void setScalarArray(const std::string& key, const boost::python::list& pyList);
-    void setScalarArray(const boost::python::list& pyList);
+    void setScalarArray(const std::string& key, const boost::python::object& pyObject);
+    void setScalarArray(const boost::python::object& pyObject);
     boost::python::list getScalarArray(const std::string& key) const;
     boost::python::list getScalarArray() const;
+    boost::python::object getScalarArrayAsNumpy(const std::string& key) const;
+    boost::python::object getScalarArrayAsNumpy() const;
 
     // Structure fields
     void setStructure(const std::string& key, const boost::python::dict& pyDict);
@@ -175,8 +196,16 @@ protected:
     epics::pvData::PVStructurePtr pvStructurePtr;
     PvType::DataType dataType;
 private:
+    static epics::pvData::BitSet::shared_pointer copyBitSet(const epics::pvData::BitSet::shared_pointer& bitSetPtr);
+
+    epics::pvData::BitSet::shared_pointer changedBitSetPtr;
+    epics::pvData::BitSet::shared_pointer overrunBitSetPtr;
  
 };
 
+// Monitor queue that coalesces updates keeps change information of the
+// object it replaces
+void coalesceQueueItem(PvObject& queuedPvObject, const PvObject& pvObject);
+
 #endif
 
@@ -3,6 +3,7 @@
 
 #include "PvScalarArray.h"
 #include "PyPvDataUtility.h"
+#include "NumpyUtility.h"
 
 boost::python::dict PvScalarArray::createStructureDict(PvType::ScalarType scalarType)
 {
@@ -41,9 +42,14 @@ boost::python::list PvScalarArray::toList() const
     return pyList;
 }
 
-void PvScalarArray::set(const boost::python::list& pyList)
+boost::python::object PvScalarArray::toNumpy() const
 {
-    PyPvDataUtility::pyListToScalarArrayField(pyList, ValueFieldKey, pvStructurePtr);
+    return NumpyUtility::scalarArrayFieldToNumpyArray(ValueFieldKey, pvStructurePtr);
+}
+
+void PvScalarArray::set(const boost::python::object& pyObject)
+{
+    PyPvDataUtility::pyObjectToScalarArrayField(pyObject, ValueFieldKey, pvStructurePtr);
 }
 
 boost::python::list PvScalarArray::get() const
@@ -18,8 +18,9 @@ public:
 
     operator boost::python::list() const;
     boost::python::list toList() const;
+    boost::python::object toNumpy() const;
 
-    virtual void set(const boost::python::list& pyList);
+    virtual void set(const boost::python::object& pyObject);
     virtual boost::python::list get() const;
 private:
     static boost::python::dict createStructureDict(PvType::ScalarType scalarType);
@@ -148,4 +148,25 @@ size_t fromString(const epics::pvData::PVStructurePtr& pvStructure, const epics:
     return processed;
 }
 
+void copyChangedFields(const epics::pvData::PVStructurePtr& sourcePvStructurePtr, const epics::pvData::PVStructurePtr& targetPvStructurePtr, const epics::pvData::BitSet& bitSet)
+{
+    epics::pvData::int32 offset = bitSet.nextSetBit(0);
+    if (offset == 0) {
+        epics::pvData::getConvert()->copyStructure(sourcePvStructurePtr, targetPvStructurePtr);
+        return;
+    }
+
+    // Changed structure field is copied as a whole, so that offsets of
+    // its subfields are skipped
+    while (offset > 0) {
+        epics::pvData::PVFieldPtr sourcePvFieldPtr = sourcePvStructurePtr->getSubField(offset);
+        epics::pvData::PVFieldPtr targetPvFieldPtr = targetPvStructurePtr->getSubField(offset);
+        if (!sourcePvFieldPtr || !targetPvFieldPtr) {
+            break;
+        }
+        epics::pvData::getConvert()->copy(sourcePvFieldPtr, targetPvFieldPtr);
+        offset = bitSet.nextSetBit(sourcePvFieldPtr->getNextFieldOffset());
+    }
+}
+
 }
@@ -5,6 +5,7 @@
 #define PV_UTILITY_H
 
 #include "pv/pvData.h"
+#include "pv/bitSet.h"
 
 namespace PvUtility 
 {
@@ -15,6 +16,9 @@ size_t fromString(const epics::pvData::PVScalarArrayPtr& pv, const epics::pvData
 
 size_t fromString(const epics::pvData::PVStructureArrayPtr& pv, const epics::pvData::StringArray& from, size_t fromStartIndex = 0);
 
+// Copies fields marked in bit set between structures of the same type
+void copyChangedFields(const epics::pvData::PVStructurePtr& sourcePvStructurePtr, const epics::pvData::PVStructurePtr& targetPvStructurePtr, const epics::pvData::BitSet& bitSet);
+
 }
 
 #endif
@@ -0,0 +1,130 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "PvaServer.h"
+#include "PvaServerChannelProviderFactory.h"
+#include "PyGilRelease.h"
+#include "StringUtility.h"
+
+const char* PvaServer::ProviderNamePrefix("pvaPyServer");
+
+PvaPyLogger PvaServer::logger("PvaServer");
+int PvaServer::serverCounter(0);
+
+PvaServer::PvaServer() :
+    channelProvider(),
+    channelProviderFactory(),
+    serverContext()
+{
+    initialize();
+}
+
+PvaServer::PvaServer(const std::string& channelName, const PvObject& pvObject) :
+    channelProvider(),
+    channelProviderFactory(),
+    serverContext()
+{
+    initialize();
+    addRecord(channelName, pvObject);
+}
+
+PvaServer::~PvaServer()
+{
+    try {
+        stop();
+    }
+    catch (const std::exception& ex) {
+        logger.error("Error stopping server: %s", ex.what());
+    }
+    epics::pvAccess::unregisterChannelProviderFactory(channelProviderFactory);
+}
+
+void PvaServer::initialize()
+{
+    // Servers are created from python, so that counter is protected by GIL
+    serverCounter++;
+    std::string providerName = ProviderNamePrefix + StringUtility::toString(serverCounter);
+    channelProvider.reset(new PvaServerChannelProviderImpl(providerName));
+    channelProviderFactory.reset(new PvaServerChannelProviderFactory(channelProvider));
+    epics::pvAccess::registerChannelProviderFactory(channelProviderFactory);
+    start();
+}
+
+void PvaServer::start()
+{
+    if (serverContext) {
+        logger.debug("Server is already running");
+        return;
+    }
+    std::string providerName = channelProvider->getProviderName();
+    logger.debug("Starting server for provider %s", providerName.c_str());
+    serverContext = epics::pvAccess::startPVAServer(providerName, 0, true, false);
+}
+
+void PvaServer::stop()
+{
+    if (!serverContext) {
+        logger.debug("Server is not running");
+        return;
+    }
+    logger.debug("Stopping server");
+
+    // Server threads do not need GIL, but they are waited for here
+    PyGilRelease pyGilRelease;
+    serverContext->destroy();
+    serverContext.reset();
+}
+
+void PvaServer::addRecord(const std::string& channelName, const PvObject& pvObject)
+{
+    channelProvider->addRecord(PvaServerRecordPtr(new PvaServerRecord(channelName, pvObject.getPvStructurePtr())));
+}
+
+void PvaServer::removeRecord(const std::string& channelName)
+{
+    if (!hasRecord(channelName)) {
+        throw ObjectNotFound("Record " + channelName + " does not exist.");
+    }
+    channelProvider->removeRecord(channelName);
+}
+
+bool PvaServer::hasRecord(const std::string& channelName)
+{
+    return (channelProvider->findRecord(channelName).get() != NULL);
+}
+
+boost::python::list PvaServer::getRecordNames()
+{
+    boost::python::list pyList;
+    std::vector<std::string> recordNames = channelProvider->getRecordNames();
+    std::vector<std::string>::const_iterator iter;
+    for (iter = recordNames.begin(); iter != recordNames.end(); iter++) {
+        pyList.append(*iter);
+    }
+    return pyList;
+}
+
+void PvaServer::update(const PvObject& pvObject)
+{
+    std::vector<std::string> recordNames = channelProvider->getRecordNames();
+    if (recordNames.size() != 1) {
+        throw InvalidRequest("Channel name must be specified for servers that do not publish exactly one record.");
+    }
+    update(recordNames[0], pvObject);
+}
+
+void PvaServer::update(const std::string& channelName, const PvObject& pvObject)
+{
+    PvaServerRecordPtr record = channelProvider->findRecord(channelName);
+    if (!record) {
+        throw ObjectNotFound("Record " + channelName + " does not exist.");
+    }
+
+    // Python object is copied into record with GIL held, as it may be
+    // modified by other python threads; monitor updates for all clients
+    // are then prepared without GIL, so that python threads are not
+    // blocked while they are sent
+    record->copyFrom(pvObject.getPvStructurePtr());
+    PyGilRelease pyGilRelease;
+    record->notifyMonitors();
+}
@@ -0,0 +1,61 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_H
+#define PVA_SERVER_H
+
+#include <string>
+#include "boost/python/list.hpp"
+#include "pv/pvAccess.h"
+#include "pv/serverContext.h"
+#include "PvObject.h"
+#include "PvaServerChannelProviderImpl.h"
+#include "InvalidArgument.h"
+#include "InvalidRequest.h"
+#include "ObjectNotFound.h"
+#include "PvaPyLogger.h"
+
+//
+// PV access server that publishes PV objects as channels. Each server
+// has its own channel provider, served by pvAccess server context that
+// runs in its own threads.
+//
+class PvaServer
+{
+public:
+    static const char* ProviderNamePrefix;
+
+    PvaServer();
+    PvaServer(const std::string& channelName, const PvObject& pvObject);
+    virtual ~PvaServer();
+
+    virtual void addRecord(const std::string& channelName, const PvObject& pvObject);
+    virtual void removeRecord(const std::string& channelName);
+    virtual bool hasRecord(const std::string& channelName);
+    virtual boost::python::list getRecordNames();
+
+    // Single record update may be used if server publishes one record only
+    virtual void update(const PvObject& pvObject);
+    virtual void update(const std::string& channelName, const PvObject& pvObject);
+
+    virtual void start();
+    virtual void stop();
+    virtual bool isRunning() const;
+
+private:
+    static PvaPyLogger logger;
+    static int serverCounter;
+
+    void initialize();
+
+    PvaServerChannelProviderImplPtr channelProvider;
+    epics::pvAccess::ChannelProviderFactory::shared_pointer channelProviderFactory;
+    epics::pvAccess::ServerContext::shared_pointer serverContext;
+};
+
+inline bool PvaServer::isRunning() const
+{
+    return (serverContext.get() != NULL);
+}
+
+#endif
@@ -0,0 +1,60 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "PvaServerChannelGetImpl.h"
+
+PvaServerChannelGetImpl::PvaServerChannelGetImpl(const epics::pvAccess::Channel::shared_pointer& channel_, const PvaServerRecordPtr& record_, const epics::pvAccess::ChannelGetRequester::shared_pointer& channelGetRequester_) :
+    channel(channel_),
+    record(record_),
+    channelGetRequester(channelGetRequester_),
+    pvStructurePtr(epics::pvData::getPVDataCreate()->createPVStructure(record_->getStructure())),
+    bitSetPtr(new epics::pvData::BitSet()),
+    mutex()
+{
+    // Entire structure is always sent
+    bitSetPtr->set(0);
+}
+
+PvaServerChannelGetImpl::~PvaServerChannelGetImpl()
+{
+}
+
+void PvaServerChannelGetImpl::get()
+{
+    // Request may be destroyed by another thread
+    epics::pvAccess::ChannelGetRequester::shared_pointer requester = getActiveRequester();
+    if (!requester) {
+        return;
+    }
+    record->copyTo(pvStructurePtr);
+    requester->getDone(epics::pvData::Status::Ok, shared_from_this(), pvStructurePtr, bitSetPtr);
+}
+
+epics::pvAccess::Channel::shared_pointer PvaServerChannelGetImpl::getChannel()
+{
+    epics::pvData::Lock lock(mutex);
+    return channel;
+}
+
+void PvaServerChannelGetImpl::cancel()
+{
+}
+
+void PvaServerChannelGetImpl::lastRequest()
+{
+}
+
+// Requester and channel hold references to this object, so they
+// must be released to break reference cycle
+void PvaServerChannelGetImpl::destroy()
+{
+    epics::pvData::Lock lock(mutex);
+    channelGetRequester.reset();
+    channel.reset();
+}
+
+epics::pvAccess::ChannelGetRequester::shared_pointer PvaServerChannelGetImpl::getActiveRequester()
+{
+    epics::pvData::Lock lock(mutex);
+    return channelGetRequester;
+}
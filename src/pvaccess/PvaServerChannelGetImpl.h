@@ -0,0 +1,38 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_CHANNEL_GET_IMPL_H
+#define PVA_SERVER_CHANNEL_GET_IMPL_H
+
+#include "pv/pvData.h"
+#include "pv/pvAccess.h"
+#include "PvaServerRecord.h"
+
+class PvaServerChannelGetImpl :
+    public epics::pvAccess::ChannelGet,
+    public std::tr1::enable_shared_from_this<PvaServerChannelGetImpl>
+{
+public:
+    POINTER_DEFINITIONS(PvaServerChannelGetImpl);
+
+    PvaServerChannelGetImpl(const epics::pvAccess::Channel::shared_pointer& channel, const PvaServerRecordPtr& record, const epics::pvAccess::ChannelGetRequester::shared_pointer& channelGetRequester);
+    virtual ~PvaServerChannelGetImpl();
+
+    virtual void get();
+    virtual epics::pvAccess::Channel::shared_pointer getChannel();
+    virtual void cancel();
+    virtual void lastRequest();
+    virtual void destroy();
+
+private:
+    epics::pvAccess::ChannelGetRequester::shared_pointer getActiveRequester();
+
+    epics::pvAccess::Channel::shared_pointer channel;
+    PvaServerRecordPtr record;
+    epics::pvAccess::ChannelGetRequester::shared_pointer channelGetRequester;
+    epics::pvData::PVStructurePtr pvStructurePtr;
+    epics::pvData::BitSet::shared_pointer bitSetPtr;
+    epics::pvData::Mutex mutex;
+};
+
+#endif
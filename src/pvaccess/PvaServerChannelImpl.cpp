@@ -0,0 +1,182 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "PvaServerChannelImpl.h"
+#include "PvaServerChannelGetImpl.h"
+#include "PvaServerChannelPutImpl.h"
+#include "PvaServerMonitorImpl.h"
+
+const epics::pvData::Status PvaServerChannelImpl::NotSupportedStatus(epics::pvData::Status::STATUSTYPE_ERROR, "Only get, put and monitor requests are supported by this channel");
+const epics::pvData::Status PvaServerChannelImpl::DestroyedStatus(epics::pvData::Status::STATUSTYPE_ERROR, "Channel destroyed");
+const epics::pvData::Status PvaServerChannelImpl::NoSuchFieldStatus(epics::pvData::Status::STATUSTYPE_ERROR, "No such field");
+
+PvaServerChannelImpl::PvaServerChannelImpl(const epics::pvAccess::ChannelProvider::shared_pointer& channelProvider_, const epics::pvAccess::ChannelRequester::shared_pointer& channelRequester_, const PvaServerRecordPtr& record_) :
+    destroyed(false),
+    channelProvider(channelProvider_),
+    channelRequester(channelRequester_),
+    record(record_)
+{
+}
+
+PvaServerChannelImpl::~PvaServerChannelImpl()
+{
+    destroy();
+}
+
+std::tr1::shared_ptr<epics::pvAccess::ChannelProvider> PvaServerChannelImpl::getProvider()
+{
+    return channelProvider;
+}
+
+std::string PvaServerChannelImpl::getRemoteAddress()
+{
+    return getChannelName();
+}
+
+epics::pvAccess::Channel::ConnectionState PvaServerChannelImpl::getConnectionState()
+{
+    return isConnected() ?
+        epics::pvAccess::Channel::CONNECTED :
+        epics::pvAccess::Channel::DESTROYED;
+}
+
+std::string PvaServerChannelImpl::getChannelName()
+{
+    return record->getRecordName();
+}
+
+std::tr1::shared_ptr<epics::pvAccess::ChannelRequester> PvaServerChannelImpl::getChannelRequester()
+{
+    return channelRequester;
+}
+
+bool PvaServerChannelImpl::isConnected()
+{
+    return !destroyed;
+}
+
+epics::pvAccess::AccessRights PvaServerChannelImpl::getAccessRights(const epics::pvData::PVField::shared_pointer& /*pvField*/)
+{
+    return epics::pvAccess::readWrite;
+}
+
+void PvaServerChannelImpl::getField(const epics::pvAccess::GetFieldRequester::shared_pointer& requester, const std::string& subField)
+{
+    epics::pvData::FieldConstPtr fieldPtr = record->getStructure();
+    if (!subField.empty()) {
+        fieldPtr = record->getStructure()->getField(subField);
+        if (!fieldPtr) {
+            requester->getDone(NoSuchFieldStatus, fieldPtr);
+            return;
+        }
+    }
+    requester->getDone(epics::pvData::Status::Ok, fieldPtr);
+}
+
+epics::pvAccess::ChannelProcess::shared_pointer PvaServerChannelImpl::createChannelProcess(
+    const epics::pvAccess::ChannelProcessRequester::shared_pointer& channelProcessRequester,
+    const epics::pvData::PVStructure::shared_pointer& /*pvRequest*/)
+{
+    epics::pvAccess::ChannelProcess::shared_pointer nullPtr;
+    channelProcessRequester->channelProcessConnect(NotSupportedStatus, nullPtr);
+    return nullPtr;
+}
+
+epics::pvAccess::ChannelGet::shared_pointer PvaServerChannelImpl::createChannelGet(
+    const epics::pvAccess::ChannelGetRequester::shared_pointer& channelGetRequester,
+    const epics::pvData::PVStructure::shared_pointer& /*pvRequest*/)
+{
+    if (destroyed) {
+        epics::pvAccess::ChannelGet::shared_pointer nullPtr;
+        channelGetRequester->channelGetConnect(DestroyedStatus, nullPtr, epics::pvData::Structure::const_shared_pointer());
+        return nullPtr;
+    }
+
+    epics::pvAccess::ChannelGet::shared_pointer channelGet(new PvaServerChannelGetImpl(shared_from_this(), record, channelGetRequester));
+    channelGetRequester->channelGetConnect(epics::pvData::Status::Ok, channelGet, record->getStructure());
+    return channelGet;
+}
+
+epics::pvAccess::ChannelPut::shared_pointer PvaServerChannelImpl::createChannelPut(
+    const epics::pvAccess::ChannelPutRequester::shared_pointer& channelPutRequester,
+    const epics::pvData::PVStructure::shared_pointer& /*pvRequest*/)
+{
+    if (destroyed) {
+        epics::pvAccess::ChannelPut::shared_pointer nullPtr;
+        channelPutRequester->channelPutConnect(DestroyedStatus, nullPtr, epics::pvData::Structure::const_shared_pointer());
+        return nullPtr;
+    }
+
+    epics::pvAccess::ChannelPut::shared_pointer channelPut(new PvaServerChannelPutImpl(shared_from_this(), record, channelPutRequester));
+    channelPutRequester->channelPutConnect(epics::pvData::Status::Ok, channelPut, record->getStructure());
+    return channelPut;
+}
+
+epics::pvAccess::ChannelPutGet::shared_pointer PvaServerChannelImpl::createChannelPutGet(
+    const epics::pvAccess::ChannelPutGetRequester::shared_pointer& channelPutGetRequester,
+    const epics::pvData::PVStructure::shared_pointer& /*pvRequest*/)
+{
+    epics::pvAccess::ChannelPutGet::shared_pointer nullPtr;
+    epics::pvData::Structure::const_shared_pointer nullStructure;
+    channelPutGetRequester->channelPutGetConnect(NotSupportedStatus, nullPtr, nullStructure, nullStructure);
+    return nullPtr;
+}
+
+epics::pvAccess::ChannelRPC::shared_pointer PvaServerChannelImpl::createChannelRPC(
+    const epics::pvAccess::ChannelRPCRequester::shared_pointer& channelRPCRequester,
+    const epics::pvData::PVStructure::shared_pointer& /*pvRequest*/)
+{
+    epics::pvAccess::ChannelRPC::shared_pointer nullPtr;
+    channelRPCRequester->channelRPCConnect(NotSupportedStatus, nullPtr);
+    return nullPtr;
+}
+
+epics::pvData::Monitor::shared_pointer PvaServerChannelImpl::createMonitor(
+    const epics::pvData::MonitorRequester::shared_pointer& monitorRequester,
+    const epics::pvData::PVStructure::shared_pointer& pvRequest)
+{
+    if (destroyed) {
+        epics::pvData::Monitor::shared_pointer nullPtr;
+        monitorRequester->monitorConnect(DestroyedStatus, nullPtr, epics::pvData::Structure::const_shared_pointer());
+        return nullPtr;
+    }
+
+    PvaServerMonitorImplPtr monitor(new PvaServerMonitorImpl(record, monitorRequester, PvaServerMonitorImpl::getQueueSize(pvRequest)));
+    record->addMonitor(monitor);
+    monitorRequester->monitorConnect(epics::pvData::Status::Ok, monitor, record->getStructure());
+    return monitor;
+}
+
+epics::pvAccess::ChannelArray::shared_pointer PvaServerChannelImpl::createChannelArray(
+    const epics::pvAccess::ChannelArrayRequester::shared_pointer& channelArrayRequester,
+    const epics::pvData::PVStructure::shared_pointer& /*pvRequest*/)
+{
+    epics::pvAccess::ChannelArray::shared_pointer nullPtr;
+    channelArrayRequester->channelArrayConnect(NotSupportedStatus, nullPtr, epics::pvData::Array::const_shared_pointer());
+    return nullPtr;
+}
+
+void PvaServerChannelImpl::printInfo()
+{
+    printInfo(std::cout);
+}
+
+void PvaServerChannelImpl::printInfo(std::ostream& out)
+{
+    out << "PvaServerChannelImpl: " << getChannelName() << " [" << epics::pvAccess::Channel::ConnectionStateNames[getConnectionState()] << "]" << std::endl;
+}
+
+std::string PvaServerChannelImpl::getRequesterName()
+{
+    return getChannelName();
+}
+
+void PvaServerChannelImpl::message(const std::string& message, epics::pvData::MessageType messageType)
+{
+    channelRequester->message(message, messageType);
+}
+
+void PvaServerChannelImpl::destroy()
+{
+    destroyed = true;
+}
@@ -0,0 +1,75 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_CHANNEL_IMPL_H
+#define PVA_SERVER_CHANNEL_IMPL_H
+
+#include <string>
+#include <iostream>
+#include "pv/pvData.h"
+#include "pv/pvAccess.h"
+#include "PvaServerRecord.h"
+
+//
+// Channel to a PvaServer record. Get, put and monitor requests always
+// work with the entire record structure.
+//
+class PvaServerChannelImpl :
+    public epics::pvAccess::Channel,
+    public std::tr1::enable_shared_from_this<PvaServerChannelImpl>
+{
+public:
+    POINTER_DEFINITIONS(PvaServerChannelImpl);
+
+    PvaServerChannelImpl(const epics::pvAccess::ChannelProvider::shared_pointer& channelProvider, const epics::pvAccess::ChannelRequester::shared_pointer& channelRequester, const PvaServerRecordPtr& record);
+    virtual ~PvaServerChannelImpl();
+    virtual std::tr1::shared_ptr<epics::pvAccess::ChannelProvider> getProvider();
+    virtual std::tr1::shared_ptr<epics::pvAccess::ChannelRequester> getChannelRequester();
+    virtual std::string getRemoteAddress();
+    virtual std::string getChannelName();
+    virtual std::string getRequesterName();
+    virtual epics::pvAccess::Channel::ConnectionState getConnectionState();
+    virtual bool isConnected();
+
+    virtual epics::pvAccess::AccessRights getAccessRights(const epics::pvData::PVField::shared_pointer& pvField);
+    virtual void getField(const epics::pvAccess::GetFieldRequester::shared_pointer& requester, const std::string& subField);
+
+    virtual epics::pvAccess::ChannelProcess::shared_pointer createChannelProcess(
+        const epics::pvAccess::ChannelProcessRequester::shared_pointer& channelProcessRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+    virtual epics::pvAccess::ChannelGet::shared_pointer createChannelGet(
+        const epics::pvAccess::ChannelGetRequester::shared_pointer& channelGetRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+    virtual epics::pvAccess::ChannelPut::shared_pointer createChannelPut(
+        const epics::pvAccess::ChannelPutRequester::shared_pointer& channelPutRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+    virtual epics::pvAccess::ChannelPutGet::shared_pointer createChannelPutGet(
+        const epics::pvAccess::ChannelPutGetRequester::shared_pointer& channelPutGetRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+    virtual epics::pvAccess::ChannelRPC::shared_pointer createChannelRPC(
+        const epics::pvAccess::ChannelRPCRequester::shared_pointer& channelRPCRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+    virtual epics::pvData::Monitor::shared_pointer createMonitor(
+        const epics::pvData::MonitorRequester::shared_pointer& monitorRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+    virtual epics::pvAccess::ChannelArray::shared_pointer createChannelArray(
+        const epics::pvAccess::ChannelArrayRequester::shared_pointer& channelArrayRequester,
+        const epics::pvData::PVStructure::shared_pointer& pvRequest);
+
+    virtual void printInfo();
+    virtual void printInfo(std::ostream& out);
+    virtual void message(const std::string& message, epics::pvData::MessageType messageType);
+    virtual void destroy();
+
+private:
+    static const epics::pvData::Status NotSupportedStatus;
+    static const epics::pvData::Status DestroyedStatus;
+    static const epics::pvData::Status NoSuchFieldStatus;
+
+    bool destroyed;
+    epics::pvAccess::ChannelProvider::shared_pointer channelProvider;
+    epics::pvAccess::ChannelRequester::shared_pointer channelRequester;
+    PvaServerRecordPtr record;
+};
+
+#endif
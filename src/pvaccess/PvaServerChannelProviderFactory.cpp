@@ -0,0 +1,28 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "PvaServerChannelProviderFactory.h"
+
+PvaServerChannelProviderFactory::PvaServerChannelProviderFactory(const PvaServerChannelProviderImplPtr& channelProviderImpl_) :
+    channelProviderImpl(channelProviderImpl_)
+{
+}
+
+PvaServerChannelProviderFactory::~PvaServerChannelProviderFactory()
+{
+}
+
+std::string PvaServerChannelProviderFactory::getFactoryName()
+{
+    return channelProviderImpl->getProviderName();
+}
+
+epics::pvAccess::ChannelProvider::shared_pointer PvaServerChannelProviderFactory::sharedInstance()
+{
+    return channelProviderImpl;
+}
+
+epics::pvAccess::ChannelProvider::shared_pointer PvaServerChannelProviderFactory::newInstance()
+{
+    return channelProviderImpl;
+}
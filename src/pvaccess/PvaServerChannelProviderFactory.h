@@ -0,0 +1,28 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_CHANNEL_PROVIDER_FACTORY_H
+#define PVA_SERVER_CHANNEL_PROVIDER_FACTORY_H
+
+#include "pv/pvAccess.h"
+#include "PvaServerChannelProviderImpl.h"
+
+//
+// Each PvaServer registers its own provider, so that new and shared
+// provider instances are the same.
+//
+class PvaServerChannelProviderFactory : public epics::pvAccess::ChannelProviderFactory
+{
+public:
+    POINTER_DEFINITIONS(PvaServerChannelProviderFactory);
+
+    PvaServerChannelProviderFactory(const PvaServerChannelProviderImplPtr& channelProviderImpl);
+    virtual ~PvaServerChannelProviderFactory();
+    virtual std::string getFactoryName();
+    virtual epics::pvAccess::ChannelProvider::shared_pointer sharedInstance();
+    virtual epics::pvAccess::ChannelProvider::shared_pointer newInstance();
+private:
+    PvaServerChannelProviderImplPtr channelProviderImpl;
+};
+
+#endif
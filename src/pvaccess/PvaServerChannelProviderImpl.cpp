@@ -0,0 +1,116 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "PvaServerChannelProviderImpl.h"
+#include "PvaServerChannelImpl.h"
+
+const epics::pvData::Status PvaServerChannelProviderImpl::NoSuchChannelStatus(epics::pvData::Status::STATUSTYPE_ERROR, "No such channel");
+
+PvaServerChannelProviderImpl::PvaServerChannelProviderImpl(const std::string& providerName_) :
+    providerName(providerName_),
+    recordMap(),
+    mutex()
+{
+}
+
+PvaServerChannelProviderImpl::~PvaServerChannelProviderImpl()
+{
+}
+
+std::string PvaServerChannelProviderImpl::getProviderName()
+{
+    return providerName;
+}
+
+std::tr1::shared_ptr<epics::pvAccess::ChannelProvider> PvaServerChannelProviderImpl::getChannelProvider()
+{
+    return shared_from_this();
+}
+
+void PvaServerChannelProviderImpl::cancel()
+{
+}
+
+void PvaServerChannelProviderImpl::destroy()
+{
+}
+
+epics::pvAccess::ChannelFind::shared_pointer PvaServerChannelProviderImpl::channelFind(const std::string& channelName, const epics::pvAccess::ChannelFindRequester::shared_pointer& channelFindRequester)
+{
+    bool found = (findRecord(channelName).get() != NULL);
+    epics::pvAccess::ChannelFind::shared_pointer thisPtr(shared_from_this());
+    channelFindRequester->channelFindResult(epics::pvData::Status::Ok, thisPtr, found);
+    return thisPtr;
+}
+
+epics::pvAccess::ChannelFind::shared_pointer PvaServerChannelProviderImpl::channelList(const epics::pvAccess::ChannelListRequester::shared_pointer& channelListRequester)
+{
+    std::vector<std::string> recordNames = getRecordNames();
+    epics::pvData::PVStringArray::svector channelNames(recordNames.begin(), recordNames.end());
+    epics::pvAccess::ChannelFind::shared_pointer thisPtr(shared_from_this());
+    channelListRequester->channelListResult(epics::pvData::Status::Ok, thisPtr, epics::pvData::freeze(channelNames), false);
+    return thisPtr;
+}
+
+epics::pvAccess::Channel::shared_pointer PvaServerChannelProviderImpl::createChannel(
+    const std::string& channelName,
+    const epics::pvAccess::ChannelRequester::shared_pointer& channelRequester,
+    short /*priority*/)
+{
+    PvaServerRecordPtr record = findRecord(channelName);
+    if (!record) {
+        epics::pvAccess::Channel::shared_pointer nullChannel;
+        channelRequester->channelCreated(NoSuchChannelStatus, nullChannel);
+        return nullChannel;
+    }
+
+    epics::pvAccess::Channel::shared_pointer channel(new PvaServerChannelImpl(
+        shared_from_this(),
+        channelRequester,
+        record));
+    channelRequester->channelCreated(epics::pvData::Status::Ok, channel);
+    return channel;
+}
+
+epics::pvAccess::Channel::shared_pointer PvaServerChannelProviderImpl::createChannel(
+    const std::string& channelName,
+    const epics::pvAccess::ChannelRequester::shared_pointer& channelRequester,
+    short priority,
+    const std::string& /*address*/)
+{
+    // Records are local, so that address is not used
+    return createChannel(channelName, channelRequester, priority);
+}
+
+void PvaServerChannelProviderImpl::addRecord(const PvaServerRecordPtr& record)
+{
+    epics::pvData::Lock guard(mutex);
+    recordMap[record->getRecordName()] = record;
+}
+
+void PvaServerChannelProviderImpl::removeRecord(const std::string& recordName)
+{
+    epics::pvData::Lock guard(mutex);
+    recordMap.erase(recordName);
+}
+
+PvaServerRecordPtr PvaServerChannelProviderImpl::findRecord(const std::string& recordName)
+{
+    epics::pvData::Lock guard(mutex);
+    PvaServerRecordMap::const_iterator iter = recordMap.find(recordName);
+    if (iter == recordMap.end()) {
+        return PvaServerRecordPtr();
+    }
+    return iter->second;
+}
+
+std::vector<std::string> PvaServerChannelProviderImpl::getRecordNames()
+{
+    epics::pvData::Lock guard(mutex);
+    std::vector<std::string> recordNames;
+    PvaServerRecordMap::const_iterator iter;
+    for (iter = recordMap.begin(); iter != recordMap.end(); iter++) {
+        recordNames.push_back(iter->first);
+    }
+    return recordNames;
+}
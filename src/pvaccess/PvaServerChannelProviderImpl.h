@@ -0,0 +1,57 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_CHANNEL_PROVIDER_IMPL_H
+#define PVA_SERVER_CHANNEL_PROVIDER_IMPL_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include "pv/pvData.h"
+#include "pv/pvAccess.h"
+#include "PvaServerRecord.h"
+
+class PvaServerChannelProviderImpl :
+    public virtual epics::pvAccess::ChannelProvider,
+    public virtual epics::pvAccess::ChannelFind,
+    public std::tr1::enable_shared_from_this<PvaServerChannelProviderImpl>
+{
+public:
+    POINTER_DEFINITIONS(PvaServerChannelProviderImpl);
+
+    static const epics::pvData::Status NoSuchChannelStatus;
+
+    PvaServerChannelProviderImpl(const std::string& providerName);
+    virtual ~PvaServerChannelProviderImpl();
+    virtual std::string getProviderName();
+    virtual std::tr1::shared_ptr<epics::pvAccess::ChannelProvider> getChannelProvider();
+    virtual void cancel();
+    virtual void destroy();
+    virtual epics::pvAccess::ChannelFind::shared_pointer channelFind(const std::string& channelName, const epics::pvAccess::ChannelFindRequester::shared_pointer& channelFindRequester);
+    virtual epics::pvAccess::ChannelFind::shared_pointer channelList(const epics::pvAccess::ChannelListRequester::shared_pointer& channelListRequester);
+    virtual epics::pvAccess::Channel::shared_pointer createChannel(
+        const std::string& channelName,
+        const epics::pvAccess::ChannelRequester::shared_pointer& channelRequester,
+        short priority);
+    virtual epics::pvAccess::Channel::shared_pointer createChannel(
+        const std::string& channelName,
+        const epics::pvAccess::ChannelRequester::shared_pointer& channelRequester,
+        short priority,
+        const std::string& address);
+
+    void addRecord(const PvaServerRecordPtr& record);
+    void removeRecord(const std::string& recordName);
+    PvaServerRecordPtr findRecord(const std::string& recordName);
+    std::vector<std::string> getRecordNames();
+
+private:
+    typedef std::map<std::string, PvaServerRecordPtr> PvaServerRecordMap;
+
+    std::string providerName;
+    PvaServerRecordMap recordMap;
+    epics::pvData::Mutex mutex;
+};
+
+typedef PvaServerChannelProviderImpl::shared_pointer PvaServerChannelProviderImplPtr;
+
+#endif
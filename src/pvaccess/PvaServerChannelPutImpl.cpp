@@ -0,0 +1,72 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "PvaServerChannelPutImpl.h"
+
+PvaServerChannelPutImpl::PvaServerChannelPutImpl(const epics::pvAccess::Channel::shared_pointer& channel_, const PvaServerRecordPtr& record_, const epics::pvAccess::ChannelPutRequester::shared_pointer& channelPutRequester_) :
+    channel(channel_),
+    record(record_),
+    channelPutRequester(channelPutRequester_),
+    pvStructurePtr(epics::pvData::getPVDataCreate()->createPVStructure(record_->getStructure())),
+    bitSetPtr(new epics::pvData::BitSet()),
+    mutex()
+{
+    bitSetPtr->set(0);
+}
+
+PvaServerChannelPutImpl::~PvaServerChannelPutImpl()
+{
+}
+
+void PvaServerChannelPutImpl::put(const epics::pvData::PVStructurePtr& pvPutStructure, const epics::pvData::BitSet::shared_pointer& putBitSet)
+{
+    // Request may be destroyed by another thread
+    epics::pvAccess::ChannelPutRequester::shared_pointer requester = getActiveRequester();
+    if (!requester) {
+        return;
+    }
+
+    // Only fields set by the client are copied, and reported as changed
+    // to record monitors
+    record->update(pvPutStructure, *putBitSet);
+    requester->putDone(epics::pvData::Status::Ok, shared_from_this());
+}
+
+void PvaServerChannelPutImpl::get()
+{
+    epics::pvAccess::ChannelPutRequester::shared_pointer requester = getActiveRequester();
+    if (!requester) {
+        return;
+    }
+    record->copyTo(pvStructurePtr);
+    requester->getDone(epics::pvData::Status::Ok, shared_from_this(), pvStructurePtr, bitSetPtr);
+}
+
+epics::pvAccess::Channel::shared_pointer PvaServerChannelPutImpl::getChannel()
+{
+    epics::pvData::Lock lock(mutex);
+    return channel;
+}
+
+void PvaServerChannelPutImpl::cancel()
+{
+}
+
+void PvaServerChannelPutImpl::lastRequest()
+{
+}
+
+// Requester and channel hold references to this object, so they
+// must be released to break reference cycle
+void PvaServerChannelPutImpl::destroy()
+{
+    epics::pvData::Lock lock(mutex);
+    channelPutRequester.reset();
+    channel.reset();
+}
+
+epics::pvAccess::ChannelPutRequester::shared_pointer PvaServerChannelPutImpl::getActiveRequester()
+{
+    epics::pvData::Lock lock(mutex);
+    return channelPutRequester;
+}
@@ -0,0 +1,39 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_CHANNEL_PUT_IMPL_H
+#define PVA_SERVER_CHANNEL_PUT_IMPL_H
+
+#include "pv/pvData.h"
+#include "pv/pvAccess.h"
+#include "PvaServerRecord.h"
+
+class PvaServerChannelPutImpl :
+    public epics::pvAccess::ChannelPut,
+    public std::tr1::enable_shared_from_this<PvaServerChannelPutImpl>
+{
+public:
+    POINTER_DEFINITIONS(PvaServerChannelPutImpl);
+
+    PvaServerChannelPutImpl(const epics::pvAccess::Channel::shared_pointer& channel, const PvaServerRecordPtr& record, const epics::pvAccess::ChannelPutRequester::shared_pointer& channelPutRequester);
+    virtual ~PvaServerChannelPutImpl();
+
+    virtual void put(const epics::pvData::PVStructurePtr& pvPutStructure, const epics::pvData::BitSet::shared_pointer& putBitSet);
+    virtual void get();
+    virtual epics::pvAccess::Channel::shared_pointer getChannel();
+    virtual void cancel();
+    virtual void lastRequest();
+    virtual void destroy();
+
+private:
+    epics::pvAccess::ChannelPutRequester::shared_pointer getActiveRequester();
+
+    epics::pvAccess::Channel::shared_pointer channel;
+    PvaServerRecordPtr record;
+    epics::pvAccess::ChannelPutRequester::shared_pointer channelPutRequester;
+    epics::pvData::PVStructurePtr pvStructurePtr;
+    epics::pvData::BitSet::shared_pointer bitSetPtr;
+    epics::pvData::Mutex mutex;
+};
+
+#endif
@@ -0,0 +1,193 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include <cstdlib>
+#include "pv/convert.h"
+#include "PvaServerMonitorImpl.h"
+
+const int PvaServerMonitorImpl::DefaultQueueSize(2);
+const int PvaServerMonitorImpl::MinQueueSize(2);
+
+PvaPyLogger PvaServerMonitorImpl::logger("PvaServerMonitorImpl");
+
+PvaServerMonitorImpl::PvaServerMonitorImpl(const PvaServerRecordPtr& record_, const epics::pvData::MonitorRequester::shared_pointer& monitorRequester_, int queueSize) :
+    record(record_),
+    monitorRequester(monitorRequester_),
+    activeElement(),
+    activeElementChanged(false),
+    freeElements(),
+    queuedElements(),
+    active(false),
+    destroyed(false),
+    mutex()
+{
+    if (queueSize < MinQueueSize) {
+        queueSize = MinQueueSize;
+    }
+    epics::pvData::StructureConstPtr structurePtr = record->getStructure();
+    for (int i = 0; i < queueSize; i++) {
+        epics::pvData::PVStructurePtr pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(structurePtr);
+        freeElements.push_back(epics::pvData::MonitorElement::shared_pointer(new epics::pvData::MonitorElement(pvStructurePtr)));
+    }
+    activeElement = freeElements.front();
+    freeElements.pop_front();
+}
+
+PvaServerMonitorImpl::~PvaServerMonitorImpl()
+{
+}
+
+int PvaServerMonitorImpl::getQueueSize(const epics::pvData::PVStructurePtr& pvRequest)
+{
+    if (!pvRequest) {
+        return DefaultQueueSize;
+    }
+    epics::pvData::PVStringPtr pvQueueSize = pvRequest->getSubField<epics::pvData::PVString>("record._options.queueSize");
+    if (!pvQueueSize) {
+        return DefaultQueueSize;
+    }
+    int queueSize = atoi(pvQueueSize->get().c_str());
+    if (queueSize < MinQueueSize) {
+        return MinQueueSize;
+    }
+    return queueSize;
+}
+
+epics::pvData::Status PvaServerMonitorImpl::start()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        if (destroyed) {
+            return epics::pvData::Status(epics::pvData::Status::STATUSTYPE_ERROR, "Monitor destroyed");
+        }
+        if (active) {
+            return epics::pvData::Status::Ok;
+        }
+    }
+    record->startMonitor(shared_from_this());
+    return epics::pvData::Status::Ok;
+}
+
+epics::pvData::Status PvaServerMonitorImpl::stop()
+{
+    epics::pvData::Lock lock(mutex);
+    active = false;
+    activeElementChanged = false;
+    while (!queuedElements.empty()) {
+        freeElements.push_back(queuedElements.front());
+        queuedElements.pop_front();
+    }
+    return epics::pvData::Status::Ok;
+}
+
+epics::pvData::MonitorElement::shared_pointer PvaServerMonitorImpl::poll()
+{
+    epics::pvData::Lock lock(mutex);
+    if (queuedElements.empty()) {
+        return epics::pvData::MonitorElement::shared_pointer();
+    }
+    epics::pvData::MonitorElement::shared_pointer element = queuedElements.front();
+    queuedElements.pop_front();
+    return element;
+}
+
+void PvaServerMonitorImpl::release(const epics::pvData::MonitorElement::shared_pointer& monitorElement)
+{
+    epics::pvData::MonitorRequester::shared_pointer requester;
+    {
+        epics::pvData::Lock lock(mutex);
+        if (destroyed) {
+            return;
+        }
+        freeElements.push_back(monitorElement);
+
+        // Updates accumulated while all elements were in use
+        if (!active || !queueActiveElement()) {
+            return;
+        }
+        requester = monitorRequester;
+    }
+    requester->monitorEvent(shared_from_this());
+}
+
+void PvaServerMonitorImpl::destroy()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        if (destroyed) {
+            return;
+        }
+        destroyed = true;
+        active = false;
+        queuedElements.clear();
+        freeElements.clear();
+        monitorRequester.reset();
+    }
+    record->removeMonitor(this);
+}
+
+void PvaServerMonitorImpl::activate(const epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    epics::pvData::MonitorRequester::shared_pointer requester;
+    {
+        epics::pvData::Lock lock(mutex);
+        if (destroyed || active) {
+            return;
+        }
+        active = true;
+
+        // The first element contains entire structure
+        epics::pvData::getConvert()->copyStructure(pvStructurePtr, activeElement->pvStructurePtr);
+        activeElement->changedBitSet->clear();
+        activeElement->changedBitSet->set(0);
+        activeElement->overrunBitSet->clear();
+        activeElementChanged = true;
+        if (!queueActiveElement()) {
+            return;
+        }
+        requester = monitorRequester;
+    }
+    requester->monitorEvent(shared_from_this());
+}
+
+void PvaServerMonitorImpl::notify(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& changedBitSet)
+{
+    epics::pvData::MonitorRequester::shared_pointer requester;
+    {
+        epics::pvData::Lock lock(mutex);
+        if (!active) {
+            return;
+        }
+
+        // Active element may have been queued before, so that it has to
+        // be brought up to date entirely; array data is shared
+        epics::pvData::getConvert()->copyStructure(pvStructurePtr, activeElement->pvStructurePtr);
+        epics::pvData::BitSet overrunBitSet(changedBitSet);
+        overrunBitSet &= *(activeElement->changedBitSet);
+        *(activeElement->overrunBitSet) |= overrunBitSet;
+        *(activeElement->changedBitSet) |= changedBitSet;
+        activeElementChanged = true;
+        if (!queueActiveElement()) {
+            logger.trace("All monitor elements are in use, record %s update will be reported with the next one", record->getRecordName().c_str());
+            return;
+        }
+        requester = monitorRequester;
+    }
+    requester->monitorEvent(shared_from_this());
+}
+
+// Must be called with mutex held; returns true if requester should be
+// notified about queued element
+bool PvaServerMonitorImpl::queueActiveElement()
+{
+    if (!activeElementChanged || freeElements.empty()) {
+        return false;
+    }
+    queuedElements.push_back(activeElement);
+    activeElement = freeElements.front();
+    freeElements.pop_front();
+    activeElement->changedBitSet->clear();
+    activeElement->overrunBitSet->clear();
+    activeElementChanged = false;
+    return true;
+}
@@ -0,0 +1,66 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_MONITOR_IMPL_H
+#define PVA_SERVER_MONITOR_IMPL_H
+
+#include <deque>
+#include "pv/pvData.h"
+#include "pv/bitSet.h"
+#include "pv/monitor.h"
+#include "PvaServerRecord.h"
+
+//
+// Monitor of a PvaServer record.
+//
+// One of the monitor elements is always active, and receives copies of
+// all record updates. Active element is queued for the requester as soon
+// as there is a free element to replace it. Otherwise, it accumulates
+// updates until requester releases one of the queued elements, and fields
+// changed more than once are reported as overrun.
+//
+class PvaServerMonitorImpl :
+    public epics::pvData::Monitor,
+    public std::tr1::enable_shared_from_this<PvaServerMonitorImpl>
+{
+public:
+    POINTER_DEFINITIONS(PvaServerMonitorImpl);
+
+    static const int DefaultQueueSize;
+    static const int MinQueueSize;
+
+    PvaServerMonitorImpl(const PvaServerRecordPtr& record, const epics::pvData::MonitorRequester::shared_pointer& monitorRequester, int queueSize=DefaultQueueSize);
+    virtual ~PvaServerMonitorImpl();
+
+    virtual epics::pvData::Status start();
+    virtual epics::pvData::Status stop();
+    virtual epics::pvData::MonitorElement::shared_pointer poll();
+    virtual void release(const epics::pvData::MonitorElement::shared_pointer& monitorElement);
+    virtual void destroy();
+
+    // Called by record with its lock held
+    void activate(const epics::pvData::PVStructurePtr& pvStructurePtr);
+    void notify(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& changedBitSet);
+
+    // Queue size is given by record._options.queueSize request option
+    static int getQueueSize(const epics::pvData::PVStructurePtr& pvRequest);
+
+private:
+    static PvaPyLogger logger;
+
+    bool queueActiveElement();
+
+    PvaServerRecordPtr record;
+    epics::pvData::MonitorRequester::shared_pointer monitorRequester;
+    epics::pvData::MonitorElement::shared_pointer activeElement;
+    bool activeElementChanged;
+    std::deque<epics::pvData::MonitorElement::shared_pointer> freeElements;
+    std::deque<epics::pvData::MonitorElement::shared_pointer> queuedElements;
+    bool active;
+    bool destroyed;
+    epics::pvData::Mutex mutex;
+};
+
+typedef PvaServerMonitorImpl::shared_pointer PvaServerMonitorImplPtr;
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "pv/convert.h"
+#include "PvaServerRecord.h"
+#include "PvaServerMonitorImpl.h"
+#include "PvUtility.h"
+
+PvaPyLogger PvaServerRecord::logger("PvaServerRecord");
+
+PvaServerRecord::PvaServerRecord(const std::string& recordName_, const epics::pvData::PVStructurePtr& pvStructurePtr_) :
+    recordName(recordName_),
+    pvStructurePtr(epics::pvData::getPVDataCreate()->createPVStructure(pvStructurePtr_)),
+    allChangedBitSet(),
+    monitors(),
+    mutex()
+{
+    allChangedBitSet.set(0);
+}
+
+PvaServerRecord::~PvaServerRecord()
+{
+}
+
+void PvaServerRecord::copyTo(const epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    epics::pvData::Lock lock(mutex);
+    epics::pvData::getConvert()->copyStructure(this->pvStructurePtr, pvStructurePtr);
+}
+
+void PvaServerRecord::update(const epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    checkStructure(pvStructurePtr);
+    epics::pvData::Lock lock(mutex);
+    epics::pvData::getConvert()->copyStructure(pvStructurePtr, this->pvStructurePtr);
+    notifyMonitors(allChangedBitSet);
+}
+
+void PvaServerRecord::copyFrom(const epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    checkStructure(pvStructurePtr);
+    epics::pvData::Lock lock(mutex);
+    epics::pvData::getConvert()->copyStructure(pvStructurePtr, this->pvStructurePtr);
+}
+
+void PvaServerRecord::notifyMonitors()
+{
+    epics::pvData::Lock lock(mutex);
+    notifyMonitors(allChangedBitSet);
+}
+
+void PvaServerRecord::checkStructure(const epics::pvData::PVStructurePtr& pvStructurePtr) const
+{
+    epics::pvData::StructureConstPtr structurePtr = pvStructurePtr->getStructure();
+    epics::pvData::StructureConstPtr recordStructurePtr = getStructure();
+    if (structurePtr != recordStructurePtr && !(*structurePtr == *recordStructurePtr)) {
+        throw InvalidArgument("PV object structure does not match structure of record %s.", recordName.c_str());
+    }
+}
+
+void PvaServerRecord::update(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& changedBitSet)
+{
+    epics::pvData::Lock lock(mutex);
+    PvUtility::copyChangedFields(pvStructurePtr, this->pvStructurePtr, changedBitSet);
+    notifyMonitors(changedBitSet);
+}
+
+void PvaServerRecord::addMonitor(const std::tr1::shared_ptr<PvaServerMonitorImpl>& monitor)
+{
+    epics::pvData::Lock lock(mutex);
+    monitors.push_back(monitor);
+    logger.debug("Added monitor for record %s, number of monitors is %d", recordName.c_str(), int(monitors.size()));
+}
+
+void PvaServerRecord::removeMonitor(const PvaServerMonitorImpl* monitor)
+{
+    epics::pvData::Lock lock(mutex);
+    std::vector<std::tr1::weak_ptr<PvaServerMonitorImpl> >::iterator iter = monitors.begin();
+    while (iter != monitors.end()) {
+        PvaServerMonitorImplPtr monitorPtr = iter->lock();
+        if (!monitorPtr || monitorPtr.get() == monitor) {
+            iter = monitors.erase(iter);
+        }
+        else {
+            iter++;
+        }
+    }
+    logger.debug("Removed monitor for record %s, number of monitors is %d", recordName.c_str(), int(monitors.size()));
+}
+
+void PvaServerRecord::startMonitor(const std::tr1::shared_ptr<PvaServerMonitorImpl>& monitor)
+{
+    // Monitor must receive the current value before any further updates
+    epics::pvData::Lock lock(mutex);
+    monitor->activate(pvStructurePtr);
+}
+
+// Must be called with mutex held
+void PvaServerRecord::notifyMonitors(const epics::pvData::BitSet& changedBitSet)
+{
+    std::vector<std::tr1::weak_ptr<PvaServerMonitorImpl> >::iterator iter = monitors.begin();
+    while (iter != monitors.end()) {
+        PvaServerMonitorImplPtr monitorPtr = iter->lock();
+        if (!monitorPtr) {
+            iter = monitors.erase(iter);
+            continue;
+        }
+        monitorPtr->notify(pvStructurePtr, changedBitSet);
+        iter++;
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PVA_SERVER_RECORD_H
+#define PVA_SERVER_RECORD_H
+
+#include <string>
+#include <vector>
+#include "pv/pvData.h"
+#include "pv/bitSet.h"
+#include "InvalidArgument.h"
+#include "PvaPyLogger.h"
+
+class PvaServerMonitorImpl;
+
+//
+// PV published by PvaServer. Record holds current value of the channel
+// structure, and passes its updates to all active channel monitors.
+//
+class PvaServerRecord
+{
+public:
+    POINTER_DEFINITIONS(PvaServerRecord);
+
+    PvaServerRecord(const std::string& recordName, const epics::pvData::PVStructurePtr& pvStructurePtr);
+    virtual ~PvaServerRecord();
+
+    std::string getRecordName() const;
+    epics::pvData::StructureConstPtr getStructure() const;
+
+    // Copies current value into structure of the same type
+    void copyTo(const epics::pvData::PVStructurePtr& pvStructurePtr);
+
+    // Replaces entire value; source structure must be of the same type
+    void update(const epics::pvData::PVStructurePtr& pvStructurePtr);
+
+    // Copies fields marked in bit set from structure of the same type
+    void update(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& changedBitSet);
+
+    // Replaces entire value without notifying monitors, which allows
+    // callers to copy and notify under different locks (e.g., GIL)
+    void copyFrom(const epics::pvData::PVStructurePtr& pvStructurePtr);
+
+    // Passes current value to all active monitors
+    void notifyMonitors();
+
+    void addMonitor(const std::tr1::shared_ptr<PvaServerMonitorImpl>& monitor);
+    void removeMonitor(const PvaServerMonitorImpl* monitor);
+
+    // Activates monitor with the current record value
+    void startMonitor(const std::tr1::shared_ptr<PvaServerMonitorImpl>& monitor);
+
+private:
+    static PvaPyLogger logger;
+
+    void notifyMonitors(const epics::pvData::BitSet& changedBitSet);
+    void checkStructure(const epics::pvData::PVStructurePtr& pvStructurePtr) const;
+
+    std::string recordName;
+    epics::pvData::PVStructurePtr pvStructurePtr;
+    epics::pvData::BitSet allChangedBitSet;
+    std::vector<std::tr1::weak_ptr<PvaServerMonitorImpl> > monitors;
+    epics::pvData::Mutex mutex;
+};
+
+typedef PvaServerRecord::shared_pointer PvaServerRecordPtr;
+
+inline std::string PvaServerRecord::getRecordName() const
+{
+    return recordName;
+}
+
+inline epics::pvData::StructureConstPtr PvaServerRecord::getStructure() const
+{
+    return pvStructurePtr->getStructure();
+}
+
+#endif
@@ -0,0 +1,247 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "boost/python/handle.hpp"
+#include "PyDictConversionPlan.h"
+#include "PyPvDataUtility.h"
+#include "PvaException.h"
+#include "InvalidDataType.h"
+
+const int PyDictConversionPlan::MaxCacheSize(1024);
+
+PvaPyLogger PyDictConversionPlan::logger("PyDictConversionPlan");
+epics::pvData::Mutex PyDictConversionPlan::cacheMutex;
+
+// Cache is never deleted, so that python objects held by plans are not
+// released during static destruction, after interpreter may be gone
+PyDictConversionPlan::PlanCache* PyDictConversionPlan::planCache(new PyDictConversionPlan::PlanCache());
+
+PyDictConversionPlanPtr PyDictConversionPlan::getPlan(const epics::pvData::StructureConstPtr& structurePtr)
+{
+    epics::pvData::Lock lock(cacheMutex);
+    const epics::pvData::Structure* key = structurePtr.get();
+    PlanCache::iterator iter = planCache->find(key);
+    if (iter != planCache->end()) {
+        // Address may have been reused by a different structure
+        if (iter->second.structurePtr.lock() == structurePtr) {
+            return iter->second.plan;
+        }
+        planCache->erase(iter);
+    }
+
+    if (int(planCache->size()) >= MaxCacheSize) {
+        purgeExpiredPlans();
+        if (int(planCache->size()) >= MaxCacheSize) {
+            logger.debug("Conversion plan cache is full, clearing %d plans", int(planCache->size()));
+            planCache->clear();
+        }
+    }
+
+    CacheEntry entry;
+    entry.structurePtr = structurePtr;
+    entry.plan = PyDictConversionPlanPtr(new PyDictConversionPlan(structurePtr));
+    (*planCache)[key] = entry;
+    return entry.plan;
+}
+
+void PyDictConversionPlan::clearCache()
+{
+    epics::pvData::Lock lock(cacheMutex);
+    planCache->clear();
+}
+
+// Must be called with cache mutex held
+void PyDictConversionPlan::purgeExpiredPlans()
+{
+    PlanCache::iterator iter = planCache->begin();
+    while (iter != planCache->end()) {
+        if (iter->second.structurePtr.expired()) {
+            planCache->erase(iter++);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+PyDictConversionPlan::PyDictConversionPlan(const epics::pvData::StructureConstPtr& structurePtr) :
+    fieldPlans()
+{
+    const epics::pvData::StringArray& fieldNames = structurePtr->getFieldNames();
+    const epics::pvData::FieldConstPtrArray& fields = structurePtr->getFields();
+    fieldPlans.resize(fields.size());
+    for (unsigned int i = 0; i < fields.size(); ++i) {
+        FieldPlan& fieldPlan = fieldPlans[i];
+        fieldPlan.fieldName = fieldNames[i];
+#if PY_MAJOR_VERSION >= 3
+        fieldPlan.pyKey = boost::python::object(boost::python::handle<>(PyUnicode_InternFromString(fieldNames[i].c_str())));
+#else
+        fieldPlan.pyKey = boost::python::object(boost::python::handle<>(PyString_InternFromString(fieldNames[i].c_str())));
+#endif
+        fieldPlan.type = fields[i]->getType();
+        fieldPlan.scalarType = epics::pvData::pvBoolean;
+        switch (fieldPlan.type) {
+            case epics::pvData::scalar: {
+                fieldPlan.scalarType = std::tr1::static_pointer_cast<const epics::pvData::Scalar>(fields[i])->getScalarType();
+                break;
+            }
+            case epics::pvData::scalarArray: {
+                fieldPlan.scalarType = std::tr1::static_pointer_cast<const epics::pvData::ScalarArray>(fields[i])->getElementType();
+                break;
+            }
+            case epics::pvData::structure: {
+                epics::pvData::StructureConstPtr fieldStructurePtr = std::tr1::static_pointer_cast<const epics::pvData::Structure>(fields[i]);
+                fieldPlan.structurePlan = PyDictConversionPlanPtr(new PyDictConversionPlan(fieldStructurePtr));
+                break;
+            }
+            case epics::pvData::structureArray: {
+                epics::pvData::StructureConstPtr elementStructurePtr = std::tr1::static_pointer_cast<const epics::pvData::StructureArray>(fields[i])->getStructure();
+                fieldPlan.structurePlan = PyDictConversionPlanPtr(new PyDictConversionPlan(elementStructurePtr));
+                break;
+            }
+            default: {
+                // Unions are converted by field name, since their
+                // contents are not known in advance
+                break;
+            }
+        }
+    }
+}
+
+PyDictConversionPlan::~PyDictConversionPlan()
+{
+}
+
+void PyDictConversionPlan::toPyDict(const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict) const
+{
+    const epics::pvData::PVFieldPtrArray& pvFields = pvStructurePtr->getPVFields();
+    for (unsigned int i = 0; i < fieldPlans.size(); ++i) {
+        addFieldToPyDict(fieldPlans[i], pvFields[i], pvStructurePtr, pyDict);
+    }
+}
+
+void PyDictConversionPlan::fieldToPyDict(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict) const
+{
+    size_t fieldIndex = pvStructurePtr->getStructure()->getFieldIndex(fieldName);
+    if (fieldIndex >= fieldPlans.size()) {
+        return;
+    }
+    addFieldToPyDict(fieldPlans[fieldIndex], pvStructurePtr->getPVFields()[fieldIndex], pvStructurePtr, pyDict);
+}
+
+void PyDictConversionPlan::addFieldToPyDict(const FieldPlan& fieldPlan, const epics::pvData::PVFieldPtr& pvFieldPtr, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict) const
+{
+    switch (fieldPlan.type) {
+        case epics::pvData::scalar: {
+            addScalarFieldToPyDict(fieldPlan, pvFieldPtr, pyDict);
+            break;
+        }
+        case epics::pvData::scalarArray: {
+            boost::python::list pyList;
+            PyPvDataUtility::pvScalarArrayToPyList(std::tr1::static_pointer_cast<epics::pvData::PVScalarArray>(pvFieldPtr), fieldPlan.scalarType, pyList);
+            pyDict[fieldPlan.pyKey] = pyList;
+            break;
+        }
+        case epics::pvData::structure: {
+            boost::python::dict pyDict2;
+            fieldPlan.structurePlan->toPyDict(std::tr1::static_pointer_cast<epics::pvData::PVStructure>(pvFieldPtr), pyDict2);
+            pyDict[fieldPlan.pyKey] = pyDict2;
+            break;
+        }
+        case epics::pvData::structureArray: {
+            boost::python::list pyList;
+            epics::pvData::PVStructureArrayPtr pvStructureArrayPtr = std::tr1::static_pointer_cast<epics::pvData::PVStructureArray>(pvFieldPtr);
+            epics::pvData::PVStructureArray::const_svector arrayData(pvStructureArrayPtr->view());
+            for (size_t i = 0; i < arrayData.size(); ++i) {
+                boost::python::dict pyDict2;
+                // Element structures may be left unallocated
+                if (arrayData[i]) {
+                    fieldPlan.structurePlan->toPyDict(arrayData[i], pyDict2);
+                }
+                pyList.append(pyDict2);
+            }
+            pyDict[fieldPlan.pyKey] = pyList;
+            break;
+        }
+        case epics::pvData::union_: {
+            PyPvDataUtility::addUnionFieldToDict(fieldPlan.fieldName, pvStructurePtr, pyDict);
+            break;
+        }
+        case epics::pvData::unionArray: {
+            PyPvDataUtility::addUnionArrayFieldToDict(fieldPlan.fieldName, pvStructurePtr, pyDict);
+            break;
+        }
+        default: {
+            throw PvaException("Unrecognized field type: %d", fieldPlan.type);
+        }
+    }
+}
+
+void PyDictConversionPlan::addScalarFieldToPyDict(const FieldPlan& fieldPlan, const epics::pvData::PVFieldPtr& pvFieldPtr, boost::python::dict& pyDict) const
+{
+    switch (fieldPlan.scalarType) {
+        case epics::pvData::pvBoolean: {
+            bool value = std::tr1::static_pointer_cast<epics::pvData::PVBoolean>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvByte: {
+            char value = std::tr1::static_pointer_cast<epics::pvData::PVByte>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvUByte: {
+            unsigned char value = std::tr1::static_pointer_cast<epics::pvData::PVUByte>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvShort: {
+            short value = std::tr1::static_pointer_cast<epics::pvData::PVShort>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvUShort: {
+            unsigned short value = std::tr1::static_pointer_cast<epics::pvData::PVUShort>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvInt: {
+            int32_t value = std::tr1::static_pointer_cast<epics::pvData::PVInt>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvUInt: {
+            uint32_t value = std::tr1::static_pointer_cast<epics::pvData::PVUInt>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvLong: {
+            int64_t value = std::tr1::static_pointer_cast<epics::pvData::PVLong>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvULong: {
+            uint64_t value = std::tr1::static_pointer_cast<epics::pvData::PVULong>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvFloat: {
+            float value = std::tr1::static_pointer_cast<epics::pvData::PVFloat>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvDouble: {
+            double value = std::tr1::static_pointer_cast<epics::pvData::PVDouble>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        case epics::pvData::pvString: {
+            const std::string& value = std::tr1::static_pointer_cast<epics::pvData::PVString>(pvFieldPtr)->get();
+            pyDict[fieldPlan.pyKey] = value;
+            break;
+        }
+        default: {
+            throw InvalidDataType("Unrecognized scalar type: %d", fieldPlan.scalarType);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PY_DICT_CONVERSION_PLAN_H
+#define PY_DICT_CONVERSION_PLAN_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "pv/pvData.h"
+#include "boost/python/object.hpp"
+#include "boost/python/dict.hpp"
+#include "PvaPyLogger.h"
+
+class PyDictConversionPlan;
+typedef std::tr1::shared_ptr<PyDictConversionPlan> PyDictConversionPlanPtr;
+
+//
+// Precompiled conversion of PV structures with given introspection
+// interface into python dictionaries.
+//
+// Plan resolves field types and nested structure plans once, and keeps
+// interned python key strings, so that converting structure walks its
+// fields by index instead of looking them up by name. Plans are cached
+// per introspection interface; since they hold python objects, they
+// must be created, used and released with GIL held.
+//
+class PyDictConversionPlan
+{
+public:
+    static const int MaxCacheSize;
+
+    static PyDictConversionPlanPtr getPlan(const epics::pvData::StructureConstPtr& structurePtr);
+    static void clearCache();
+
+    virtual ~PyDictConversionPlan();
+
+    void toPyDict(const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict) const;
+
+    // Converts single top level field; unknown field name is ignored
+    void fieldToPyDict(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict) const;
+
+private:
+    struct FieldPlan
+    {
+        std::string fieldName;
+        boost::python::object pyKey;
+        epics::pvData::Type type;
+        epics::pvData::ScalarType scalarType;
+        PyDictConversionPlanPtr structurePlan;
+    };
+
+    struct CacheEntry
+    {
+        std::tr1::weak_ptr<const epics::pvData::Structure> structurePtr;
+        PyDictConversionPlanPtr plan;
+    };
+
+    typedef std::map<const epics::pvData::Structure*, CacheEntry> PlanCache;
+
+    static PvaPyLogger logger;
+    static epics::pvData::Mutex cacheMutex;
+    static PlanCache* planCache;
+
+    PyDictConversionPlan(const epics::pvData::StructureConstPtr& structurePtr);
+    static void purgeExpiredPlans();
+
+    void addFieldToPyDict(const FieldPlan& fieldPlan, const epics::pvData::PVFieldPtr& pvFieldPtr, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict) const;
+    void addScalarFieldToPyDict(const FieldPlan& fieldPlan, const epics::pvData::PVFieldPtr& pvFieldPtr, boost::python::dict& pyDict) const;
+
+    std::vector<FieldPlan> fieldPlans;
+};
+
+#endif
@@ -4,7 +4,6 @@
 #include "PyGilManager.h"
 
 bool PyGilManager::threadsInitialized(false);
-PyGILState_STATE PyGilManager::gilState;
 
 void PyGilManager::evalInitThreads()
 {
@@ -14,17 +13,31 @@ void PyGilManager::evalInitThreads()
     }
 }
 
-void PyGilManager::gilStateEnsure()
+PyGILState_STATE PyGilManager::gilStateEnsure()
 {
     if (threadsInitialized) {
-        gilState = PyGILState_Ensure();
+        return PyGILState_Ensure();
     }
+    return PyGILState_UNLOCKED;
 }
 
-void PyGilManager::gilStateRelease()
+void PyGilManager::gilStateRelease(PyGILState_STATE gilState)
 {
     if (threadsInitialized) {
         PyGILState_Release(gilState);
     }
 }
 
+bool PyGilManager::isGilHeld()
+{
+    if (!Py_IsInitialized()) {
+        return false;
+    }
+#if PY_VERSION_HEX >= 0x03040000
+    return PyGILState_Check();
+#else
+    PyThreadState* threadState = PyGILState_GetThisThreadState();
+    return (threadState && threadState == _PyThreadState_Current);
+#endif
+}
+
@@ -10,11 +10,17 @@ class PyGilManager
 {
 public:
     static void evalInitThreads();
-    static void gilStateEnsure();
-    static void gilStateRelease();
+
+    // GIL state is kept by caller, as each thread that acquires GIL
+    // must release it with the state returned to it
+    static PyGILState_STATE gilStateEnsure();
+    static void gilStateRelease(PyGILState_STATE gilState);
+
+    // Returns true if calling thread holds GIL; server code may also
+    // run in C++ programs without python interpreter
+    static bool isGilHeld();
 private:
     static bool threadsInitialized;
-    static PyGILState_STATE gilState;
 };
 
 #endif // #ifndef PY_GIL_MANAGER_H
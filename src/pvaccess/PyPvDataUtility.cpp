@@ -2,6 +2,8 @@
 // found in the file LICENSE that is included with the distribution
 
 #include "PyPvDataUtility.h"
+#include "epicsEndian.h"
+#include "pv/convert.h"
 #include "PvType.h"
 #include "PvaConstants.h"
 #include "FieldNotFound.h"
@@ -9,6 +11,7 @@
 #include "InvalidArgument.h"
 #include "InvalidRequest.h"
 #include "PvObject.h"
+#include "PyDictConversionPlan.h"
 
 // Scalar array utilities
 namespace PyPvDataUtility
@@ -452,6 +455,9 @@ void pyObjectToScalarField(const boost::python::object& pyObject, const std::str
 //
 void pyObjectToScalarArrayField(const boost::python::object& pyObject, const std::string& fieldName, epics::pvData::PVStructurePtr& pvStructurePtr)
 {
+    if (pyBufferToScalarArrayField(pyObject, fieldName, pvStructurePtr)) {
+        return;
+    }
     boost::python::list pyList = PyUtility::extractValueFromPyObject<boost::python::list>(pyObject);
     pyListToScalarArrayField(pyList, fieldName, pvStructurePtr);
 }
@@ -499,6 +505,220 @@ void pyObjectToUnionArrayField(const boost::python::object& pyObject, const std:
     pyListToUnionArrayField(pyList, fieldName, pvStructurePtr);
 }
 
+//
+// Conversion PY buffer => PV Scalar Array
+//
+bool pyBufferToScalarArrayField(const boost::python::object& pyObject, const std::string& fieldName, epics::pvData::PVStructurePtr& pvStructurePtr)
+{
+    PyObject* pyObjectPtr = pyObject.ptr();
+    if (!PyObject_CheckBuffer(pyObjectPtr)) {
+        return false;
+    }
+    epics::pvData::ScalarType scalarType = getScalarArrayType(fieldName, pvStructurePtr);
+    if (scalarType == epics::pvData::pvString) {
+        return false;
+    }
+
+    Py_buffer pyBuffer;
+    if (PyObject_GetBuffer(pyObjectPtr, &pyBuffer, PyBUF_C_CONTIGUOUS|PyBUF_FORMAT) < 0) {
+        PyErr_Clear();
+        throw InvalidArgument("Cannot access contiguous data buffer for field %s", fieldName.c_str());
+    }
+
+    try {
+        char dataKind = getPyBufferDataKind(pyBuffer.format);
+        if (!dataKind || pyBuffer.itemsize <= 0) {
+            throw InvalidDataType("Unsupported buffer data format: %s", pyBuffer.format);
+        }
+        epics::pvData::PVScalarArrayPtr pvScalarArrayPtr = pvStructurePtr->getSubField<epics::pvData::PVScalarArray>(fieldName);
+        switch (scalarType) {
+            case epics::pvData::pvBoolean: {
+                pyBufferToScalarArray<epics::pvData::PVBooleanArray, epics::pvData::boolean>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvByte: {
+                pyBufferToScalarArray<epics::pvData::PVByteArray, epics::pvData::int8>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvUByte: {
+                pyBufferToScalarArray<epics::pvData::PVUByteArray, epics::pvData::uint8>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvShort: {
+                pyBufferToScalarArray<epics::pvData::PVShortArray, epics::pvData::int16>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvUShort: {
+                pyBufferToScalarArray<epics::pvData::PVUShortArray, epics::pvData::uint16>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvInt: {
+                pyBufferToScalarArray<epics::pvData::PVIntArray, epics::pvData::int32>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvUInt: {
+                pyBufferToScalarArray<epics::pvData::PVUIntArray, epics::pvData::uint32>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvLong: {
+                pyBufferToScalarArray<epics::pvData::PVLongArray, epics::pvData::int64>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvULong: {
+                pyBufferToScalarArray<epics::pvData::PVULongArray, epics::pvData::uint64>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvFloat: {
+                pyBufferToScalarArray<epics::pvData::PVFloatArray, float>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            case epics::pvData::pvDouble: {
+                pyBufferToScalarArray<epics::pvData::PVDoubleArray, double>(pyBuffer, dataKind, pvScalarArrayPtr);
+                break;
+            }
+            default: {
+                throw PvaException("Unrecognized scalar type: %d", scalarType);
+            }
+        }
+    }
+    catch (...) {
+        PyBuffer_Release(&pyBuffer);
+        throw;
+    }
+    PyBuffer_Release(&pyBuffer);
+    return true;
+}
+
+//
+// Buffer data kind: 'i' (signed integer), 'u' (unsigned integer),
+// 'f' (floating point), or 0 if format is not supported
+//
+char getPyBufferDataKind(const char* format)
+{
+    // No format means unsigned bytes
+    if (!format) {
+        return 'u';
+    }
+
+    // Only native byte order can be copied directly
+    switch (*format) {
+        case '@':
+        case '=': {
+            format++;
+            break;
+        }
+        case '<': {
+#if EPICS_BYTE_ORDER != EPICS_ENDIAN_LITTLE
+            return 0;
+#endif
+            format++;
+            break;
+        }
+        case '>':
+        case '!': {
+#if EPICS_BYTE_ORDER != EPICS_ENDIAN_BIG
+            return 0;
+#endif
+            format++;
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+
+    if (!format[0] || format[1]) {
+        return 0;
+    }
+    switch (format[0]) {
+        case 'b':
+        case 'h':
+        case 'i':
+        case 'l':
+        case 'q': {
+            return 'i';
+        }
+        case 'B':
+        case 'H':
+        case 'I':
+        case 'L':
+        case 'Q':
+        case 'c':
+        case '?': {
+            return 'u';
+        }
+        case 'f':
+        case 'd': {
+            return 'f';
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+//
+// Determines PV scalar type matching PY buffer data; returns false if
+// object does not support buffer protocol or its format is not supported
+//
+bool getPyBufferScalarType(const boost::python::object& pyObject, epics::pvData::ScalarType& scalarType)
+{
+    PyObject* pyObjectPtr = pyObject.ptr();
+    if (!PyObject_CheckBuffer(pyObjectPtr)) {
+        return false;
+    }
+
+    // Data layout does not matter here, so strided buffers are fine
+    Py_buffer pyBuffer;
+    if (PyObject_GetBuffer(pyObjectPtr, &pyBuffer, PyBUF_STRIDES|PyBUF_FORMAT) < 0) {
+        PyErr_Clear();
+        return false;
+    }
+    char dataKind = getPyBufferDataKind(pyBuffer.format);
+    char formatChar = (pyBuffer.format && pyBuffer.format[0] ? pyBuffer.format[strlen(pyBuffer.format)-1] : 'B');
+    Py_ssize_t itemSize = pyBuffer.itemsize;
+    PyBuffer_Release(&pyBuffer);
+
+    bool supported = true;
+    if (formatChar == '?') {
+        scalarType = epics::pvData::pvBoolean;
+    }
+    else if (dataKind == 'i' && itemSize == 1) {
+        scalarType = epics::pvData::pvByte;
+    }
+    else if (dataKind == 'i' && itemSize == 2) {
+        scalarType = epics::pvData::pvShort;
+    }
+    else if (dataKind == 'i' && itemSize == 4) {
+        scalarType = epics::pvData::pvInt;
+    }
+    else if (dataKind == 'i' && itemSize == 8) {
+        scalarType = epics::pvData::pvLong;
+    }
+    else if (dataKind == 'u' && itemSize == 1) {
+        scalarType = epics::pvData::pvUByte;
+    }
+    else if (dataKind == 'u' && itemSize == 2) {
+        scalarType = epics::pvData::pvUShort;
+    }
+    else if (dataKind == 'u' && itemSize == 4) {
+        scalarType = epics::pvData::pvUInt;
+    }
+    else if (dataKind == 'u' && itemSize == 8) {
+        scalarType = epics::pvData::pvULong;
+    }
+    else if (dataKind == 'f' && itemSize == 4) {
+        scalarType = epics::pvData::pvFloat;
+    }
+    else if (dataKind == 'f' && itemSize == 8) {
+        scalarType = epics::pvData::pvDouble;
+    }
+    else {
+        supported = false;
+    }
+    return supported;
+}
+
 //
 // Conversion PV Scalar Array => PY List
 //
@@ -506,7 +726,11 @@ void scalarArrayFieldToPyList(const std::string& fieldName, const epics::pvData:
 {
     epics::pvData::ScalarType scalarType = getScalarArrayType(fieldName, pvStructurePtr);
     epics::pvData::PVScalarArrayPtr pvScalarArrayPtr = pvStructurePtr->getSubField<epics::pvData::PVScalarArray>(fieldName);
+    pvScalarArrayToPyList(pvScalarArrayPtr, scalarType, pyList);
+}
 
+void pvScalarArrayToPyList(const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr, epics::pvData::ScalarType scalarType, boost::python::list& pyList)
+{
     switch (scalarType) {
         case epics::pvData::pvBoolean: {
             scalarArrayToPyList<epics::pvData::PVBooleanArray, epics::pvData::boolean>(pvScalarArrayPtr, pyList);
@@ -807,46 +1031,7 @@ void stringArrayToPyList(const epics::pvData::StringArray& stringArray, boost::p
 //
 void structureToPyDict(const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict)
 {
-    epics::pvData::StructureConstPtr structurePtr = pvStructurePtr->getStructure();
-    epics::pvData::StringArray fieldNames = structurePtr->getFieldNames();
-    for (unsigned int i = 0; i < fieldNames.size(); ++i) {
-        std::string fieldName = fieldNames[i];
-        epics::pvData::FieldConstPtr fieldPtr = getField(fieldName, pvStructurePtr);
-        epics::pvData::Type type = fieldPtr->getType();
-        switch (type) {
-            case epics::pvData::scalar: {
-                epics::pvData::ScalarConstPtr scalarPtr = std::tr1::static_pointer_cast<const epics::pvData::Scalar>(fieldPtr);
-                epics::pvData::ScalarType scalarType = scalarPtr->getScalarType();
-                addScalarFieldToDict(fieldName, scalarType, pvStructurePtr, pyDict);
-                break;
-            }
-            case epics::pvData::scalarArray: {
-                epics::pvData::ScalarArrayConstPtr scalarArrayPtr = std::tr1::static_pointer_cast<const epics::pvData::ScalarArray>(fieldPtr);
-                epics::pvData::ScalarType scalarType = scalarArrayPtr->getElementType();
-                addScalarArrayFieldToDict(fieldName, scalarType, pvStructurePtr, pyDict);
-                break;
-            }
-            case epics::pvData::structure: {
-                addStructureFieldToDict(fieldName, pvStructurePtr, pyDict);
-                break;
-            }
-            case epics::pvData::structureArray: {
-                addStructureArrayFieldToDict(fieldName, pvStructurePtr, pyDict);
-                break;
-            }
-            case epics::pvData::union_: {
-                addUnionFieldToDict(fieldName, pvStructurePtr, pyDict);
-                break;
-            }
-            case epics::pvData::unionArray: {
-                addUnionArrayFieldToDict(fieldName, pvStructurePtr, pyDict);
-                break;
-            }
-            default: {
-                throw PvaException("Unrecognized field type: %d", type);
-            }
-        }
-    }
+    PyDictConversionPlan::getPlan(pvStructurePtr->getStructure())->toPyDict(pvStructurePtr, pyDict);
 }
 
 void structureFieldToPyDict(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict)
@@ -854,6 +1039,101 @@ void structureFieldToPyDict(const std::string& fieldName, const epics::pvData::P
     structureToPyDict(getStructureField(fieldName, pvStructurePtr), pyDict);
 }
 
+//
+// Add PV Field => PY {}
+//
+void addFieldToDict(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict)
+{
+    epics::pvData::FieldConstPtr fieldPtr = getField(fieldName, pvStructurePtr);
+    epics::pvData::Type type = fieldPtr->getType();
+    switch (type) {
+        case epics::pvData::scalar: {
+            epics::pvData::ScalarConstPtr scalarPtr = std::tr1::static_pointer_cast<const epics::pvData::Scalar>(fieldPtr);
+            epics::pvData::ScalarType scalarType = scalarPtr->getScalarType();
+            addScalarFieldToDict(fieldName, scalarType, pvStructurePtr, pyDict);
+            break;
+        }
+        case epics::pvData::scalarArray: {
+            epics::pvData::ScalarArrayConstPtr scalarArrayPtr = std::tr1::static_pointer_cast<const epics::pvData::ScalarArray>(fieldPtr);
+            epics::pvData::ScalarType scalarType = scalarArrayPtr->getElementType();
+            addScalarArrayFieldToDict(fieldName, scalarType, pvStructurePtr, pyDict);
+            break;
+        }
+        case epics::pvData::structure: {
+            addStructureFieldToDict(fieldName, pvStructurePtr, pyDict);
+            break;
+        }
+        case epics::pvData::structureArray: {
+            addStructureArrayFieldToDict(fieldName, pvStructurePtr, pyDict);
+            break;
+        }
+        case epics::pvData::union_: {
+            addUnionFieldToDict(fieldName, pvStructurePtr, pyDict);
+            break;
+        }
+        case epics::pvData::unionArray: {
+            addUnionArrayFieldToDict(fieldName, pvStructurePtr, pyDict);
+            break;
+        }
+        default: {
+            throw PvaException("Unrecognized field type: %d", type);
+        }
+    }
+}
+
+//
+// Conversion of changed PV Structure fields => PY {}
+//
+void changedStructureToPyDict(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& bitSet, boost::python::dict& pyDict)
+{
+    // Bit for structure itself means that all of its fields changed
+    if (bitSet.get(pvStructurePtr->getFieldOffset())) {
+        structureToPyDict(pvStructurePtr, pyDict);
+        return;
+    }
+
+    const epics::pvData::PVFieldPtrArray& pvFields = pvStructurePtr->getPVFields();
+    for (unsigned int i = 0; i < pvFields.size(); ++i) {
+        epics::pvData::PVFieldPtr pvFieldPtr = pvFields[i];
+        epics::pvData::int32 changedOffset = bitSet.nextSetBit(pvFieldPtr->getFieldOffset());
+        if (changedOffset < 0 || changedOffset >= epics::pvData::int32(pvFieldPtr->getNextFieldOffset())) {
+            continue;
+        }
+
+        // Unchanged structure may contain changed subfields
+        std::string fieldName = pvFieldPtr->getFieldName();
+        if (pvFieldPtr->getField()->getType() == epics::pvData::structure && changedOffset != epics::pvData::int32(pvFieldPtr->getFieldOffset())) {
+            boost::python::dict pyDict2;
+            changedStructureToPyDict(std::tr1::static_pointer_cast<epics::pvData::PVStructure>(pvFieldPtr), bitSet, pyDict2);
+            pyDict[fieldName] = pyDict2;
+        }
+        else {
+            addFieldToDict(fieldName, pvStructurePtr, pyDict);
+        }
+    }
+}
+
+//
+// Conversion of PV Structure bit set => PY [field names]
+//
+void changedFieldNamesToPyList(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& bitSet, boost::python::list& pyList, const std::string& fieldNamePrefix)
+{
+    bool structureChanged = bitSet.get(pvStructurePtr->getFieldOffset());
+    const epics::pvData::PVFieldPtrArray& pvFields = pvStructurePtr->getPVFields();
+    for (unsigned int i = 0; i < pvFields.size(); ++i) {
+        epics::pvData::PVFieldPtr pvFieldPtr = pvFields[i];
+        std::string fieldName = fieldNamePrefix + pvFieldPtr->getFieldName();
+        epics::pvData::int32 changedOffset = bitSet.nextSetBit(pvFieldPtr->getFieldOffset());
+        if (structureChanged || changedOffset == epics::pvData::int32(pvFieldPtr->getFieldOffset())) {
+            pyList.append(fieldName);
+        }
+        else if (changedOffset > 0 && changedOffset < epics::pvData::int32(pvFieldPtr->getNextFieldOffset())) {
+            // Only structures have subfields with higher offsets
+            changedFieldNamesToPyList(std::tr1::static_pointer_cast<epics::pvData::PVStructure>(pvFieldPtr), bitSet, pyList, fieldName + ".");
+        }
+    }
+}
+
 //
 // Add PV Scalar => PY {}
 // 
@@ -1122,17 +1402,38 @@ void fieldToPyDict(const epics::pvData::FieldConstPtr& fieldPtr, const std::stri
     }
 }
 
+//
+// Introspection interface comparison; identical interfaces are usually
+// the same object, which makes comparison trivial
+//
+bool isSameStructure(const epics::pvData::StructureConstPtr& structurePtr, const epics::pvData::StructureConstPtr& structurePtr2)
+{
+    return (structurePtr == structurePtr2 || *structurePtr == *structurePtr2);
+}
+
 //
 // Copy PV Structure => PV Structure
 //
 void copyStructureToStructure(const epics::pvData::PVStructurePtr& srcPvStructurePtr, epics::pvData::PVStructurePtr& destPvStructurePtr)
 {
+    if (srcPvStructurePtr == destPvStructurePtr) {
+        return;
+    }
+
+    // Structures with identical introspection interface are copied field
+    // by field in offset order, with array data shared rather than copied
     epics::pvData::StructureConstPtr srcStructurePtr = srcPvStructurePtr->getStructure();
-    epics::pvData::StringArray fieldNames = srcStructurePtr->getFieldNames();
+    if (isSameStructure(srcStructurePtr, destPvStructurePtr->getStructure())) {
+        epics::pvData::getConvert()->copyStructure(srcPvStructurePtr, destPvStructurePtr);
+        return;
+    }
+
+    // Otherwise, fields are matched by name
+    const epics::pvData::StringArray& fieldNames = srcStructurePtr->getFieldNames();
+    const epics::pvData::PVFieldPtrArray& pvFields = srcPvStructurePtr->getPVFields();
     for (unsigned int i = 0; i < fieldNames.size(); ++i) {
-        std::string fieldName = fieldNames[i];
-        epics::pvData::PVFieldPtr pvFieldPtr = srcPvStructurePtr->getSubField(fieldName);
-        epics::pvData::FieldConstPtr fieldPtr = pvFieldPtr->getField();
+        const std::string& fieldName = fieldNames[i];
+        epics::pvData::FieldConstPtr fieldPtr = pvFields[i]->getField();
         epics::pvData::Type type = fieldPtr->getType();
         switch (type) {
             case epics::pvData::scalar: {
@@ -1209,8 +1510,14 @@ void copyStructureArrayToStructure(const std::string& fieldName, const epics::pv
     }
 
 
+    // Elements of identical structure are shared, like scalar array data
     int nElements = srcPvStructureArrayPtr->getLength();
     epics::pvData::PVStructureArray::const_svector srcPvStructures(srcPvStructureArrayPtr->view());
+    if (isSameStructure(srcPvStructureArrayPtr->getStructureArray()->getStructure(), structurePtr)) {
+        destPvStructureArrayPtr->replace(srcPvStructures);
+        return;
+    }
+
     epics::pvData::PVStructureArray::svector destPvStructures(nElements);
 
     for (int i = 0; i < nElements; i++) {
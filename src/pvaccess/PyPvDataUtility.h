@@ -5,7 +5,9 @@
 #define PY_PV_DATA_UTILITY_H
 
 #include <string>
+#include <cstring>
 #include "pv/pvData.h"
+#include "pv/bitSet.h"
 #include "boost/python/str.hpp"
 #include "boost/python/extract.hpp"
 #include "boost/python/object.hpp"
@@ -123,10 +125,22 @@ void pyObjectToUnionArrayField(const boost::python::object& pyObject, const std:
 //
 void pyListToScalarArrayField(const boost::python::list& pyList, const std::string& fieldName, epics::pvData::PVStructurePtr& pvStructurePtr);
 
+//
+// Conversion PY buffer => PV Scalar Array
+//
+// Accepts objects that expose python buffer protocol (e.g., numpy arrays)
+// and copies data in bulk; returns false if object does not support buffer
+// protocol or if field is a string array.
+//
+bool pyBufferToScalarArrayField(const boost::python::object& pyObject, const std::string& fieldName, epics::pvData::PVStructurePtr& pvStructurePtr);
+char getPyBufferDataKind(const char* format);
+bool getPyBufferScalarType(const boost::python::object& pyObject, epics::pvData::ScalarType& scalarType);
+
 //
 // Conversion PV Scalar Array => PY []
 //
 void scalarArrayFieldToPyList(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::list& pyList);
+void pvScalarArrayToPyList(const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr, epics::pvData::ScalarType scalarType, boost::python::list& pyList);
 
 //
 // Conversion PV String Array => PY []
@@ -178,6 +192,21 @@ void structureToPyDict(const epics::pvData::PVStructurePtr& pvStructurePtr, boos
 
 void structureFieldToPyDict(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict);
 
+//
+// Conversion of changed PV Structure fields => PY {}
+//
+void changedStructureToPyDict(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& bitSet, boost::python::dict& pyDict);
+
+//
+// Conversion of PV Structure bit set => PY [field names]
+//
+void changedFieldNamesToPyList(const epics::pvData::PVStructurePtr& pvStructurePtr, const epics::pvData::BitSet& bitSet, boost::python::list& pyList, const std::string& fieldNamePrefix="");
+
+//
+// Add PV Field => PY {}
+//
+void addFieldToDict(const std::string& fieldName, const epics::pvData::PVStructurePtr& pvStructurePtr, boost::python::dict& pyDict);
+
 //
 //
 // Add PV Scalar => PY {}
@@ -227,6 +256,7 @@ void fieldToPyDict(const epics::pvData::FieldConstPtr& fieldPtr, const std::stri
 //
 // Copy PV Structure => PV Structure
 //
+bool isSameStructure(const epics::pvData::StructureConstPtr& structurePtr, const epics::pvData::StructureConstPtr& structurePtr2);
 void copyStructureToStructure(const epics::pvData::PVStructurePtr& srcPvStructurePtr, epics::pvData::PVStructurePtr& destPvStructurePtr);
 void copyStructureToStructure(const std::string& fieldName, const epics::pvData::PVStructurePtr& srcPvStructurePtr, epics::pvData::PVStructurePtr& destPvStructurePtr);
 
@@ -300,6 +330,76 @@ void pyListToScalarArrayField(const boost::python::list& pyList, const std::stri
     valueArray->replace(freeze(v));
 }
 
+template<typename SrcType, typename CppType>
+struct PyBufferDataCopier
+{
+    static void copy(const void* srcData, CppType* destData, size_t nElements)
+    {
+        const SrcType* src = static_cast<const SrcType*>(srcData);
+        for (size_t i = 0; i < nElements; i++) {
+            destData[i] = static_cast<CppType>(src[i]);
+        }
+    }
+};
+
+template<typename CppType>
+struct PyBufferDataCopier<CppType, CppType>
+{
+    static void copy(const void* srcData, CppType* destData, size_t nElements)
+    {
+        memcpy(destData, srcData, nElements*sizeof(CppType));
+    }
+};
+
+template<typename CppType>
+void copyPyBufferData(const Py_buffer& pyBuffer, char dataKind, CppType* destData, size_t nElements)
+{
+    Py_ssize_t itemSize = pyBuffer.itemsize;
+    if (dataKind == 'i' && itemSize == 1) {
+        PyBufferDataCopier<epics::pvData::int8, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'i' && itemSize == 2) {
+        PyBufferDataCopier<epics::pvData::int16, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'i' && itemSize == 4) {
+        PyBufferDataCopier<epics::pvData::int32, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'i' && itemSize == 8) {
+        PyBufferDataCopier<epics::pvData::int64, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'u' && itemSize == 1) {
+        PyBufferDataCopier<epics::pvData::uint8, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'u' && itemSize == 2) {
+        PyBufferDataCopier<epics::pvData::uint16, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'u' && itemSize == 4) {
+        PyBufferDataCopier<epics::pvData::uint32, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'u' && itemSize == 8) {
+        PyBufferDataCopier<epics::pvData::uint64, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'f' && itemSize == 4) {
+        PyBufferDataCopier<float, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else if (dataKind == 'f' && itemSize == 8) {
+        PyBufferDataCopier<double, CppType>::copy(pyBuffer.buf, destData, nElements);
+    }
+    else {
+        throw InvalidDataType("Unsupported buffer data format: %s", pyBuffer.format);
+    }
+}
+
+template<typename PvArrayType, typename CppType>
+void pyBufferToScalarArray(const Py_buffer& pyBuffer, char dataKind, const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr)
+{
+    size_t nElements = pyBuffer.len/pyBuffer.itemsize;
+    typename PvArrayType::svector v(nElements);
+    copyPyBufferData<CppType>(pyBuffer, dataKind, v.data(), nElements);
+    std::tr1::shared_ptr<PvArrayType> valueArray = std::tr1::static_pointer_cast<PvArrayType>(pvScalarArrayPtr);
+    valueArray->replace(freeze(v));
+}
+
 template<typename PvArrayType, typename CppType>
 void scalarArrayToPyList(const epics::pvData::PVScalarArrayPtr& pvScalarArrayPtr, boost::python::list& pyList) 
 {
@@ -0,0 +1,65 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "boost/python/extract.hpp"
+#include "PyRpcServiceImpl.h"
+#include "PvObject.h"
+#include "PyGilManager.h"
+
+PvaPyLogger PyRpcServiceImpl::logger("PyRpcServiceImpl");
+
+PyRpcServiceImpl::PyRpcServiceImpl(const std::string& serviceName, const boost::python::object& pyService_, const RpcRequestDispatcherPtr& requestDispatcher) :
+    RpcServiceImpl(serviceName, requestDispatcher),
+    pyService(pyService_)
+{
+}
+
+PyRpcServiceImpl::~PyRpcServiceImpl()
+{
+    // Service may be released by server or worker thread after it was
+    // unregistered, and python object must be released with GIL held
+    if (PyGilManager::isGilHeld()) {
+        pyService = boost::python::object();
+        return;
+    }
+    PyGILState_STATE gilState = PyGilManager::gilStateEnsure();
+    pyService = boost::python::object();
+    PyGilManager::gilStateRelease(gilState);
+}
+
+epics::pvData::PVStructurePtr PyRpcServiceImpl::processRequest(const epics::pvData::PVStructurePtr& args)
+{
+    epics::pvData::PVStructurePtr result;
+    std::string error;
+    std::string serviceName = getServiceName();
+
+    // Acquire GIL; all python objects must be released before it is
+    // released again
+    PyGILState_STATE gilState = PyGilManager::gilStateEnsure();
+    try {
+        PvObject pyRequest(args);
+        boost::python::object pyObject = pyService(pyRequest);
+        boost::python::extract<PvObject> pvObjectExtract(pyObject);
+        if (pvObjectExtract.check()) {
+            PvObject pyResponse = pvObjectExtract();
+            result = static_cast<epics::pvData::PVStructurePtr>(pyResponse);
+        }
+        else {
+            error = "Callable python service object must return instance of PvObject.";
+        }
+    }
+    catch (const boost::python::error_already_set&) {
+        logger.error("Service %s raised python exception", serviceName.c_str());
+        PyErr_Print();
+        error = "Service " + serviceName + " raised python exception.";
+    }
+    catch (const std::exception& ex) {
+        error = ex.what();
+    }
+    PyGilManager::gilStateRelease(gilState);
+
+    if (!error.empty()) {
+        throw epics::pvAccess::RPCRequestException(epics::pvData::Status::STATUSTYPE_ERROR, error);
+    }
+    return result;
+}
@@ -0,0 +1,30 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef PY_RPC_SERVICE_IMPL_H
+#define PY_RPC_SERVICE_IMPL_H
+
+#include <string>
+#include "boost/python/object.hpp"
+#include "RpcServiceImpl.h"
+#include "PvaPyLogger.h"
+
+//
+// RPC service that invokes python callable with GIL acquired.
+//
+class PyRpcServiceImpl : public RpcServiceImpl
+{
+public:
+    POINTER_DEFINITIONS(PyRpcServiceImpl);
+    PyRpcServiceImpl(const std::string& serviceName, const boost::python::object& pyService, const RpcRequestDispatcherPtr& requestDispatcher);
+    virtual ~PyRpcServiceImpl();
+
+    virtual epics::pvData::PVStructurePtr processRequest(const epics::pvData::PVStructurePtr& args);
+
+private:
+    static PvaPyLogger logger;
+
+    boost::python::object pyService;
+};
+
+#endif
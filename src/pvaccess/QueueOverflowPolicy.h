@@ -0,0 +1,27 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef QUEUE_OVERFLOW_POLICY_H
+#define QUEUE_OVERFLOW_POLICY_H
+
+//
+// Determines what bounded queue does with an item pushed while it is full.
+//
+namespace QueueOverflowPolicy
+{
+
+enum PolicyType {
+    // Oldest queued item is discarded
+    DropOldest = 0,
+    // Pushed item is discarded
+    DropNewest = 1,
+    // Pushed item replaces the newest queued item
+    CoalesceToLatest = 2,
+    // Producer stops taking items from its source until consumer makes
+    // room; for monitors, updates are then held back by pvAccess
+    BlockProducer = 3,
+};
+
+}
+
+#endif
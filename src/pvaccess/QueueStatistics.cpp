@@ -0,0 +1,24 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "QueueStatistics.h"
+
+QueueStatistics::QueueStatistics() :
+    nReceived(0),
+    nDelivered(0),
+    nDropped(0),
+    maxSize(0),
+    size(0)
+{
+}
+
+boost::python::dict QueueStatistics::toPyDict() const
+{
+    boost::python::dict pyDict;
+    pyDict["received"] = nReceived;
+    pyDict["delivered"] = nDelivered;
+    pyDict["dropped"] = nDropped;
+    pyDict["maxQueueDepth"] = maxSize;
+    pyDict["queueDepth"] = size;
+    return pyDict;
+}
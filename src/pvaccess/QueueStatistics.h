@@ -0,0 +1,25 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef QUEUE_STATISTICS_H
+#define QUEUE_STATISTICS_H
+
+#include "boost/python/dict.hpp"
+
+//
+// Queue counters; received count includes all items pushed into queue,
+// so that nReceived = nDelivered + nDropped + size.
+//
+struct QueueStatistics
+{
+    QueueStatistics();
+    boost::python::dict toPyDict() const;
+
+    unsigned long long nReceived;
+    unsigned long long nDelivered;
+    unsigned long long nDropped;
+    int maxSize;
+    int size;
+};
+
+#endif
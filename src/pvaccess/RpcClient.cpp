@@ -4,68 +4,134 @@
 #include "RpcClient.h"
 #include "PvaException.h"
 #include "pv/rpcService.h"
+#include "ChannelAsyncRequest.h"
 #include "ChannelTimeout.h"
+#include "PyGilRelease.h"
 
-const int RpcClient::DefaultTimeout(1);
+const double RpcClient::DefaultTimeout(1.0);
+
+//
+// Asynchronous RPC request. Request is issued with its own pooled client,
+// so that requests dispatched together are all in flight before the
+// dispatcher waits for the first response. Clients are acquired, and new
+// ones start connecting, before any request waits for connection.
+//
+class RpcAsyncRequest : public ChannelAsyncRequest
+{
+public:
+    RpcAsyncRequest(const std::string& channelName, const epics::pvData::PVStructurePtr& pvRequest, double timeout);
+    virtual ~RpcAsyncRequest();
+    virtual void tryIssue();
+    virtual void issue();
+    virtual epics::pvData::PVStructurePtr waitForCompletion();
+
+private:
+    epics::pvData::PVStructurePtr pvRequest;
+    epics::pvAccess::RPCClient::shared_pointer rpcClient;
+    bool issued;
+};
+
+RpcAsyncRequest::RpcAsyncRequest(const std::string& channelName, const epics::pvData::PVStructurePtr& pvRequest_, double timeout) :
+    ChannelAsyncRequest(channelName, timeout),
+    pvRequest(pvRequest_),
+    rpcClient(),
+    issued(false)
+{
+}
+
+RpcAsyncRequest::~RpcAsyncRequest()
+{
+    // Client is left here only if request failed
+    RpcClientPool::discard(rpcClient);
+}
+
+void RpcAsyncRequest::tryIssue()
+{
+    if (!rpcClient) {
+        rpcClient = RpcClientPool::acquire(getChannelName(), true);
+    }
+}
+
+void RpcAsyncRequest::issue()
+{
+    if (issued) {
+        return;
+    }
+    tryIssue();
+    if (!rpcClient->waitConnect(getRemainingTimeout())) {
+        throw ChannelTimeout("Channel %s connection timed out", getChannelName().c_str());
+    }
+    rpcClient->issueRequest(pvRequest);
+    issued = true;
+}
+
+epics::pvData::PVStructurePtr RpcAsyncRequest::waitForCompletion()
+{
+    try {
+        epics::pvData::PVStructurePtr response = rpcClient->waitResponse(getRemainingTimeout());
+        if (!response) {
+            throw PvaException("Channel %s RPC request did not return response.", getChannelName().c_str());
+        }
+        RpcClientPool::release(getChannelName(), rpcClient);
+        rpcClient.reset();
+        return response;
+    }
+    catch (const epics::pvAccess::RPCRequestException& ex) {
+        throw PvaException(ex.what());
+    }
+}
 
 RpcClient::RpcClient(const std::string& channelName_) :
     PvaClient(),
-    rpcClientInitialized(false),
-    rpcClient(),
     channelName(channelName_)
 {
 }
 
 RpcClient::RpcClient(const RpcClient& pvaRpcClient) :
     PvaClient(),
-    rpcClientInitialized(pvaRpcClient.rpcClientInitialized),
-    rpcClient(pvaRpcClient.rpcClient),
     channelName(pvaRpcClient.channelName)
 {
 }
 
 RpcClient::~RpcClient()
 {
-    if (rpcClientInitialized) {
-        rpcClientInitialized = false;
-        rpcClient->destroy();
-    }
 }
 
-epics::pvAccess::RPCClient::shared_pointer RpcClient::createRpcClient(const std::string& channelName, const epics::pvData::PVStructurePtr& pvRequest, double timeout) 
+void RpcClient::setConnectionPoolSize(int connectionPoolSize)
 {
-#if defined PVA_RPC_API_VERSION && PVA_RPC_API_VERSION == 440
-    return epics::pvAccess::RPCClient::create(channelName);
-#endif // if defined PVA_RPC_API_VERSION && PVA_RPC_API_VERSION == 440
+    RpcClientPool::setMaxIdleClients(connectionPoolSize);
 }
 
-epics::pvAccess::RPCClient::shared_pointer RpcClient::getRpcClient(const epics::pvData::PVStructurePtr& pvRequest, double timeout) 
+int RpcClient::getConnectionPoolSize()
 {
-    if (!rpcClientInitialized) {
-        rpcClient = createRpcClient(channelName, pvRequest, timeout);
-        rpcClientInitialized = true;
-    }
-    return rpcClient;
+    return RpcClientPool::getMaxIdleClients();
 }
 
 epics::pvData::PVStructure::shared_pointer RpcClient::request(const epics::pvData::PVStructurePtr& pvRequest, double timeout) 
 {
+    // Do not block other python threads while waiting for response
+    PyGilRelease pyGilRelease;
+    epics::pvAccess::RPCClient::shared_pointer client;
     try {
-        epics::pvAccess::RPCClient::shared_pointer client = getRpcClient(pvRequest, timeout);
+        client = RpcClientPool::acquire(channelName);
 
 #if defined PVA_RPC_API_VERSION && PVA_RPC_API_VERSION == 440
         epics::pvData::PVStructure::shared_pointer response = client->request(pvRequest, timeout);
 #endif // if defined PVA_RPC_API_VERSION && PVA_RPC_API_VERSION == 440
 
+        RpcClientPool::release(channelName, client);
         return response;
     }
     catch (const epics::pvAccess::RPCRequestException& ex) {
+        RpcClientPool::discard(client);
         throw PvaException(ex.what());
     }
     catch (std::exception& ex) {
+        RpcClientPool::discard(client);
         throw PvaException(ex.what());
     }
     catch (...) {
+        RpcClientPool::discard(client);
         throw PvaException("Unexpected error caught in RpcClient::request().");
     }
 }
@@ -73,8 +139,23 @@ epics::pvData::PVStructure::shared_pointer RpcClient::request(const epics::pvDat
 
 //PvObject* RpcClient::request(const PvObject& pvObject, double timeout) 
 PvObject* RpcClient::invoke(const PvObject& pvObject) 
+{
+    return invoke(pvObject, DefaultTimeout);
+}
+
+PvObject* RpcClient::invoke(const PvObject& pvObject, double timeout) 
 {
     epics::pvData::PVStructurePtr pvStructurePtr = pvObject.getPvStructurePtr();
-    PvObject* response = new PvObject(request(pvStructurePtr));
+    PvObject* response = new PvObject(request(pvStructurePtr, timeout));
     return response;
 }
+
+void RpcClient::invokeAsync(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback, double timeout)
+{
+    // Request data must be copied, as object may be modified
+    // before request is issued
+    epics::pvData::PVStructurePtr pvStructurePtr = epics::pvData::getPVDataCreate()->createPVStructure(pvObject.getPvStructurePtr());
+    ChannelAsyncRequestPtr request(new RpcAsyncRequest(channelName, pvStructurePtr, timeout));
+    request->setCallbacks(pyCallback, pyErrorCallback);
+    ChannelAsyncRequest::dispatch(request);
+}
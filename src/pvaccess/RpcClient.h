@@ -6,18 +6,20 @@
 
 #include <string>
 
+#include "boost/python/object.hpp"
 #include "PvaClient.h"
 #include "PvObject.h"
-#include "pv/event.h" // this should really be in pv/rpcClient.h
-#include "pv/rpcClient.h"
+#include "RpcClientPool.h"
 
 /**
- * RPC client for PV access.
+ * RPC client for PV access. Connections are taken from the process-wide
+ * RPC client pool, so that they are reused by all clients of the same
+ * service.
  */
 class RpcClient : public PvaClient
 {
 public:
-    static const int DefaultTimeout;
+    static const double DefaultTimeout;
 
     RpcClient(const std::string& channelName);
     RpcClient(const RpcClient& pvaRpcClient);
@@ -27,13 +29,16 @@ public:
     virtual epics::pvData::PVStructurePtr request(const epics::pvData::PVStructurePtr& pvRequest, double timeout=DefaultTimeout);
     //virtual PvObject* request(const PvObject& pvObject, double timeout=DefaultTimeout);
     virtual PvObject* invoke(const PvObject& pvObject);
+    virtual PvObject* invoke(const PvObject& pvObject, double timeout);
 
-private:
-    static epics::pvAccess::RPCClient::shared_pointer createRpcClient(const std::string& channelName, const epics::pvData::PVStructurePtr& pvRequest, double timeout=DefaultTimeout);
-    epics::pvAccess::RPCClient::shared_pointer getRpcClient(const epics::pvData::PVStructurePtr& pvRequest, double timeout=DefaultTimeout);
+    // Returns immediately; callbacks are invoked from the asynchronous
+    // request dispatcher thread
+    virtual void invokeAsync(const PvObject& pvObject, const boost::python::object& pyCallback, const boost::python::object& pyErrorCallback=boost::python::object(), double timeout=DefaultTimeout);
+
+    static void setConnectionPoolSize(int connectionPoolSize);
+    static int getConnectionPoolSize();
 
-    bool rpcClientInitialized;
-    epics::pvAccess::RPCClient::shared_pointer rpcClient;
+private:
     std::string channelName;
 };
 
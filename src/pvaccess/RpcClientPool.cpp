@@ -0,0 +1,101 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "RpcClientPool.h"
+
+const int RpcClientPool::DefaultMaxIdleClients(0);
+
+PvaPyLogger RpcClientPool::logger("RpcClientPool");
+epics::pvData::Mutex RpcClientPool::mutex;
+int RpcClientPool::maxIdleClients(DefaultMaxIdleClients);
+
+// Pool is never deleted, so that pooled clients are not destroyed
+// during static destruction, after pvAccess may have been shut down
+RpcClientPool::RpcClientMap* RpcClientPool::idleClientMap(new RpcClientPool::RpcClientMap());
+
+void RpcClientPool::setMaxIdleClients(int maxIdleClients)
+{
+    if (maxIdleClients < 0) {
+        maxIdleClients = DefaultMaxIdleClients;
+    }
+    RpcClientList surplusClients;
+    {
+        epics::pvData::Lock lock(mutex);
+        RpcClientPool::maxIdleClients = maxIdleClients;
+        if (maxIdleClients == 0) {
+            return;
+        }
+        RpcClientMap::iterator iter;
+        for (iter = idleClientMap->begin(); iter != idleClientMap->end(); iter++) {
+            RpcClientList& idleClients = iter->second;
+            while (int(idleClients.size()) > maxIdleClients) {
+                surplusClients.push_back(idleClients.back());
+                idleClients.pop_back();
+            }
+        }
+    }
+
+    // Clients are destroyed without holding pool lock
+    RpcClientList::iterator iter;
+    for (iter = surplusClients.begin(); iter != surplusClients.end(); iter++) {
+        discard(*iter);
+    }
+}
+
+int RpcClientPool::getMaxIdleClients()
+{
+    epics::pvData::Lock lock(mutex);
+    return maxIdleClients;
+}
+
+epics::pvAccess::RPCClient::shared_pointer RpcClientPool::createRpcClient(const std::string& channelName)
+{
+#if defined PVA_RPC_API_VERSION && PVA_RPC_API_VERSION == 440
+    return epics::pvAccess::RPCClient::create(channelName);
+#endif // if defined PVA_RPC_API_VERSION && PVA_RPC_API_VERSION == 440
+}
+
+epics::pvAccess::RPCClient::shared_pointer RpcClientPool::acquire(const std::string& channelName, bool issueConnect)
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        RpcClientMap::iterator iter = idleClientMap->find(channelName);
+        if (iter != idleClientMap->end() && !iter->second.empty()) {
+            epics::pvAccess::RPCClient::shared_pointer rpcClient = iter->second.back();
+            iter->second.pop_back();
+            return rpcClient;
+        }
+    }
+    logger.debug("Creating new RPC client for channel %s", channelName.c_str());
+    epics::pvAccess::RPCClient::shared_pointer rpcClient = createRpcClient(channelName);
+    if (issueConnect) {
+        rpcClient->issueConnect();
+    }
+    return rpcClient;
+}
+
+void RpcClientPool::release(const std::string& channelName, const epics::pvAccess::RPCClient::shared_pointer& rpcClient)
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        RpcClientList& idleClients = (*idleClientMap)[channelName];
+        if (maxIdleClients == 0 || int(idleClients.size()) < maxIdleClients) {
+            idleClients.push_back(rpcClient);
+            return;
+        }
+    }
+    discard(rpcClient);
+}
+
+void RpcClientPool::discard(const epics::pvAccess::RPCClient::shared_pointer& rpcClient)
+{
+    if (!rpcClient) {
+        return;
+    }
+    try {
+        rpcClient->destroy();
+    }
+    catch (const std::exception& ex) {
+        logger.warn("Error destroying RPC client: %s", ex.what());
+    }
+}
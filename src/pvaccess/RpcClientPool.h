@@ -0,0 +1,61 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef RPC_CLIENT_POOL_H
+#define RPC_CLIENT_POOL_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "pv/pvData.h"
+#include "pv/event.h" // this should really be in pv/rpcClient.h
+#include "pv/rpcClient.h"
+#include "PvaPyLogger.h"
+
+//
+// Process-wide pool of idle pvAccess RPC clients, keyed by service
+// channel name.
+//
+// Each pvAccess RPC client handles one request at a time, but clients
+// for services on the same server share network connection, so that
+// requests issued with different clients are in flight at the same time.
+// Clients are taken from the pool for the duration of one request, and
+// are returned to it after successful response; clients whose requests
+// failed are destroyed, since their state is unknown. Unless limited,
+// pool keeps all idle clients, so that it grows to the largest number
+// of requests that were in flight at the same time for the channel.
+//
+class RpcClientPool
+{
+public:
+    static const int DefaultMaxIdleClients;
+
+    // Limits number of idle clients kept per service channel; zero means
+    // no limit
+    static void setMaxIdleClients(int maxIdleClients);
+    static int getMaxIdleClients();
+
+    // If issueConnect is set, connection of newly created client is
+    // issued before it is returned, so that caller can start connecting
+    // several clients before waiting for any of them; pooled clients are
+    // already connected
+    static epics::pvAccess::RPCClient::shared_pointer acquire(const std::string& channelName, bool issueConnect=false);
+    static void release(const std::string& channelName, const epics::pvAccess::RPCClient::shared_pointer& rpcClient);
+
+    // Destroys client instead of returning it to the pool; null client
+    // is ignored
+    static void discard(const epics::pvAccess::RPCClient::shared_pointer& rpcClient);
+
+private:
+    typedef std::vector<epics::pvAccess::RPCClient::shared_pointer> RpcClientList;
+    typedef std::map<std::string, RpcClientList> RpcClientMap;
+
+    static epics::pvAccess::RPCClient::shared_pointer createRpcClient(const std::string& channelName);
+
+    static PvaPyLogger logger;
+    static epics::pvData::Mutex mutex;
+    static RpcClientMap* idleClientMap;
+    static int maxIdleClients;
+};
+
+#endif
@@ -0,0 +1,93 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "RpcRequest.h"
+#include "RpcServiceImpl.h"
+
+#if PVA_API_VERSION >= 450
+RpcRequest::RpcRequest(const RpcServiceImplPtr& service_, const epics::pvData::PVStructurePtr& args_, const epics::pvAccess::RPCResponseCallback::shared_pointer& callback_) :
+    service(service_),
+    args(args_),
+    receiveTime(epicsTime::getCurrent()),
+    callback(callback_)
+{
+}
+#else
+RpcRequest::RpcRequest(const RpcServiceImplPtr& service_, const epics::pvData::PVStructurePtr& args_) :
+    service(service_),
+    args(args_),
+    receiveTime(epicsTime::getCurrent()),
+    status(),
+    result(),
+    completionEvent()
+{
+}
+#endif
+
+RpcRequest::~RpcRequest()
+{
+}
+
+std::string RpcRequest::getServiceName() const
+{
+    return service->getServiceName();
+}
+
+void RpcRequest::process()
+{
+    try {
+        epics::pvData::PVStructurePtr result = service->processRequest(args);
+        complete(epics::pvData::Status::Ok, result);
+    }
+    catch (const epics::pvAccess::RPCRequestException& ex) {
+        complete(epics::pvData::Status(ex.getStatus(), ex.what()), epics::pvData::PVStructurePtr());
+    }
+    catch (const std::exception& ex) {
+        complete(epics::pvData::Status(epics::pvData::Status::STATUSTYPE_ERROR, ex.what()), epics::pvData::PVStructurePtr());
+    }
+    catch (...) {
+        complete(epics::pvData::Status(epics::pvData::Status::STATUSTYPE_ERROR, "Service " + getServiceName() + " failed with unknown error."), epics::pvData::PVStructurePtr());
+    }
+}
+
+void RpcRequest::reject(const std::string& reason)
+{
+    service->getMetrics()->addRejectedRequest();
+    respond(epics::pvData::Status(epics::pvData::Status::STATUSTYPE_ERROR, reason), epics::pvData::PVStructurePtr());
+}
+
+void RpcRequest::complete(const epics::pvData::Status& status, const epics::pvData::PVStructurePtr& result)
+{
+    // Metrics are updated before response is sent, so that they include
+    // all requests whose responses were received by clients
+    double latency = epicsTime::getCurrent() - receiveTime;
+    service->getMetrics()->addRequest(latency, status.isSuccess());
+    respond(status, result);
+}
+
+#if PVA_API_VERSION >= 450
+
+void RpcRequest::respond(const epics::pvData::Status& status, const epics::pvData::PVStructurePtr& result)
+{
+    callback->requestDone(status, result);
+}
+
+#else
+
+void RpcRequest::respond(const epics::pvData::Status& status, const epics::pvData::PVStructurePtr& result)
+{
+    this->status = status;
+    this->result = result;
+    completionEvent.signal();
+}
+
+epics::pvData::PVStructurePtr RpcRequest::waitForCompletion()
+{
+    completionEvent.wait();
+    if (!status.isSuccess()) {
+        throw epics::pvAccess::RPCRequestException(status.getType(), status.getMessage());
+    }
+    return result;
+}
+
+#endif
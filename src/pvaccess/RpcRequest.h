@@ -0,0 +1,65 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef RPC_REQUEST_H
+#define RPC_REQUEST_H
+
+#include <string>
+#include "pv/pvData.h"
+#include "pv/pvAccess.h"
+#include "pv/rpcServer.h"
+#include "epicsEvent.h"
+#include "epicsTime.h"
+
+class RpcServiceImpl;
+
+//
+// RPC request received by server, which is processed by one of the
+// request dispatcher worker threads. With pvAccess 4.5 response is sent
+// via callback as soon as request is processed; older pvAccess versions
+// wait for completion in the server thread that received request.
+//
+class RpcRequest
+{
+public:
+    POINTER_DEFINITIONS(RpcRequest);
+
+#if PVA_API_VERSION >= 450
+    RpcRequest(const std::tr1::shared_ptr<RpcServiceImpl>& service, const epics::pvData::PVStructurePtr& args, const epics::pvAccess::RPCResponseCallback::shared_pointer& callback);
+#else
+    RpcRequest(const std::tr1::shared_ptr<RpcServiceImpl>& service, const epics::pvData::PVStructurePtr& args);
+#endif
+    virtual ~RpcRequest();
+
+    std::string getServiceName() const;
+
+    // Invokes service and completes request; completed requests are
+    // recorded in service metrics
+    void process();
+
+    // Completes request with error status, without invoking service
+    void reject(const std::string& reason);
+
+#if PVA_API_VERSION < 450
+    epics::pvData::PVStructurePtr waitForCompletion();
+#endif
+
+private:
+    void complete(const epics::pvData::Status& status, const epics::pvData::PVStructurePtr& result);
+    void respond(const epics::pvData::Status& status, const epics::pvData::PVStructurePtr& result);
+
+    std::tr1::shared_ptr<RpcServiceImpl> service;
+    epics::pvData::PVStructurePtr args;
+    epicsTime receiveTime;
+#if PVA_API_VERSION >= 450
+    epics::pvAccess::RPCResponseCallback::shared_pointer callback;
+#else
+    epics::pvData::Status status;
+    epics::pvData::PVStructurePtr result;
+    epicsEvent completionEvent;
+#endif
+};
+
+typedef RpcRequest::shared_pointer RpcRequestPtr;
+
+#endif
@@ -0,0 +1,283 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "epicsTime.h"
+#include "RpcRequestDispatcher.h"
+#include "StringUtility.h"
+
+const int RpcRequestDispatcher::DefaultWorkerPoolSize(4);
+const int RpcRequestDispatcher::DefaultMaxPendingRequests(1000);
+const int RpcRequestDispatcher::Unlimited(0);
+
+PvaPyLogger RpcRequestDispatcher::logger("RpcRequestDispatcher");
+
+RpcRequestDispatcher::RpcRequestDispatcher() :
+    mutex(),
+    readyEvent(),
+    workerExitEvent(),
+    idleEvent(),
+    pendingRequests(),
+    serviceConcurrencyLimits(),
+    activeServiceRequests(),
+    workerThreadIds(),
+    workerPoolSize(DefaultWorkerPoolSize),
+    maxPendingRequests(DefaultMaxPendingRequests),
+    nWorkers(0),
+    nActiveRequests(0),
+    draining(false),
+    stopped(false)
+{
+}
+
+RpcRequestDispatcher::~RpcRequestDispatcher()
+{
+    stop();
+}
+
+void RpcRequestDispatcher::setWorkerPoolSize(int workerPoolSize)
+{
+    if (workerPoolSize < 1) {
+        workerPoolSize = DefaultWorkerPoolSize;
+    }
+    epics::pvData::Lock lock(mutex);
+    this->workerPoolSize = workerPoolSize;
+    if (nWorkers > 0) {
+        // Add missing workers right away; surplus workers exit when
+        // they wake up
+        startWorkers();
+        readyEvent.signal();
+    }
+}
+
+int RpcRequestDispatcher::getWorkerPoolSize()
+{
+    epics::pvData::Lock lock(mutex);
+    return workerPoolSize;
+}
+
+void RpcRequestDispatcher::setMaxPendingRequests(int maxPendingRequests)
+{
+    if (maxPendingRequests < 1) {
+        maxPendingRequests = DefaultMaxPendingRequests;
+    }
+    epics::pvData::Lock lock(mutex);
+    this->maxPendingRequests = maxPendingRequests;
+}
+
+int RpcRequestDispatcher::getMaxPendingRequests()
+{
+    epics::pvData::Lock lock(mutex);
+    return maxPendingRequests;
+}
+
+void RpcRequestDispatcher::setServiceConcurrencyLimit(const std::string& serviceName, int maxConcurrentRequests)
+{
+    if (maxConcurrentRequests < 0) {
+        maxConcurrentRequests = Unlimited;
+    }
+    epics::pvData::Lock lock(mutex);
+    serviceConcurrencyLimits[serviceName] = maxConcurrentRequests;
+
+    // Raised limit may allow waiting requests to proceed
+    readyEvent.signal();
+}
+
+int RpcRequestDispatcher::getServiceConcurrencyLimit(const std::string& serviceName)
+{
+    epics::pvData::Lock lock(mutex);
+    std::map<std::string, int>::const_iterator iter = serviceConcurrencyLimits.find(serviceName);
+    if (iter == serviceConcurrencyLimits.end()) {
+        return Unlimited;
+    }
+    return iter->second;
+}
+
+void RpcRequestDispatcher::removeServiceConcurrencyLimit(const std::string& serviceName)
+{
+    epics::pvData::Lock lock(mutex);
+    serviceConcurrencyLimits.erase(serviceName);
+    readyEvent.signal();
+}
+
+// Must be called with mutex held
+void RpcRequestDispatcher::startWorkers()
+{
+    while (nWorkers < workerPoolSize) {
+        // Worker takes ownership of its dispatcher reference
+        RpcRequestDispatcherPtr* dispatcherPtr = new RpcRequestDispatcherPtr(shared_from_this());
+        epicsThreadCreate("RpcRequestWorkerThread", epicsThreadPriorityMedium, epicsThreadGetStackSize(epicsThreadStackMedium), (EPICSTHREADFUNC)workerThread, dispatcherPtr);
+        nWorkers++;
+    }
+}
+
+void RpcRequestDispatcher::submit(const RpcRequestPtr& request)
+{
+    std::string rejectReason;
+    {
+        epics::pvData::Lock lock(mutex);
+        if (draining || stopped) {
+            rejectReason = "RPC server is shutting down.";
+        }
+        else if (int(pendingRequests.size()) >= maxPendingRequests) {
+            rejectReason = "RPC server is busy: " + StringUtility::toString(maxPendingRequests) + " requests are already pending.";
+        }
+        else {
+            startWorkers();
+            pendingRequests.push_back(request);
+            readyEvent.signal();
+            return;
+        }
+    }
+    logger.warn("Rejecting request for service %s: %s", request->getServiceName().c_str(), rejectReason.c_str());
+    request->reject(rejectReason);
+}
+
+// Must be called with mutex held
+bool RpcRequestDispatcher::canProcess(const std::string& serviceName)
+{
+    std::map<std::string, int>::const_iterator iter = serviceConcurrencyLimits.find(serviceName);
+    if (iter == serviceConcurrencyLimits.end() || iter->second == Unlimited) {
+        return true;
+    }
+    return (activeServiceRequests[serviceName] < iter->second);
+}
+
+// Must be called with mutex held
+bool RpcRequestDispatcher::isWorkerThread()
+{
+    return (workerThreadIds.find(epicsThreadGetIdSelf()) != workerThreadIds.end());
+}
+
+bool RpcRequestDispatcher::isCalledFromWorker()
+{
+    epics::pvData::Lock lock(mutex);
+    return isWorkerThread();
+}
+
+RpcRequestPtr RpcRequestDispatcher::waitForRequest()
+{
+    while (true) {
+        {
+            epics::pvData::Lock lock(mutex);
+            workerThreadIds.insert(epicsThreadGetIdSelf());
+            if (stopped || nWorkers > workerPoolSize) {
+                workerThreadIds.erase(epicsThreadGetIdSelf());
+                nWorkers--;
+                // Wake up other workers, which may also need to exit
+                readyEvent.signal();
+                workerExitEvent.signal();
+                return RpcRequestPtr();
+            }
+            std::deque<RpcRequestPtr>::iterator iter;
+            for (iter = pendingRequests.begin(); iter != pendingRequests.end(); iter++) {
+                std::string serviceName = (*iter)->getServiceName();
+                if (canProcess(serviceName)) {
+                    RpcRequestPtr request = *iter;
+                    pendingRequests.erase(iter);
+                    activeServiceRequests[serviceName]++;
+                    nActiveRequests++;
+
+                    // Event is binary, so the next waiting worker is woken
+                    // up here if there may be more work
+                    if (!pendingRequests.empty()) {
+                        readyEvent.signal();
+                    }
+                    return request;
+                }
+            }
+        }
+        readyEvent.wait();
+    }
+}
+
+void RpcRequestDispatcher::completeRequest(const RpcRequestPtr& request)
+{
+    epics::pvData::Lock lock(mutex);
+    std::string serviceName = request->getServiceName();
+    if (--activeServiceRequests[serviceName] <= 0) {
+        activeServiceRequests.erase(serviceName);
+    }
+    nActiveRequests--;
+    if (draining) {
+        idleEvent.signal();
+    }
+
+    // Requests waiting for this service may proceed now
+    if (!pendingRequests.empty()) {
+        readyEvent.signal();
+    }
+}
+
+bool RpcRequestDispatcher::drain(double timeout)
+{
+    epicsTime deadline = epicsTime::getCurrent() + timeout;
+    while (true) {
+        {
+            epics::pvData::Lock lock(mutex);
+            draining = true;
+
+            // Request of the calling worker cannot complete while it waits
+            int nSelfRequests = (isWorkerThread() ? 1 : 0);
+            if (pendingRequests.empty() && nActiveRequests <= nSelfRequests) {
+                return true;
+            }
+        }
+        double remainingTime = deadline - epicsTime::getCurrent();
+        if (remainingTime <= 0) {
+            logger.warn("Timed out draining RPC requests");
+            return false;
+        }
+        idleEvent.wait(remainingTime);
+    }
+}
+
+void RpcRequestDispatcher::stop()
+{
+    std::deque<RpcRequestPtr> rejectedRequests;
+    {
+        epics::pvData::Lock lock(mutex);
+        if (stopped && nWorkers == 0) {
+            return;
+        }
+        stopped = true;
+        rejectedRequests.swap(pendingRequests);
+        readyEvent.signal();
+    }
+
+    std::deque<RpcRequestPtr>::iterator iter;
+    for (iter = rejectedRequests.begin(); iter != rejectedRequests.end(); iter++) {
+        (*iter)->reject("RPC server is shutting down.");
+    }
+
+    // Workers exit after completing their current requests; calling
+    // worker exits after it returns
+    while (true) {
+        {
+            epics::pvData::Lock lock(mutex);
+            int nSelfWorkers = (isWorkerThread() ? 1 : 0);
+            if (nWorkers <= nSelfWorkers) {
+                break;
+            }
+        }
+        workerExitEvent.wait();
+    }
+    logger.debug("All worker threads exited");
+}
+
+void RpcRequestDispatcher::workerThread(RpcRequestDispatcherPtr* dispatcherPtr)
+{
+    // Dispatcher may be released by everyone else while worker is still
+    // running; it is destroyed when the last worker exits
+    RpcRequestDispatcherPtr dispatcher(*dispatcherPtr);
+    delete dispatcherPtr;
+    logger.debug("Started RPC worker thread %s", epicsThreadGetNameSelf());
+    while (true) {
+        RpcRequestPtr request = dispatcher->waitForRequest();
+        if (!request) {
+            break;
+        }
+        request->process();
+        dispatcher->completeRequest(request);
+    }
+    logger.debug("Exiting RPC worker thread %s", epicsThreadGetNameSelf());
+}
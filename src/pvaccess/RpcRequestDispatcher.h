@@ -0,0 +1,97 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef RPC_REQUEST_DISPATCHER_H
+#define RPC_REQUEST_DISPATCHER_H
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include "pv/pvData.h"
+#include "epicsEvent.h"
+#include "epicsThread.h"
+#include "RpcRequest.h"
+#include "PvaPyLogger.h"
+
+//
+// Pool of worker threads that process RPC requests for one server.
+//
+// Requests are queued by pvAccess server threads and processed in order
+// of arrival, except that requests for a service that already has its
+// maximum number of requests in progress wait until one of them
+// completes. Requests that arrive while the pending queue is full, or
+// after dispatcher starts draining, are rejected with error status.
+//
+// Dispatcher may be drained and stopped from one of its own workers (e.g.,
+// by service that shuts down server); that worker is then not waited for.
+// Each worker holds a reference to dispatcher, so that dispatcher is not
+// destroyed before all of its workers exit; it must therefore be owned
+// by a shared pointer.
+//
+class RpcRequestDispatcher : public std::tr1::enable_shared_from_this<RpcRequestDispatcher>
+{
+public:
+    POINTER_DEFINITIONS(RpcRequestDispatcher);
+
+    static const int DefaultWorkerPoolSize;
+    static const int DefaultMaxPendingRequests;
+    static const int Unlimited;
+
+    RpcRequestDispatcher();
+    virtual ~RpcRequestDispatcher();
+
+    void setWorkerPoolSize(int workerPoolSize);
+    int getWorkerPoolSize();
+    void setMaxPendingRequests(int maxPendingRequests);
+    int getMaxPendingRequests();
+
+    // Concurrency limit of Unlimited (0) allows service to use all workers
+    void setServiceConcurrencyLimit(const std::string& serviceName, int maxConcurrentRequests);
+    int getServiceConcurrencyLimit(const std::string& serviceName);
+    void removeServiceConcurrencyLimit(const std::string& serviceName);
+
+    void submit(const RpcRequestPtr& request);
+
+    // Stops accepting requests, and waits until all accepted requests are
+    // completed or until timeout expires. Returns true if dispatcher is
+    // idle. Must be called without holding python GIL, as workers may
+    // need it to complete their requests.
+    bool drain(double timeout);
+
+    // Rejects pending requests and waits for requests in progress to
+    // complete. Must be called without holding python GIL.
+    void stop();
+
+    // Returns true if called from one of dispatcher workers
+    bool isCalledFromWorker();
+
+private:
+    static PvaPyLogger logger;
+    static void workerThread(shared_pointer* dispatcherPtr);
+
+    void startWorkers();
+    RpcRequestPtr waitForRequest();
+    void completeRequest(const RpcRequestPtr& request);
+    bool canProcess(const std::string& serviceName);
+    bool isWorkerThread();
+
+    epics::pvData::Mutex mutex;
+    epicsEvent readyEvent;
+    epicsEvent workerExitEvent;
+    epicsEvent idleEvent;
+    std::deque<RpcRequestPtr> pendingRequests;
+    std::map<std::string, int> serviceConcurrencyLimits;
+    std::map<std::string, int> activeServiceRequests;
+    std::set<epicsThreadId> workerThreadIds;
+    int workerPoolSize;
+    int maxPendingRequests;
+    int nWorkers;
+    int nActiveRequests;
+    bool draining;
+    bool stopped;
+};
+
+typedef RpcRequestDispatcher::shared_pointer RpcRequestDispatcherPtr;
+
+#endif
@@ -2,51 +2,161 @@
 // found in the file LICENSE that is included with the distribution
 
 #include "RpcServer.h"
+#include "PyRpcServiceImpl.h"
 #include "PyGilManager.h"
+#include "PyGilRelease.h"
 #include "InvalidState.h"
+#include "ObjectNotFound.h"
 
 PvaPyLogger RpcServer::logger("RpcServer");
-const double RpcServer::ShutdownWaitTime(0.1);
+const double RpcServer::DefaultDrainTimeout(5.0);
 
 RpcServer::RpcServer() :
     epics::pvAccess::RPCServer(),
-    destroyed(false)
+    requestDispatcher(new RpcRequestDispatcher()),
+    serviceMetricsMap(),
+    mutex(),
+    listenerExitEvent(),
+    shutdownCompleteEvent(),
+    listenerRunning(false),
+    destroyed(false),
+    shutdownComplete(false)
 {
 }
 
 RpcServer::~RpcServer() 
 {
-    shutdown();
-    epicsThreadSleep(ShutdownWaitTime);
+    try {
+        shutdown();
+    }
+    catch (const std::exception& ex) {
+        logger.error("Error shutting down server: %s", ex.what());
+    }
 }
 
-void RpcServer::registerService(const std::string& serviceName, const boost::python::object& pyService)
+void RpcServer::registerService(const std::string& serviceName, const boost::python::object& pyService, int maxConcurrentRequests)
 {
-    epics::pvAccess::RPCService::shared_pointer rpcServiceImplPtr(new RpcServiceImpl(pyService));
-    epics::pvAccess::RPCServer::registerService(serviceName, rpcServiceImplPtr);
+    // Service python callable is invoked from worker threads
+    PyGilManager::evalInitThreads();
+    requestDispatcher->setServiceConcurrencyLimit(serviceName, maxConcurrentRequests);
+    RpcServiceImplPtr rpcServiceImplPtr(new PyRpcServiceImpl(serviceName, pyService, requestDispatcher));
+    addServiceMetrics(serviceName, rpcServiceImplPtr);
+#if PVA_API_VERSION >= 450
+    epics::pvAccess::RPCServiceAsync::shared_pointer rpcServicePtr(rpcServiceImplPtr);
+#else
+    epics::pvAccess::RPCService::shared_pointer rpcServicePtr(rpcServiceImplPtr);
+#endif
+    epics::pvAccess::RPCServer::registerService(serviceName, rpcServicePtr);
+}
+
+void RpcServer::registerNativeService(const std::string& serviceName, const RpcServiceHandler& handler, bool processInServerThread, int maxConcurrentRequests)
+{
+    requestDispatcher->setServiceConcurrencyLimit(serviceName, maxConcurrentRequests);
+    RpcServiceImplPtr rpcServiceImplPtr(new NativeRpcServiceImpl(serviceName, handler, requestDispatcher, processInServerThread));
+    addServiceMetrics(serviceName, rpcServiceImplPtr);
+#if PVA_API_VERSION >= 450
+    epics::pvAccess::RPCServiceAsync::shared_pointer rpcServicePtr(rpcServiceImplPtr);
+#else
+    epics::pvAccess::RPCService::shared_pointer rpcServicePtr(rpcServiceImplPtr);
+#endif
+    epics::pvAccess::RPCServer::registerService(serviceName, rpcServicePtr);
 }
 
 void RpcServer::unregisterService(const std::string& serviceName)
 {
     epics::pvAccess::RPCServer::unregisterService(serviceName);
+    requestDispatcher->removeServiceConcurrencyLimit(serviceName);
+    epics::pvData::Lock lock(mutex);
+    serviceMetricsMap.erase(serviceName);
+}
+
+void RpcServer::addServiceMetrics(const std::string& serviceName, const RpcServiceImplPtr& rpcServiceImplPtr)
+{
+    epics::pvData::Lock lock(mutex);
+    serviceMetricsMap[serviceName] = rpcServiceImplPtr->getMetrics();
+}
+
+boost::python::dict RpcServer::getMetrics()
+{
+    epics::pvData::Lock lock(mutex);
+    boost::python::dict pyDict;
+    std::map<std::string, RpcServiceMetricsPtr>::iterator iter;
+    for (iter = serviceMetricsMap.begin(); iter != serviceMetricsMap.end(); iter++) {
+        pyDict[iter->first] = iter->second->toPyDict();
+    }
+    return pyDict;
+}
+
+boost::python::dict RpcServer::getServiceMetrics(const std::string& serviceName)
+{
+    epics::pvData::Lock lock(mutex);
+    std::map<std::string, RpcServiceMetricsPtr>::iterator iter = serviceMetricsMap.find(serviceName);
+    if (iter == serviceMetricsMap.end()) {
+        throw ObjectNotFound("Service " + serviceName + " is not registered.");
+    }
+    return iter->second->toPyDict();
+}
+
+void RpcServer::resetMetrics()
+{
+    epics::pvData::Lock lock(mutex);
+    std::map<std::string, RpcServiceMetricsPtr>::iterator iter;
+    for (iter = serviceMetricsMap.begin(); iter != serviceMetricsMap.end(); iter++) {
+        iter->second->reset();
+    }
+}
+
+void RpcServer::setWorkerPoolSize(int workerPoolSize)
+{
+    requestDispatcher->setWorkerPoolSize(workerPoolSize);
+}
+
+int RpcServer::getWorkerPoolSize()
+{
+    return requestDispatcher->getWorkerPoolSize();
+}
+
+void RpcServer::setMaxPendingRequests(int maxPendingRequests)
+{
+    requestDispatcher->setMaxPendingRequests(maxPendingRequests);
+}
+
+int RpcServer::getMaxPendingRequests()
+{
+    return requestDispatcher->getMaxPendingRequests();
+}
+
+void RpcServer::setServiceConcurrencyLimit(const std::string& serviceName, int maxConcurrentRequests)
+{
+    requestDispatcher->setServiceConcurrencyLimit(serviceName, maxConcurrentRequests);
+}
+
+int RpcServer::getServiceConcurrencyLimit(const std::string& serviceName)
+{
+    return requestDispatcher->getServiceConcurrencyLimit(serviceName);
 }
 
 void RpcServer::startListener()
 {
+    epics::pvData::Lock lock(mutex);
     if (destroyed) {
         throw InvalidState("Invalid state: server has been shutdown and cannot be restarted.");
     }
+    if (listenerRunning) {
+        throw InvalidState("Invalid state: server listener is already running.");
+    }
 
     // One must call PyEval_InitThreads() in the main thread
     // to initialize thread state, which is needed for proper functioning
     // of PyGILState_Ensure()/PyGILState_Release().
     PyGilManager::evalInitThreads();
     epicsThreadCreate("RpcServerListenerThread", epicsThreadPriorityLow, epicsThreadGetStackSize(epicsThreadStackSmall), (EPICSTHREADFUNC)listenerThread, this);
+    listenerRunning = true;
 }
 
-void RpcServer::stopListener()
+void RpcServer::stopListener(double drainTimeout)
 {
-    shutdown();
+    shutdown(drainTimeout);
 }
 
 void RpcServer::listenerThread(RpcServer* server)
@@ -61,6 +171,10 @@ void RpcServer::listenerThread(RpcServer* server)
     // Not good.
         logger.error("Exception caught in listener thread %s: %s", epicsThreadGetNameSelf(), ex.what());
     }
+
+    // Server may be deleted as soon as this event is signalled
+    logger.debug("Exiting listener thread %s", epicsThreadGetNameSelf());
+    server->listenerExitEvent.signal();
 }
 
 void RpcServer::listen(int seconds)
@@ -68,9 +182,28 @@ void RpcServer::listen(int seconds)
     if (destroyed) {
         throw InvalidState("Invalid state: server has been shutdown and cannot be restarted.");
     }
+    {
+        epics::pvData::Lock lock(mutex);
+        if (listenerRunning) {
+            throw InvalidState("Invalid state: server listener is already running.");
+        }
+    }
     printInfo();
-    run(seconds);
-    destroyed = true;
+
+    // Worker threads need GIL to invoke python services; server may
+    // also be used by C++ programs without python interpreter
+    if (!PyGilManager::isGilHeld()) {
+        run(seconds);
+    }
+    else {
+        PyGilManager::evalInitThreads();
+        PyGilRelease pyGilRelease;
+        run(seconds);
+    }
+
+    // Server that stopped listening after given time is shut down here;
+    // otherwise, shutdown was already started by another thread
+    shutdown();
 }
 
 void RpcServer::start()
@@ -78,14 +211,94 @@ void RpcServer::start()
     listen();
 }
 
-void RpcServer::stop()
+void RpcServer::stop(double drainTimeout)
 {
-    shutdown();
+    shutdown(drainTimeout);
+}
+
+void RpcServer::shutdown(double drainTimeout)
+{
+    bool shutdownStarted = false;
+    {
+        epics::pvData::Lock lock(mutex);
+        shutdownStarted = destroyed;
+        destroyed = true;
+    }
+    if (shutdownStarted) {
+        waitForShutdown();
+        return;
+    }
+
+    // Workers may need GIL to complete requests in progress
+    try {
+        if (!PyGilManager::isGilHeld()) {
+            destroyServer(drainTimeout);
+        }
+        else {
+            PyGilRelease pyGilRelease;
+            destroyServer(drainTimeout);
+        }
+    }
+    catch (...) {
+        completeShutdown();
+        throw;
+    }
+    completeShutdown();
+}
+
+void RpcServer::completeShutdown()
+{
+    {
+        epics::pvData::Lock lock(mutex);
+        shutdownComplete = true;
+    }
+    shutdownCompleteEvent.signal();
 }
 
-void RpcServer::shutdown()
+void RpcServer::waitForShutdown()
 {
-    destroyed = true;
+    // Worker is waited for by the thread that is shutting down
+    // server, so it must not wait for that thread
+    if (requestDispatcher->isCalledFromWorker()) {
+        return;
+    }
+    if (!PyGilManager::isGilHeld()) {
+        waitForShutdownComplete();
+    }
+    else {
+        PyGilRelease pyGilRelease;
+        waitForShutdownComplete();
+    }
+}
+
+void RpcServer::waitForShutdownComplete()
+{
+    while (true) {
+        {
+            epics::pvData::Lock lock(mutex);
+            if (shutdownComplete) {
+                break;
+            }
+        }
+        shutdownCompleteEvent.wait();
+    }
+
+    // Event is binary, so the next waiting thread is woken up here
+    shutdownCompleteEvent.signal();
+}
+
+void RpcServer::destroyServer(double drainTimeout)
+{
+    // Server context must exist until responses to drained requests are
+    // sent, and it stops listener when it is destroyed
+    logger.debug("Draining requests, timeout is %f seconds", drainTimeout);
+    requestDispatcher->drain(drainTimeout);
+    requestDispatcher->stop();
     epics::pvAccess::RPCServer::destroy();
+    if (listenerRunning) {
+        listenerExitEvent.wait();
+        listenerRunning = false;
+    }
+    logger.debug("Server is shut down");
 }
 
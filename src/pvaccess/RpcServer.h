@@ -4,34 +4,87 @@
 #ifndef RPC_SERVER_H
 #define RPC_SERVER_H
 
+#include <map>
 #include <string>
 #include "pv/pvData.h"
 #include "pv/pvAccess.h"
 #include "pv/rpcServer.h"
 #include "boost/python/object.hpp"
+#include "boost/python/dict.hpp"
+#include "epicsEvent.h"
 #include "RpcServiceImpl.h"
+#include "NativeRpcServiceImpl.h"
+#include "RpcRequestDispatcher.h"
+#include "RpcServiceMetrics.h"
 #include "PvaPyLogger.h"
 
+//
+// RPC server. Server accepts connections as soon as it is created, and
+// serves requests while listening, either in the calling thread, or in
+// the background listener thread.
+//
+// On shutdown server stops accepting new requests, and waits for accepted
+// requests to complete until drain timeout expires; requests still
+// pending after that are rejected, while requests in progress are always
+// allowed to complete. Server is then destroyed, and listener thread is
+// waited for. Shutdown requested while another thread is already shutting
+// down server waits for that shutdown to complete, unless it is requested
+// by service from one of the worker threads.
+//
 class RpcServer : public epics::pvAccess::RPCServer
 {
 public:
+    static const double DefaultDrainTimeout;
+
     RpcServer();
     virtual ~RpcServer();
-    void registerService(const std::string& serviceName, const boost::python::object& pyService);
+    void registerService(const std::string& serviceName, const boost::python::object& pyService, int maxConcurrentRequests=RpcRequestDispatcher::Unlimited);
     void unregisterService(const std::string& serviceName);
 
+    // Native services are invoked without python GIL; service that
+    // processes requests in server threads avoids handing them over to
+    // worker threads, and is not subject to concurrency limits.
+    void registerNativeService(const std::string& serviceName, const RpcServiceHandler& handler, bool processInServerThread=false, int maxConcurrentRequests=RpcRequestDispatcher::Unlimited);
+
+    // Requests are processed by worker threads, rather than by
+    // pvAccess server threads that receive them
+    void setWorkerPoolSize(int workerPoolSize);
+    int getWorkerPoolSize();
+    void setMaxPendingRequests(int maxPendingRequests);
+    int getMaxPendingRequests();
+    void setServiceConcurrencyLimit(const std::string& serviceName, int maxConcurrentRequests);
+    int getServiceConcurrencyLimit(const std::string& serviceName);
+
+    // Metrics are kept for each registered service
+    boost::python::dict getMetrics();
+    boost::python::dict getServiceMetrics(const std::string& serviceName);
+    void resetMetrics();
+
     void startListener();
-    void stopListener();
+    void stopListener(double drainTimeout=DefaultDrainTimeout);
 
     void listen(int seconds=0);
     void start();
-    void stop();
-    void shutdown();
+    void stop(double drainTimeout=DefaultDrainTimeout);
+    void shutdown(double drainTimeout=DefaultDrainTimeout);
 private:
-    static const double ShutdownWaitTime;
     static PvaPyLogger logger;
     static void listenerThread(RpcServer* rpcServer);
+
+    void addServiceMetrics(const std::string& serviceName, const RpcServiceImplPtr& rpcServiceImplPtr);
+    void destroyServer(double drainTimeout);
+    void completeShutdown();
+    void waitForShutdown();
+    void waitForShutdownComplete();
+
+    RpcRequestDispatcherPtr requestDispatcher;
+    std::map<std::string, RpcServiceMetricsPtr> serviceMetricsMap;
+    epics::pvData::Mutex mutex;
+    epicsEvent listenerExitEvent;
+    epicsEvent shutdownCompleteEvent;
+    bool listenerRunning;
     bool destroyed;
+    bool shutdownComplete;
 };
 
 #endif
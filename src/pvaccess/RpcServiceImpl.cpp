@@ -1,13 +1,13 @@
 // Copyright information and license terms for this software can be
 // found in the file LICENSE that is included with the distribution
 
-#include "boost/python/extract.hpp"
 #include "RpcServiceImpl.h"
-#include "PvObject.h"
-#include "PyGilManager.h"
 
-RpcServiceImpl::RpcServiceImpl(const boost::python::object& pyService_) : 
-    pyService(pyService_)
+RpcServiceImpl::RpcServiceImpl(const std::string& serviceName_, const RpcRequestDispatcherPtr& requestDispatcher_, bool processInServerThread_) :
+    serviceName(serviceName_),
+    requestDispatcher(requestDispatcher_),
+    processInServerThread(processInServerThread_),
+    metrics(new RpcServiceMetrics())
 {
 }
 
@@ -15,24 +15,33 @@ RpcServiceImpl::~RpcServiceImpl()
 {
 }
 
+#if PVA_API_VERSION >= 450
+
+void RpcServiceImpl::request(const epics::pvData::PVStructurePtr& args, const epics::pvAccess::RPCResponseCallback::shared_pointer& callback)
+{
+    RpcRequestPtr request(new RpcRequest(shared_from_this(), args, callback));
+    if (processInServerThread) {
+        request->process();
+        return;
+    }
+    requestDispatcher->submit(request);
+}
+
+#else
+
 epics::pvData::PVStructurePtr RpcServiceImpl::request(const epics::pvData::PVStructurePtr& args)
     throw (epics::pvAccess::RPCRequestException)
 {
-    PvObject pyRequest(args);
-    // Acquire GIL
-    PyGilManager::gilStateEnsure();
-
-    // Process request.
-    boost::python::object pyObject = pyService(pyRequest);
-    
-    // Release GIL. 
-    PyGilManager::gilStateRelease();
-
-    boost::python::extract<PvObject> pvObjectExtract(pyObject);
-    if (!pvObjectExtract.check()) {
-        throw epics::pvAccess::RPCRequestException(epics::pvData::Status::STATUSTYPE_ERROR, "Callable python service object must return instance of PvObject.");
+    // Server thread waits for response, but requests received by other
+    // server threads can be processed in parallel
+    RpcRequestPtr request(new RpcRequest(shared_from_this(), args));
+    if (processInServerThread) {
+        request->process();
+    }
+    else {
+        requestDispatcher->submit(request);
     }
-    PvObject pyResponse = pvObjectExtract();
-    return static_cast<epics::pvData::PVStructurePtr>(pyResponse);
+    return request->waitForCompletion();
 }
 
+#endif
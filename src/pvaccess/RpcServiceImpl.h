@@ -4,21 +4,61 @@
 #ifndef RPC_SERVICE_IMPL_H
 #define RPC_SERVICE_IMPL_H
 
+#include <string>
 #include "pv/pvData.h"
 #include "pv/pvAccess.h"
 #include "pv/rpcServer.h"
-#include "boost/python/object.hpp"
+#include "RpcRequestDispatcher.h"
+#include "RpcServiceMetrics.h"
 
-class RpcServiceImpl : public epics::pvAccess::RPCService
+//
+// Base class for RPC services hosted by RpcServer. Requests are normally
+// not processed in pvAccess server threads, but are handed over to the
+// server request dispatcher; services that process requests in server
+// threads bypass dispatcher queue and its concurrency limits.
+//
+#if PVA_API_VERSION >= 450
+class RpcServiceImpl : public epics::pvAccess::RPCServiceAsync, public std::tr1::enable_shared_from_this<RpcServiceImpl>
+#else
+class RpcServiceImpl : public epics::pvAccess::RPCService, public std::tr1::enable_shared_from_this<RpcServiceImpl>
+#endif
 {
 public:
     POINTER_DEFINITIONS(RpcServiceImpl);
-    RpcServiceImpl(const boost::python::object& pyService);
+    RpcServiceImpl(const std::string& serviceName, const RpcRequestDispatcherPtr& requestDispatcher, bool processInServerThread=false);
     virtual ~RpcServiceImpl();
+
+#if PVA_API_VERSION >= 450
+    virtual void request(const epics::pvData::PVStructurePtr& args, const epics::pvAccess::RPCResponseCallback::shared_pointer& callback);
+#else
     epics::pvData::PVStructurePtr request(const epics::pvData::PVStructurePtr& args)
         throw (epics::pvAccess::RPCRequestException);
+#endif
+
+    std::string getServiceName() const;
+    RpcServiceMetricsPtr getMetrics() const;
+
+    // Invoked by dispatcher worker thread, or by server thread; failures
+    // are reported by throwing exception
+    virtual epics::pvData::PVStructurePtr processRequest(const epics::pvData::PVStructurePtr& args) = 0;
+
 private:
-    boost::python::object pyService;
+    std::string serviceName;
+    RpcRequestDispatcherPtr requestDispatcher;
+    bool processInServerThread;
+    RpcServiceMetricsPtr metrics;
 };
 
+typedef RpcServiceImpl::shared_pointer RpcServiceImplPtr;
+
+inline std::string RpcServiceImpl::getServiceName() const
+{
+    return serviceName;
+}
+
+inline RpcServiceMetricsPtr RpcServiceImpl::getMetrics() const
+{
+    return metrics;
+}
+
 #endif
@@ -0,0 +1,87 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "boost/python/list.hpp"
+#include "RpcServiceMetrics.h"
+
+const double RpcServiceMetrics::LatencyBucketBounds[] = { 0.0001, 0.001, 0.01, 0.1, 1.0, 10.0 };
+const int RpcServiceMetrics::NLatencyBucketBounds(sizeof(LatencyBucketBounds)/sizeof(double));
+
+RpcServiceMetrics::RpcServiceMetrics() :
+    mutex(),
+    resetTime(epicsTime::getCurrent()),
+    nRequests(0),
+    nErrors(0),
+    nRejected(0),
+    totalLatency(0),
+    maxLatency(0),
+    latencyHistogram(NLatencyBucketBounds+1, 0)
+{
+}
+
+RpcServiceMetrics::~RpcServiceMetrics()
+{
+}
+
+void RpcServiceMetrics::addRequest(double latency, bool succeeded)
+{
+    int bucket = 0;
+    while (bucket < NLatencyBucketBounds && latency > LatencyBucketBounds[bucket]) {
+        bucket++;
+    }
+
+    epics::pvData::Lock lock(mutex);
+    nRequests++;
+    if (!succeeded) {
+        nErrors++;
+    }
+    totalLatency += latency;
+    if (latency > maxLatency) {
+        maxLatency = latency;
+    }
+    latencyHistogram[bucket]++;
+}
+
+void RpcServiceMetrics::addRejectedRequest()
+{
+    epics::pvData::Lock lock(mutex);
+    nRejected++;
+}
+
+void RpcServiceMetrics::reset()
+{
+    epics::pvData::Lock lock(mutex);
+    resetTime = epicsTime::getCurrent();
+    nRequests = 0;
+    nErrors = 0;
+    nRejected = 0;
+    totalLatency = 0;
+    maxLatency = 0;
+    latencyHistogram.assign(NLatencyBucketBounds+1, 0);
+}
+
+boost::python::dict RpcServiceMetrics::toPyDict()
+{
+    epics::pvData::Lock lock(mutex);
+    double elapsedTime = epicsTime::getCurrent() - resetTime;
+    boost::python::dict pyDict;
+    pyDict["requests"] = nRequests;
+    pyDict["errors"] = nErrors;
+    pyDict["rejected"] = nRejected;
+    pyDict["elapsedTime"] = elapsedTime;
+    pyDict["requestRate"] = (elapsedTime > 0 ? nRequests/elapsedTime : 0.0);
+    pyDict["averageLatency"] = (nRequests > 0 ? totalLatency/nRequests : 0.0);
+    pyDict["maxLatency"] = maxLatency;
+
+    boost::python::list pyBounds;
+    boost::python::list pyHistogram;
+    for (int i = 0; i < NLatencyBucketBounds; i++) {
+        pyBounds.append(LatencyBucketBounds[i]);
+    }
+    for (int i = 0; i < int(latencyHistogram.size()); i++) {
+        pyHistogram.append(latencyHistogram[i]);
+    }
+    pyDict["latencyHistogramBounds"] = pyBounds;
+    pyDict["latencyHistogram"] = pyHistogram;
+    return pyDict;
+}
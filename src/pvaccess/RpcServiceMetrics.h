@@ -0,0 +1,52 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef RPC_SERVICE_METRICS_H
+#define RPC_SERVICE_METRICS_H
+
+#include <vector>
+#include "boost/python/dict.hpp"
+#include "pv/pvData.h"
+#include "epicsTime.h"
+
+//
+// Request counters and latency histogram for one RPC service. Latency
+// is measured from the time request is received until response is
+// ready, so that it includes time spent in the pending request queue.
+// Rejected requests are counted separately, and are not included in
+// request count.
+//
+class RpcServiceMetrics
+{
+public:
+    POINTER_DEFINITIONS(RpcServiceMetrics);
+
+    // Upper bounds (in seconds) of latency histogram buckets; histogram
+    // has one more bucket for latencies above the last bound
+    static const double LatencyBucketBounds[];
+    static const int NLatencyBucketBounds;
+
+    RpcServiceMetrics();
+    virtual ~RpcServiceMetrics();
+
+    void addRequest(double latency, bool succeeded);
+    void addRejectedRequest();
+    void reset();
+
+    // Must be called with GIL held
+    boost::python::dict toPyDict();
+
+private:
+    epics::pvData::Mutex mutex;
+    epicsTime resetTime;
+    unsigned long long nRequests;
+    unsigned long long nErrors;
+    unsigned long long nRejected;
+    double totalLatency;
+    double maxLatency;
+    std::vector<unsigned long long> latencyHistogram;
+};
+
+typedef RpcServiceMetrics::shared_pointer RpcServiceMetricsPtr;
+
+#endif
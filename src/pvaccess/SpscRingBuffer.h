@@ -0,0 +1,340 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef SPSC_RING_BUFFER_H
+#define SPSC_RING_BUFFER_H
+
+#include <vector>
+#include "epicsEvent.h"
+#include "epicsVersion.h"
+#include "QueueStatistics.h"
+
+#if EPICS_VERSION > 3 || (EPICS_VERSION == 3 && EPICS_REVISION >= 15)
+#include "epicsAtomic.h"
+#define SPSC_RING_BUFFER_USE_EPICS_ATOMIC
+#endif
+
+//
+// Bounded single-producer/single-consumer queue with preallocated slots.
+//
+// Producer and consumer never take a lock: each side owns one index, and
+// memory barriers order slot access with index updates. Indices and flags
+// are accessed via epicsAtomic (with GCC builtins for EPICS base 3.14,
+// which does not provide it). Items pushed into a full buffer are dropped
+// and counted. Consumer that waits for items announces this via flag, so
+// that producer signals event only when needed.
+//
+// Buffer constructed with capacity less than one has no item slots, and
+// drops all items pushed into it until capacity is set, so that unused
+// buffers cost no memory. Buffer cannot be unlimited; capacity less than
+// one given to setCapacity() (e.g., unlimited monitor queue length)
+// selects default capacity of 1024 items.
+//
+// Popped slots are reset to the empty item given at construction, so that
+// buffer does not hold references to consumed data.
+//
+// Each statistics counter is updated by one side only; received count
+// includes dropped items.
+//
+template <class T>
+class SpscRingBuffer
+{
+public:
+    static const int DefaultCapacity = 1024;
+
+    SpscRingBuffer(int capacity=0, const T& emptyItem=T());
+    virtual ~SpscRingBuffer();
+
+    // Capacity may be changed, and slots released, only while buffer
+    // is not in use.
+    void setCapacity(int capacity);
+    void releaseSlots();
+    int getCapacity() const;
+    int size() const;
+    bool empty() const;
+    unsigned long long getDropCount() const;
+
+    // Counters are read independently of each other, so they may be
+    // slightly inconsistent while buffer is in use.
+    QueueStatistics getStatistics() const;
+
+    // Statistics may be reset only while buffer is not in use.
+    void resetStatistics();
+
+    // Producer side
+    bool push(const T& t);
+
+    // Consumer side
+    bool pop(T& t);
+    int popBatch(std::vector<T>& items, int maxItems);
+    bool waitForItem(double timeout);
+    void cancelWaitForItem();
+    void clear();
+
+private:
+    static void memoryBarrier();
+    static int atomicGet(const int& value);
+    static void atomicSet(int& value, int newValue);
+    int nextIndex(int index) const;
+    void allocateSlots(int capacity);
+
+    T emptyItem;
+    std::vector<T> slots;
+    int nSlots;
+    int head;
+    int tail;
+    int consumerWaiting;
+    int maxSize;
+
+    // Counters are not covered by epicsAtomic, which has no 64-bit
+    // operations; they are only used for statistics
+    volatile unsigned long long receivedCount;
+    volatile unsigned long long deliveredCount;
+    volatile unsigned long long dropCount;
+    epicsEvent event;
+};
+
+template <class T>
+SpscRingBuffer<T>::SpscRingBuffer(int capacity, const T& emptyItem_) :
+    emptyItem(emptyItem_),
+    slots(),
+    nSlots(0),
+    head(0),
+    tail(0),
+    consumerWaiting(0),
+    maxSize(0),
+    receivedCount(0),
+    deliveredCount(0),
+    dropCount(0),
+    event()
+{
+    allocateSlots(capacity > 0 ? capacity : 0);
+}
+
+template <class T>
+SpscRingBuffer<T>::~SpscRingBuffer()
+{
+    event.signal();
+}
+
+// Full barrier: reads and writes are not reordered across it
+template <class T>
+inline void SpscRingBuffer<T>::memoryBarrier()
+{
+#ifdef SPSC_RING_BUFFER_USE_EPICS_ATOMIC
+    epicsAtomicWriteMemoryBarrier();
+    epicsAtomicReadMemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+}
+
+// Load followed by full barrier (acquire): slot reads that depend on the
+// index are not performed before it is read
+template <class T>
+inline int SpscRingBuffer<T>::atomicGet(const int& value)
+{
+#ifdef SPSC_RING_BUFFER_USE_EPICS_ATOMIC
+    int currentValue = epicsAtomicGetIntT(const_cast<int*>(&value));
+#else
+    int currentValue = *static_cast<const volatile int*>(&value);
+#endif
+    memoryBarrier();
+    return currentValue;
+}
+
+// Full barrier followed by store (release): slot writes are completed
+// before the index that publishes them; epicsAtomicSetIntT() alone
+// orders its barrier after the store, which is not sufficient here
+template <class T>
+inline void SpscRingBuffer<T>::atomicSet(int& value, int newValue)
+{
+    memoryBarrier();
+#ifdef SPSC_RING_BUFFER_USE_EPICS_ATOMIC
+    epicsAtomicSetIntT(&value, newValue);
+#else
+    *static_cast<volatile int*>(&value) = newValue;
+#endif
+}
+
+template <class T>
+inline int SpscRingBuffer<T>::nextIndex(int index) const
+{
+    index++;
+    return (index == nSlots ? 0 : index);
+}
+
+// One slot is always kept free to distinguish full buffer from empty, so
+// buffer without item slots holds only that one
+template <class T>
+void SpscRingBuffer<T>::allocateSlots(int capacity)
+{
+    nSlots = capacity + 1;
+    std::vector<T>(nSlots, emptyItem).swap(slots);
+    atomicSet(head, 0);
+    atomicSet(tail, 0);
+    resetStatistics();
+}
+
+template <class T>
+void SpscRingBuffer<T>::setCapacity(int capacity)
+{
+    if (capacity < 1) {
+        capacity = DefaultCapacity;
+    }
+    allocateSlots(capacity);
+}
+
+template <class T>
+void SpscRingBuffer<T>::releaseSlots()
+{
+    allocateSlots(0);
+}
+
+template <class T>
+int SpscRingBuffer<T>::getCapacity() const
+{
+    return nSlots - 1;
+}
+
+template <class T>
+int SpscRingBuffer<T>::size() const
+{
+    int currentHead = atomicGet(head);
+    int currentTail = atomicGet(tail);
+    return (currentTail + nSlots - currentHead) % nSlots;
+}
+
+template <class T>
+bool SpscRingBuffer<T>::empty() const
+{
+    return (atomicGet(head) == atomicGet(tail));
+}
+
+template <class T>
+unsigned long long SpscRingBuffer<T>::getDropCount() const
+{
+    return dropCount;
+}
+
+template <class T>
+QueueStatistics SpscRingBuffer<T>::getStatistics() const
+{
+    QueueStatistics statistics;
+    statistics.nDelivered = deliveredCount;
+    statistics.size = size();
+    statistics.nDropped = dropCount;
+    statistics.nReceived = receivedCount;
+    statistics.maxSize = atomicGet(maxSize);
+    return statistics;
+}
+
+template <class T>
+void SpscRingBuffer<T>::resetStatistics()
+{
+    receivedCount = 0;
+    deliveredCount = 0;
+    dropCount = 0;
+    atomicSet(maxSize, 0);
+}
+
+template <class T>
+bool SpscRingBuffer<T>::push(const T& t)
+{
+    int currentTail = tail;
+    int newTail = nextIndex(currentTail);
+    receivedCount = receivedCount + 1;
+    int currentHead = atomicGet(head);
+    if (newTail == currentHead) {
+        dropCount = dropCount + 1;
+        return false;
+    }
+
+    // Size seen by producer may only be larger than the actual one
+    int currentSize = (newTail + nSlots - currentHead) % nSlots;
+    if (currentSize > maxSize) {
+        atomicSet(maxSize, currentSize);
+    }
+
+    // Slot was released by consumer before head was read, and must be
+    // written before it is published
+    slots[currentTail] = t;
+    atomicSet(tail, newTail);
+
+    // Publishing tail must precede reading consumer flag
+    memoryBarrier();
+    if (atomicGet(consumerWaiting)) {
+        event.signal();
+    }
+    return true;
+}
+
+template <class T>
+bool SpscRingBuffer<T>::pop(T& t)
+{
+    int currentHead = head;
+    if (currentHead == atomicGet(tail)) {
+        return false;
+    }
+    t = slots[currentHead];
+    slots[currentHead] = emptyItem;
+    atomicSet(head, nextIndex(currentHead));
+    deliveredCount = deliveredCount + 1;
+    return true;
+}
+
+template <class T>
+int SpscRingBuffer<T>::popBatch(std::vector<T>& items, int maxItems)
+{
+    int currentHead = head;
+    int currentTail = atomicGet(tail);
+    int nItems = 0;
+    while (currentHead != currentTail && nItems < maxItems) {
+        items.push_back(slots[currentHead]);
+        slots[currentHead] = emptyItem;
+        currentHead = nextIndex(currentHead);
+        nItems++;
+    }
+
+    // All consumed slots are released with a single index update
+    atomicSet(head, currentHead);
+    deliveredCount = deliveredCount + nItems;
+    return nItems;
+}
+
+template <class T>
+bool SpscRingBuffer<T>::waitForItem(double timeout)
+{
+    atomicSet(consumerWaiting, 1);
+
+    // Setting flag must precede reading tail
+    memoryBarrier();
+    if (!empty()) {
+        atomicSet(consumerWaiting, 0);
+        return true;
+    }
+    event.wait(timeout);
+    atomicSet(consumerWaiting, 0);
+    return !empty();
+}
+
+template <class T>
+void SpscRingBuffer<T>::cancelWaitForItem()
+{
+    event.signal();
+}
+
+template <class T>
+void SpscRingBuffer<T>::clear()
+{
+    // Discarded items are counted as dropped, so producer must be idle
+    T t(emptyItem);
+    unsigned long long nItems = 0;
+    while (pop(t)) {
+        nItems++;
+    }
+    deliveredCount = deliveredCount - nItems;
+    dropCount = dropCount + nItems;
+}
+
+#endif
@@ -0,0 +1,206 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#include "boost/python/extract.hpp"
+#include "boost/python/list.hpp"
+#include "boost/python/tuple.hpp"
+#include "StructureCache.h"
+#include "StringUtility.h"
+#include "PyPvDataUtility.h"
+
+const int StructureCache::DefaultMaxSize(1024);
+
+PvaPyLogger StructureCache::logger("StructureCache");
+epics::pvData::Mutex StructureCache::mutex;
+StructureCache::StructureMap StructureCache::structureMap;
+int StructureCache::maxSize(DefaultMaxSize);
+
+void StructureCache::setMaxSize(int maxSize)
+{
+    if (maxSize < 0) {
+        maxSize = DefaultMaxSize;
+    }
+    epics::pvData::Lock lock(mutex);
+    StructureCache::maxSize = maxSize;
+    if (int(structureMap.size()) > maxSize) {
+        structureMap.clear();
+    }
+}
+
+int StructureCache::getMaxSize()
+{
+    epics::pvData::Lock lock(mutex);
+    return maxSize;
+}
+
+int StructureCache::size()
+{
+    epics::pvData::Lock lock(mutex);
+    return structureMap.size();
+}
+
+void StructureCache::clear()
+{
+    epics::pvData::Lock lock(mutex);
+    structureMap.clear();
+}
+
+epics::pvData::StructureConstPtr StructureCache::getStructure(const std::string& key)
+{
+    epics::pvData::Lock lock(mutex);
+    StructureMap::const_iterator iter = structureMap.find(key);
+    if (iter == structureMap.end()) {
+        return epics::pvData::StructureConstPtr();
+    }
+    return iter->second;
+}
+
+void StructureCache::addStructure(const std::string& key, const epics::pvData::StructureConstPtr& structurePtr)
+{
+    epics::pvData::Lock lock(mutex);
+    if (maxSize <= 0) {
+        return;
+    }
+    if (int(structureMap.size()) >= maxSize) {
+        logger.debug("Structure cache is full, clearing %d structures", int(structureMap.size()));
+        structureMap.clear();
+    }
+    structureMap[key] = structurePtr;
+}
+
+epics::pvData::StructureConstPtr StructureCache::getStructureFromDict(const boost::python::dict& pyDict, const std::string& structureId)
+{
+    std::string key = StringUtility::trim(structureId) + "|";
+    if (!appendDictKey(pyDict, key)) {
+        return PyPvDataUtility::createStructureFromDict(pyDict, structureId);
+    }
+
+    epics::pvData::StructureConstPtr structurePtr = getStructure(key);
+    if (!structurePtr) {
+        structurePtr = PyPvDataUtility::createStructureFromDict(pyDict, structureId);
+        addStructure(key, structurePtr);
+    }
+    return structurePtr;
+}
+
+//
+// Canonical key methods mirror structure creation from dictionary, and
+// return false for anything they cannot describe.
+//
+bool StructureCache::appendDictKey(const boost::python::dict& pyDict, std::string& key)
+{
+    boost::python::list fieldNames = pyDict.keys();
+    int nFields = boost::python::len(fieldNames);
+    key += "{";
+    for (int i = 0; i < nFields; i++) {
+        boost::python::object fieldNameObject = fieldNames[i];
+        boost::python::extract<std::string> fieldNameExtract(fieldNameObject);
+        if (!fieldNameExtract.check()) {
+            return false;
+        }
+
+        // Names are length-prefixed, so that they need no escaping
+        std::string fieldName = fieldNameExtract();
+        key += StringUtility::toString(fieldName.size()) + ":" + fieldName;
+        if (!appendFieldKey(pyDict[fieldNameObject], key)) {
+            return false;
+        }
+    }
+    key += "}";
+    return true;
+}
+
+bool StructureCache::appendFieldKey(const boost::python::object& pyObject, std::string& key)
+{
+    boost::python::extract<int> scalarExtract(pyObject);
+    if (scalarExtract.check()) {
+        key += "s" + StringUtility::toString(scalarExtract()) + ";";
+        return true;
+    }
+
+    boost::python::extract<boost::python::list> listExtract(pyObject);
+    if (listExtract.check()) {
+        boost::python::list pyList = listExtract();
+        if (boost::python::len(pyList) != 1) {
+            return false;
+        }
+        key += "[";
+        if (!appendListElementKey(pyList[0], key)) {
+            return false;
+        }
+        key += "]";
+        return true;
+    }
+
+    if (appendTupleKey(pyObject, key)) {
+        return true;
+    }
+
+    boost::python::extract<boost::python::dict> dictExtract(pyObject);
+    if (dictExtract.check()) {
+        boost::python::dict pyDict = dictExtract();
+        if (!boost::python::len(pyDict)) {
+            return false;
+        }
+        return appendDictKey(pyDict, key);
+    }
+    return false;
+}
+
+bool StructureCache::appendListElementKey(const boost::python::object& pyObject, std::string& key)
+{
+    boost::python::extract<int> scalarExtract(pyObject);
+    if (scalarExtract.check()) {
+        key += "s" + StringUtility::toString(scalarExtract()) + ";";
+        return true;
+    }
+
+    if (appendTupleKey(pyObject, key)) {
+        return true;
+    }
+
+    boost::python::extract<boost::python::dict> dictExtract(pyObject);
+    if (dictExtract.check()) {
+        boost::python::dict pyDict = dictExtract();
+        if (!boost::python::len(pyDict)) {
+            return false;
+        }
+        return appendDictKey(pyDict, key);
+    }
+    return false;
+}
+
+bool StructureCache::appendTupleKey(const boost::python::object& pyObject, std::string& key)
+{
+    boost::python::extract<boost::python::tuple> tupleExtract(pyObject);
+    if (!tupleExtract.check()) {
+        return false;
+    }
+
+    // Both empty tuple and tuple holding empty dictionary describe
+    // variant union
+    boost::python::tuple pyTuple = tupleExtract();
+    int tupleSize = boost::python::len(pyTuple);
+    if (tupleSize == 0) {
+        key += "()";
+        return true;
+    }
+    if (tupleSize != 1) {
+        return false;
+    }
+    boost::python::extract<boost::python::dict> dictExtract(pyTuple[0]);
+    if (!dictExtract.check()) {
+        return false;
+    }
+    boost::python::dict pyDict = dictExtract();
+    if (!boost::python::len(pyDict)) {
+        key += "()";
+        return true;
+    }
+    key += "(";
+    if (!appendDictKey(pyDict, key)) {
+        return false;
+    }
+    key += ")";
+    return true;
+}
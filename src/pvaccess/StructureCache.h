@@ -0,0 +1,55 @@
+// Copyright information and license terms for this software can be
+// found in the file LICENSE that is included with the distribution
+
+#ifndef STRUCTURE_CACHE_H
+#define STRUCTURE_CACHE_H
+
+#include <map>
+#include <string>
+#include "pv/pvData.h"
+#include "boost/python/dict.hpp"
+#include "PvaPyLogger.h"
+
+//
+// Process-wide cache of introspection interfaces created from python
+// structure dictionaries.
+//
+// Structures are keyed by canonical form of the structure dictionary
+// and structure id, which is built by walking the dictionary the same
+// way as when creating structure, but without creating pvData fields.
+// Dictionaries that cannot be described this way (e.g., those that refer
+// to PV objects, or that are invalid) bypass the cache. Types with a
+// fixed parametrized layout (e.g., NT types) may also use their own keys.
+//
+class StructureCache
+{
+public:
+    static const int DefaultMaxSize;
+
+    // When cache is full it is cleared; zero size disables caching
+    static void setMaxSize(int maxSize);
+    static int getMaxSize();
+    static int size();
+    static void clear();
+
+    static epics::pvData::StructureConstPtr getStructure(const std::string& key);
+    static void addStructure(const std::string& key, const epics::pvData::StructureConstPtr& structurePtr);
+
+    // Python GIL must be held
+    static epics::pvData::StructureConstPtr getStructureFromDict(const boost::python::dict& pyDict, const std::string& structureId);
+
+private:
+    typedef std::map<std::string, epics::pvData::StructureConstPtr> StructureMap;
+
+    static bool appendDictKey(const boost::python::dict& pyDict, std::string& key);
+    static bool appendFieldKey(const boost::python::object& pyObject, std::string& key);
+    static bool appendListElementKey(const boost::python::object& pyObject, std::string& key);
+    static bool appendTupleKey(const boost::python::object& pyObject, std::string& key);
+
+    static PvaPyLogger logger;
+    static epics::pvData::Mutex mutex;
+    static StructureMap structureMap;
+    static int maxSize;
+};
+
+#endif
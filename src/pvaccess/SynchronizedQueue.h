@@ -5,9 +5,21 @@
 #define SYNCHRONIZED_QUEUE_H
 
 #include <queue>
+#include <vector>
 #include "epicsEvent.h"
 #include "pv/pvData.h"
 #include "InvalidState.h"
+#include "QueueOverflowPolicy.h"
+#include "QueueStatistics.h"
+
+// Queue with coalescing overflow policy replaces its newest item using
+// this function, which may be overloaded for types that need to merge
+// state of the replaced item into the new one.
+template <class T>
+inline void coalesceQueueItem(T& queuedItem, const T& item)
+{
+    queuedItem = item;
+}
 
 template <class T>
 class SynchronizedQueue : public std::queue<T>
@@ -18,16 +30,32 @@ public:
     virtual ~SynchronizedQueue();
     void setMaxLength(int maxLength);
     int getMaxLength();
+    void setOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy);
+    QueueOverflowPolicy::PolicyType getOverflowPolicy() const;
     T back() throw(InvalidState);
     T front() throw(InvalidState);
     T frontAndPop() throw(InvalidState);
     T frontAndPop(double timeout) throw(InvalidState);
+    void frontAndPopAll(std::vector<T>& items);
+    int frontAndPopBatch(std::vector<T>& items, int maxItems);
     void pop();
     void push(const T& t);
+    void waitForItem();
     void waitForItem(double timeout);
     void cancelWaitForItem();
+
+    // Queue never blocks producer. With blocking overflow policy, producer
+    // checks for space before it takes the next item from its source, and
+    // stops if queue is full; consumer resumes producer when
+    // resumeProducer() reports that room was made for it.
+    bool checkProducerSpace();
+    bool resumeProducer();
     void clear();
 
+    // Items discarded by clear() are counted as dropped
+    QueueStatistics getStatistics();
+    void resetStatistics();
+
 private:
     void throwInvalidStateIfEmpty() throw(InvalidState);
     T frontAndPopUnsynchronized();
@@ -35,6 +63,9 @@ private:
     epics::pvData::Mutex mutex;
     epicsEvent event;
     int maxLength;
+    QueueOverflowPolicy::PolicyType overflowPolicy;
+    bool producerStopped;
+    QueueStatistics statistics;
 };
 
 template <class T>
@@ -42,7 +73,10 @@ SynchronizedQueue<T>::SynchronizedQueue() :
     std::queue<T>(),
     mutex(),
     event(),
-    maxLength(Unlimited)
+    maxLength(Unlimited),
+    overflowPolicy(QueueOverflowPolicy::DropOldest),
+    producerStopped(false),
+    statistics()
 {
 }
 
@@ -65,6 +99,19 @@ void SynchronizedQueue<T>::setMaxLength(int maxLength)
     this->maxLength = maxLength; 
 }
 
+template <class T>
+void SynchronizedQueue<T>::setOverflowPolicy(QueueOverflowPolicy::PolicyType overflowPolicy)
+{
+    epics::pvData::Lock lock(mutex);
+    this->overflowPolicy = overflowPolicy;
+}
+
+template <class T>
+QueueOverflowPolicy::PolicyType SynchronizedQueue<T>::getOverflowPolicy() const
+{
+    return overflowPolicy;
+}
+
 template <class T>
 void SynchronizedQueue<T>::throwInvalidStateIfEmpty() throw(InvalidState)
 {
@@ -94,6 +141,7 @@ T SynchronizedQueue<T>::frontAndPopUnsynchronized()
 {
     T t = std::queue<T>::front();
     std::queue<T>::pop();
+    statistics.nDelivered++;
     return t;
 }
 
@@ -118,12 +166,33 @@ T SynchronizedQueue<T>::frontAndPop(double timeout) throw(InvalidState)
     return frontAndPop();
 }
 
+template <class T>
+void SynchronizedQueue<T>::frontAndPopAll(std::vector<T>& items)
+{
+    epics::pvData::Lock lock(mutex);
+    while (!std::queue<T>::empty()) {
+        items.push_back(frontAndPopUnsynchronized());
+    }
+}
+
+template <class T>
+int SynchronizedQueue<T>::frontAndPopBatch(std::vector<T>& items, int maxItems)
+{
+    epics::pvData::Lock lock(mutex);
+    int nItems = 0;
+    while (!std::queue<T>::empty() && nItems < maxItems) {
+        items.push_back(frontAndPopUnsynchronized());
+        nItems++;
+    }
+    return nItems;
+}
+
 template <class T>
 void SynchronizedQueue<T>::pop()
 {
     epics::pvData::Lock lock(mutex);
     if (!std::queue<T>::empty()) {
-        std::queue<T>::pop();
+        frontAndPopUnsynchronized();
     }
 }
 
@@ -131,16 +200,52 @@ template <class T>
 void SynchronizedQueue<T>::push(const T& t)
 {
     epics::pvData::Lock lock(mutex);
-    if (maxLength > 0) {
-        int nPop = std::queue<T>::size()-maxLength+1;
-        for (int i = 0; i < nPop; i++) {
-            std::queue<T>::pop();
+    statistics.nReceived++;
+
+    // Producer that checks for space is never ahead of the blocking
+    // policy, so item is only queued beyond maximum length if that was
+    // reduced after producer checked
+    if (maxLength > 0 && int(std::queue<T>::size()) >= maxLength && overflowPolicy != QueueOverflowPolicy::BlockProducer) {
+        switch (overflowPolicy) {
+            case QueueOverflowPolicy::DropNewest: {
+                statistics.nDropped++;
+                return;
+            }
+            case QueueOverflowPolicy::CoalesceToLatest: {
+                if (!std::queue<T>::empty()) {
+                    coalesceQueueItem(std::queue<T>::back(), t);
+                    statistics.nDropped++;
+                    event.signal();
+                    return;
+                }
+                break;
+            }
+            default: {
+                // Queue may also be longer than maximum length if that
+                // was reduced after items were queued
+                int nPop = std::queue<T>::size()-maxLength+1;
+                for (int i = 0; i < nPop; i++) {
+                    std::queue<T>::pop();
+                    statistics.nDropped++;
+                }
+                break;
+            }
         }
     }
     std::queue<T>::push(t);
+    int size = std::queue<T>::size();
+    if (size > statistics.maxSize) {
+        statistics.maxSize = size;
+    }
     event.signal();
 }
 
+template <class T>
+void SynchronizedQueue<T>::waitForItem() 
+{
+    event.wait();
+}
+
 template <class T>
 void SynchronizedQueue<T>::waitForItem(double timeout) 
 {
@@ -153,14 +258,59 @@ void SynchronizedQueue<T>::cancelWaitForItem()
     event.signal();
 }
 
+template <class T>
+bool SynchronizedQueue<T>::checkProducerSpace() 
+{
+    epics::pvData::Lock lock(mutex);
+    if (overflowPolicy == QueueOverflowPolicy::BlockProducer && maxLength > 0 && int(std::queue<T>::size()) >= maxLength) {
+        producerStopped = true;
+        return false;
+    }
+    return true;
+}
+
+template <class T>
+bool SynchronizedQueue<T>::resumeProducer() 
+{
+    epics::pvData::Lock lock(mutex);
+    if (!producerStopped) {
+        return false;
+    }
+    if (overflowPolicy == QueueOverflowPolicy::BlockProducer && maxLength > 0 && int(std::queue<T>::size()) >= maxLength) {
+        return false;
+    }
+    producerStopped = false;
+    return true;
+}
+
 template <class T>
 void SynchronizedQueue<T>::clear() 
 {
     epics::pvData::Lock lock(mutex);
     while (!std::queue<T>::empty()) {
         std::queue<T>::pop();
+        statistics.nDropped++;
     }
+    producerStopped = false;
     event.signal();
 }
 
+template <class T>
+QueueStatistics SynchronizedQueue<T>::getStatistics() 
+{
+    epics::pvData::Lock lock(mutex);
+    QueueStatistics queueStatistics = statistics;
+    queueStatistics.size = std::queue<T>::size();
+    return queueStatistics;
+}
+
+template <class T>
+void SynchronizedQueue<T>::resetStatistics() 
+{
+    epics::pvData::Lock lock(mutex);
+    statistics = QueueStatistics();
+    statistics.nReceived = std::queue<T>::size();
+    statistics.maxSize = std::queue<T>::size();
+}
+
 #endif
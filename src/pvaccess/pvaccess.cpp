@@ -25,6 +25,7 @@
 
 #include "PvObject.h"
 #include "PvProvider.h"
+#include "QueueOverflowPolicy.h"
 #include "PvScalar.h"
 #include "PvType.h"
 #include "PvBoolean.h"
@@ -47,10 +48,14 @@
 #include "NtType.h"
 #include "NtTable.h"
 
+#include "NumpyUtility.h"
+
 #include "Channel.h"
+#include "ChannelGroup.h"
 #include "RpcClient.h"
 #include "RpcServer.h"
 #include "RpcServiceImpl.h"
+#include "PvaServer.h"
 #include "PvaException.h"
 #include "PvaExceptionTranslator.h"
 
@@ -59,7 +64,12 @@ BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(ChannelGet, Channel::get, 0, 1)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(ChannelPut, Channel::put, 1, 2)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(ChannelStartMonitor, Channel::startMonitor, 0, 1)
 //BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcClientRequest, RpcClient::request, 1, 2)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcClientInvokeAsync, RpcClient::invokeAsync, 2, 4)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcServerListen, RpcServer::listen, 0, 1)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcServerRegisterService, RpcServer::registerService, 2, 3)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcServerStopListener, RpcServer::stopListener, 0, 1)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcServerStop, RpcServer::stop, 0, 1)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(RpcServerShutdown, RpcServer::shutdown, 0, 1)
 
 PyObject* pvaException = NULL;
 PyObject* fieldNotFoundException = NULL;
@@ -73,6 +83,9 @@ BOOST_PYTHON_MODULE(pvaccess)
     scope().attr("__doc__") = "pvaccess module is a python wrapper for pvAccess and other `EPICS V4 <http://epics-pvdata.sourceforge.net>`_ C++ libraries."; 
     docstring_options local_docstring_options(true, true, false);
 
+    // Load NumPy C API, if available
+    NumpyUtility::initialize();
+
     //
     // Exceptions
     //
@@ -112,6 +125,17 @@ BOOST_PYTHON_MODULE(pvaccess)
         .export_values()
         ;
 
+    //
+    // QueueOverflowPolicy
+    //
+    enum_<QueueOverflowPolicy::PolicyType>("QueueOverflowPolicy")
+        .value("DROP_OLDEST", QueueOverflowPolicy::DropOldest)
+        .value("DROP_NEWEST", QueueOverflowPolicy::DropNewest)
+        .value("COALESCE_TO_LATEST", QueueOverflowPolicy::CoalesceToLatest)
+        .value("BLOCK_PRODUCER", QueueOverflowPolicy::BlockProducer)
+        .export_values()
+        ;
+
     //
     // PvObject
     //
@@ -709,21 +733,21 @@ BOOST_PYTHON_MODULE(pvaccess)
             "    value = pv.getString('aString')\n\n")
 
         .def("setScalarArray", 
-            static_cast<void(PvObject::*)(const boost::python::list&)>(&PvObject::setScalarArray),
+            static_cast<void(PvObject::*)(const boost::python::object&)>(&PvObject::setScalarArray),
             args("valueList"),
-            "Sets scalar array value for a single-field structure, or for a structure that has scalar array field named 'value'.\n\n"
-            ":Parameter: *valueList* (list) - list of scalar values\n\n"
+            "Sets scalar array value for a single-field structure, or for a structure that has scalar array field named 'value'. Objects supporting python buffer protocol (e.g., NumPy arrays) are copied in bulk, with conversion to the field data type if needed.\n\n"
+            ":Parameter: *valueList* (list) - list of scalar values, or object supporting buffer protocol\n\n"
             ":Raises: *InvalidRequest* - when single-field structure has no scalar array field or multiple-field structure has no scalar array 'value' field\n\n"
             "::\n\n"
             "    pv = PvObject({'aScalarArray' : [INT]})\n\n"
             "    pv.setScalarArray([0,1,2,3,4])\n\n")
 
         .def("setScalarArray", 
-            static_cast<void(PvObject::*)(const std::string&,const boost::python::list&)>(&PvObject::setScalarArray),
+            static_cast<void(PvObject::*)(const std::string&,const boost::python::object&)>(&PvObject::setScalarArray),
             args("fieldName", "valueList"),
-            "Sets scalar array value for the given PV field.\n\n"
+            "Sets scalar array value for the given PV field. Objects supporting python buffer protocol (e.g., NumPy arrays) are copied in bulk, with conversion to the field data type if needed.\n\n"
             ":Parameter: *fieldName* (str) - field name\n\n"
-            ":Parameter: *valueList* (list) - list of scalar values\n\n"
+            ":Parameter: *valueList* (list) - list of scalar values, or object supporting buffer protocol\n\n"
             ":Raises: *FieldNotFound* - when PV structure does not have specified field\n\n"
             ":Raises: *InvalidRequest* - when specified field is not a scalar array\n\n"
             "::\n\n"
@@ -752,6 +776,29 @@ BOOST_PYTHON_MODULE(pvaccess)
             "    pv = PvObject({'aScalarArray' : [INT]})\n\n"
             "    valueList = pv.getScalarArray('aScalarArray', 'aString' : STRING)\n\n")
 
+        .def("getScalarArrayAsNumpy", 
+            static_cast<boost::python::object(PvObject::*)()const>(&PvObject::getScalarArrayAsNumpy), 
+            "Retrieves scalar array value from a single-field structure, or from a structure that has scalar array field named 'value', as a read-only NumPy array. Array data is not copied: NumPy array is a view of the PV array data, which remains valid for as long as the NumPy array exists.\n\n"
+            ":Returns: NumPy array of scalar values\n\n"
+            ":Raises: *InvalidRequest* - when single-field structure has no scalar array field or multiple-field structure has no scalar array 'value' field, or when NumPy support is not available\n\n"
+            ":Raises: *InvalidDataType* - when array contains strings\n\n"
+            "::\n\n"
+            "    pv = PvObject({'aScalarArray' : [INT]})\n\n"
+            "    valueArray = pv.getScalarArrayAsNumpy()\n\n")
+
+        .def("getScalarArrayAsNumpy", 
+            static_cast<boost::python::object(PvObject::*)(const std::string&)const>(&PvObject::getScalarArrayAsNumpy), 
+            args("fieldName"), 
+            "Retrieves scalar array value assigned to the given PV field as a read-only NumPy array. Array data is not copied: NumPy array is a view of the PV array data, which remains valid for as long as the NumPy array exists.\n\n"
+            ":Parameter: *fieldName* (str) - field name\n\n"
+            ":Returns: NumPy array of scalar values\n\n"
+            ":Raises: *FieldNotFound* - when PV structure does not have specified field\n\n"
+            ":Raises: *InvalidRequest* - when specified field is not a scalar array, or when NumPy support is not available\n\n"
+            ":Raises: *InvalidDataType* - when array contains strings\n\n"
+            "::\n\n"
+            "    pv = PvObject({'aScalarArray' : [INT], 'aString' : STRING})\n\n"
+            "    valueArray = pv.getScalarArrayAsNumpy('aScalarArray')\n\n")
+
         .def("setStructure", 
             static_cast<void(PvObject::*)(const boost::python::dict&)>(&PvObject::setStructure),
             args("valueDict"),
@@ -1153,12 +1200,35 @@ BOOST_PYTHON_MODULE(pvaccess)
             "    unionPv = pv.createUnionArrayElementField('anInt')\n\n")
 
         .def("toDict", 
-            &PvObject::toDict,
+            static_cast<boost::python::dict(PvObject::*)()const>(&PvObject::toDict),
             "Converts PV structure to python dictionary.\n\n:Returns: python key:value dictionary representing current PV structure in terms of field names and their values\n\n::\n\n    valueDict = pv.toDict()\n\n")
 
+        .def("toDict", 
+            static_cast<boost::python::dict(PvObject::*)(bool)const>(&PvObject::toDict),
+            args("changedOnly"),
+            "Converts PV structure to python dictionary, optionally including only fields that changed in the monitor update this object was received with. Unchanged fields are not visited, which reduces conversion cost for large structures with few changing fields. Objects without change information are converted entirely.\n\n:Parameter: *changedOnly* (bool) - if True, only changed fields are converted\n\n:Returns: python key:value dictionary representing PV structure fields and their values\n\n::\n\n    def echo(pv):\n\n        print pv.toDict(changedOnly=True)\n\n")
+
+        .def("getChangedFields", 
+            &PvObject::getChangedFields,
+            "Retrieves names of fields that changed in the monitor update this object was received with. Names of nested fields are given relative to the top level structure (e.g., 'timeStamp.secondsPastEpoch'); if all fields of a structure changed, only structure name is listed. For objects without change information (e.g., objects that were not received via channel monitor) all top level field names are returned.\n\n:Returns: list of changed field names\n\n::\n\n    def echo(pv):\n\n        print pv.getChangedFields()\n\n")
+
+        .def("getOverrunFields", 
+            &PvObject::getOverrunFields,
+            "Retrieves names of fields that changed more than once between the monitor updates, so that some of their values were not delivered.\n\n:Returns: list of overrun field names\n\n::\n\n    def echo(pv):\n\n        print pv.getOverrunFields()\n\n")
+
         .def("getStructureDict", 
             &PvObject::getStructureDict,
             "Retrieves PV structure definition as python dictionary.\n\n:Returns: python key:value dictionary representing PV structure definition in terms of field names and their types\n\n::\n\n    structureDict = pv.getStructureDict()\n\n")
+
+        .def("clone", 
+            &PvObject::clone,
+            "Creates copy of this PV object. Copy has the same structure and field values, but it is independent of the original object; its structure does not have to be created or parsed again.\n\n:Returns: new PV object\n\n::\n\n    pv2 = pv.clone()\n\n")
+
+        .def("fromTemplate", 
+            &PvObject::fromTemplate,
+            args("templatePv"),
+            "Creates new PV object with the same structure as the template object and default field values. This is much faster than creating object from structure dictionary, and is recommended when objects of the same type are created repeatedly (e.g., for RPC service responses).\n\n:Parameter: *templatePv* (PvObject) - template PV object\n\n:Returns: new PV object\n\n::\n\n    responseTemplate = PvObject({'nRows' : INT, 'values' : [DOUBLE]})\n\n    response = PvObject.fromTemplate(responseTemplate)\n\n")
+        .staticmethod("fromTemplate")
         ;
 
     //
@@ -1286,8 +1356,9 @@ BOOST_PYTHON_MODULE(pvaccess)
     //
     class_<PvScalarArray, bases<PvObject> >("PvScalarArray", "PvScalarArray represents PV scalar array.\n\n**PvScalarArray(scalarType)**\n\n\t:Parameter: *scalarType* (PVTYPE) - scalar type of array elements\n\n\t- PVTYPE: scalar type, can be BOOLEAN, BYTE, UBYTE, SHORT, USHORT, INT, UINT, LONG, ULONG, FLOAT, DOUBLE, or STRING\n\n\t::\n\n\t\tpv = PvScalarArray(INT)\n\n", init<PvType::ScalarType>())
         .def("get", &PvScalarArray::get, "Retrieves PV value list.\n\n:Returns: list of scalar values\n\n::\n\n    valueList = pv.get()\n\n")
-        .def("set", &PvScalarArray::set, args("valueList"), "Sets PV value list.\n\n:Parameter: *valueList* (list) - list of scalar values\n\n::\n\n    pv.set([1,2,3,4,5])\n\n")
+        .def("set", &PvScalarArray::set, args("valueList"), "Sets PV value list.\n\n:Parameter: *valueList* (list) - list of scalar values, or object supporting python buffer protocol (e.g., NumPy array), which is copied in bulk\n\n::\n\n    pv.set([1,2,3,4,5])\n\n")
         .def("toList", &PvScalarArray::toList, "Converts PV to value list.\n\n:Returns: list of scalar values\n\n::\n\n    valueList = pv.toList()\n\n")
+        .def("toNumpy", &PvScalarArray::toNumpy, "Converts PV to read-only NumPy array without copying array data.\n\n:Returns: NumPy array of scalar values\n\n:Raises: *InvalidRequest* - when NumPy support is not available\n\n:Raises: *InvalidDataType* - when array contains strings\n\n::\n\n    valueArray = pv.toNumpy()\n\n")
         ;
 
     //
@@ -1338,14 +1409,18 @@ BOOST_PYTHON_MODULE(pvaccess)
     //
     // NT Table 
     //
-    class_<NtTable, bases<NtType> >("NtTable", "NtTable represents NT table structure.\n\n**NtTable(nColumns, scalarType)**\n\n\t:Parameter: *nColumns* (int) - number of table columns\n\n\t:Parameter: *scalarType* (PVTYPE) - scalar type (BOOLEAN, BYTE, UBYTE, SHORT, USHORT, INT, UINT, LONG, ULONG, FLOAT, DOUBLE, or STRING)\n\n\tThis example creates NT Table with 3 columns of DOUBLE values:\n\n\t::\n\n\t\ttable1 = NtTable(3, DOUBLE)\n\n\t**NtTable(scalarTypeList)**\n\n\t:Parameter: *scalarTypeList* ([PVTYPE]) - list of column scalar types (BOOLEAN, BYTE, UBYTE, SHORT, USHORT, INT, UINT, LONG, ULONG, FLOAT, DOUBLE, or STRING)\n\n\tThis example creates NT Table with STRING, INT and DOUBLE columns:\n\n\t::\n\n\t\ttable2 = NtTable([STRING, INT, DOUBLE])\n\n**NtTable(pvObject)**\n\n\t:Parameter: *pvObject* (PvObject) - PV object that has a structure containing required NT Table elements:\n\n\t- labels ([STRING]) - list of column labels\n\n\t- value (dict) - dictionary of column<index>:[PVTYPE] pairs, where <index> is an integer in range [0,N-1], with N being NT Table dimension\n\n\tThe following example creates NT Table with 3 DOUBLE columns:\n\n\t::\n\n\t\tpvObject = PvObject({'labels' : [STRING], 'value' : {'column0' : [DOUBLE], 'column1' : [DOUBLE], 'column2' : [DOUBLE]}})\n\n\t\tpvObject.setScalarArray('labels', ['x', 'y', 'z'])\n\n\t\tpvObject.setStructure('value', {'column0' : [0.1, 0.2, 0.3], 'column1' : [1.1, 1.2, 1.3], 'column2' : [2.1, 2.2, 2.3]})\n\n\t\ttable3 = NtTable(pvObject)", init<int, PvType::ScalarType>())
+    class_<NtTable, bases<NtType> >("NtTable", "NtTable represents NT table structure.\n\n**NtTable(nColumns, scalarType)**\n\n\t:Parameter: *nColumns* (int) - number of table columns\n\n\t:Parameter: *scalarType* (PVTYPE) - scalar type (BOOLEAN, BYTE, UBYTE, SHORT, USHORT, INT, UINT, LONG, ULONG, FLOAT, DOUBLE, or STRING)\n\n\tThis example creates NT Table with 3 columns of DOUBLE values:\n\n\t::\n\n\t\ttable1 = NtTable(3, DOUBLE)\n\n\t**NtTable(scalarTypeList)**\n\n\t:Parameter: *scalarTypeList* ([PVTYPE]) - list of column scalar types (BOOLEAN, BYTE, UBYTE, SHORT, USHORT, INT, UINT, LONG, ULONG, FLOAT, DOUBLE, or STRING)\n\n\tThis example creates NT Table with STRING, INT and DOUBLE columns:\n\n\t::\n\n\t\ttable2 = NtTable([STRING, INT, DOUBLE])\n\n**NtTable(pvObject)**\n\n\t:Parameter: *pvObject* (PvObject) - PV object that has a structure containing required NT Table elements:\n\n\t- labels ([STRING]) - list of column labels\n\n\t- value (dict) - dictionary of column<index>:[PVTYPE] pairs, where <index> is an integer in range [0,N-1], with N being NT Table dimension\n\n\tThe following example creates NT Table with 3 DOUBLE columns:\n\n\t::\n\n\t\tpvObject = PvObject({'labels' : [STRING], 'value' : {'column0' : [DOUBLE], 'column1' : [DOUBLE], 'column2' : [DOUBLE]}})\n\n\t\tpvObject.setScalarArray('labels', ['x', 'y', 'z'])\n\n\t\tpvObject.setStructure('value', {'column0' : [0.1, 0.2, 0.3], 'column1' : [1.1, 1.2, 1.3], 'column2' : [2.1, 2.2, 2.3]})\n\n\t\ttable3 = NtTable(pvObject)\n\n**NtTable(columns)**\n\n\t:Parameter: *columns* (object) - dictionary of column arrays (e.g., NumPy arrays) or lists keyed by column label, or NumPy record array whose named fields are table columns\n\n\tColumn types are determined by array data types; for lists, they are determined by the type of the first list element (bool, int, float or str). Array data is copied in bulk. Dictionary columns follow its iteration order, which is insertion order for Python 3.7 and later dictionaries, and is arbitrary for older versions (use collections.OrderedDict to control column order).\n\n\tThe following example creates NT Table with 100000 rows of random INT and DOUBLE values:\n\n\t::\n\n\t\ttable4 = NtTable(collections.OrderedDict([('id', numpy.arange(100000, dtype=numpy.int32)), ('x', numpy.random.uniform(0, 1, 100000))]))", init<int, PvType::ScalarType>())
+        // Generic column constructor must be tried after other single
+        // argument constructors, which are tried in reverse order
+        .def(init<const boost::python::object&>())
         .def(init<const boost::python::list&>())
         .def(init<const PvObject&>())
         .def("getNColumns", &NtTable::getNColumns, "Retrieves number of columns.\n\n:Returns: number of table columns\n\n::\n\n    nColumns = table.getNColumns()\n\n")
         .def("getLabels", &NtTable::getLabels, "Retrieves list of column labels.\n\n:Returns: list of column labels\n\n::\n\n    labelList = table.getLabels()\n\n")
         .def("setLabels", &NtTable::setLabels, args("labelList"), "Sets column labels.\n\n:Parameter: *labelList* ([str]) - list of strings containing column labels (the list length must match number of table columns)\n\n::\n\n    table.setLabels(['String', 'Int', 'Double'])\n\n")
         .def("getColumn", &NtTable::getColumn, args("index"), "Retrieves specified column.\n\n:Parameter: *index* (int) - column index (must be in range [0,N-1], where N is the number of table columns)\n\n:Returns: list of values stored in the specified table column\n\n::\n\n    valueList = table.getColumn(0)\n\n")
-        .def("setColumn", &NtTable::setColumn, args("index", "valueList"), "Sets column values.\n\n:Parameter: *index* (int) - column index\n\n:Parameter: *valueList* (list) - list of column values\n\n::\n\n    table.setColumn(0, ['x', 'y', 'z'])\n\n")
+        .def("getColumnAsNumpy", &NtTable::getColumnAsNumpy, args("index"), "Retrieves specified column as read-only NumPy array of the column data type, without copying column data.\n\n:Parameter: *index* (int) - column index (must be in range [0,N-1], where N is the number of table columns)\n\n:Returns: NumPy array of values stored in the specified table column\n\n:Raises: *InvalidRequest* - when NumPy support is not available\n\n:Raises: *InvalidDataType* - when column contains strings\n\n::\n\n    valueArray = table.getColumnAsNumpy(0)\n\n")
+        .def("setColumn", &NtTable::setColumn, args("index", "values"), "Sets column values.\n\n:Parameter: *index* (int) - column index\n\n:Parameter: *values* (object) - list of column values, or object supporting python buffer protocol (e.g., NumPy array), whose data is copied in bulk with conversion to the column data type if needed\n\n::\n\n    table.setColumn(0, ['x', 'y', 'z'])\n\n    table.setColumn(1, numpy.random.uniform(0, 1, 3))\n\n")
         .def("getDescriptor", &NtTable::getDescriptor, "Retrieves table descriptor.\n\n:Returns: table descriptor\n\n::\n\n    descriptor = table.getDescriptor()\n\n")
         .def("setDescriptor", &NtTable::setDescriptor, args("descriptor"), "Sets table descriptor.\n\n:Parameter: *descriptor* (str) - table descriptor\n\n::\n\n    table.setDescriptor('myTable')\n\n")
         .def("getTimeStamp", &NtTable::getTimeStamp, "Retrieves table time stamp.\n\n:Returns: table time stamp object\n\n::\n\n    timeStamp = table.getTimeStamp()\n\n")
@@ -1355,13 +1430,19 @@ BOOST_PYTHON_MODULE(pvaccess)
         ;
 
     // Channel
-    class_<Channel>("Channel", "This class represents PV channels.\n\n**Channel(name [, providerType=PVA])**\n\n\t:Parameter: *fieldName* (str) - channel name\n\n\t:Parameter: *providerType* (PROVIDERTYPE) - provider type, either PVA (PV Access) or CA (Channel Access)\n\n\tNote that PV structures representing objects on CA channels always have a single key 'value'.\n\tThe following example creates PVA channel 'enum01':\n\n\t::\n\n\t\tpvaChannel = Channel('enum01')\n\n\tThis example allows access to CA channel 'CA:INT':\n\n\t::\n\n\t\tcaChannel = Channel('CA:INT', CA)\n\n", init<std::string>())
+    class_<Channel>("Channel", "This class represents PV channels.\n\n**Channel(name [, providerType=PVA [, waitForConnection=True]])**\n\n\t:Parameter: *fieldName* (str) - channel name\n\n\t:Parameter: *providerType* (PROVIDERTYPE) - provider type, either PVA (PV Access) or CA (Channel Access)\n\n\t:Parameter: *waitForConnection* (bool) - if False, constructor returns immediately while channel connects in the background, and the first channel operation waits for connection to complete; use *asyncConnect()* to be notified when connection completes\n\n\tNote that PV structures representing objects on CA channels always have a single key 'value'.\n\tThe following example creates PVA channel 'enum01':\n\n\t::\n\n\t\tpvaChannel = Channel('enum01')\n\n\tThis example allows access to CA channel 'CA:INT':\n\n\t::\n\n\t\tcaChannel = Channel('CA:INT', CA)\n\n", init<std::string>())
         .def(init<std::string, PvProvider::ProviderType>())
+        .def(init<std::string, PvProvider::ProviderType, bool>())
+        .def("isConnected", &Channel::isConnected, "Checks whether channel is connected.\n\n:Returns: True if channel is connected, False otherwise\n\n::\n\n    connected = channel.isConnected()\n\n")
+        .def("asyncConnect", &Channel::asyncConnect, args("callback", "errorCallback"), "Waits for channel connection in the background, up to the channel timeout. Method returns immediately; callbacks are invoked from a separate thread. Waits for many channels created with *waitForConnection=False* proceed in parallel.\n\n:Parameter: *callback* (object) - python object (e.g., python function) that will be invoked without arguments once channel is connected\n\n:Parameter: *errorCallback* (object) - python object that will be invoked with error message (str) as argument if channel does not connect within the channel timeout; if None, error is logged\n\n::\n\n    def connected():\n\n        print 'Channel connected'\n\n    def failed(message):\n\n        print 'Connection failed: ', message\n\n    channel = Channel('float01', PVA, False)\n\n    channel.asyncConnect(connected, failed)\n\n")
         .def("get", static_cast<PvObject*(Channel::*)(const std::string&)>(&Channel::get), 
             return_value_policy<manage_new_object>(), args("requestDescriptor"), "Retrieves PV data from the channel.\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n:Returns: channel PV data corresponding to the specified request descriptor\n\n::\n\n    channel = Channel('enum01')\n\n    pv = channel.get('field(value.index)')\n\n")
         .def("get", static_cast<PvObject*(Channel::*)()>(&Channel::get), 
             return_value_policy<manage_new_object>(), "Retrieves PV data from the channel using the default request descriptor 'field(value)'.\n\n:Returns: channel PV data\n\n::\n\n    pv = channel.get()\n\n")
 
+        .def("put", static_cast<void(Channel::*)(const boost::python::object&, const std::string&)>(&Channel::put), args("valueArray", "requestDescriptor"), "Assigns scalar array data to the channel PV from an object that supports python buffer protocol (e.g., NumPy array). Array data is copied in bulk, with conversion to the channel PV data type if needed.\n\n:Parameter: *valueArray* (object) - array of scalar values that will be assigned to channel data according to the specified request descriptor\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n")
+        .def("put", static_cast<void(Channel::*)(const boost::python::object&)>(&Channel::put), args("valueArray"), "Assigns scalar array data to the channel PV from an object that supports python buffer protocol (e.g., NumPy array) using the default request descriptor 'field(value)'. Array data is copied in bulk, with conversion to the channel PV data type if needed.\n\n:Parameter: *valueArray* (object) - array of scalar values that will be assigned to the channel PV\n\n::\n\n    channel = Channel('doubleArray01')\n\n    channel.put(numpy.arange(1000000, dtype=numpy.float64))\n\n")
+
         .def("put", static_cast<void(Channel::*)(const PvObject&, const std::string&)>(&Channel::put), args("pvObject", "requestDescriptor"), "Assigns PV data to the channel process variable.\n\n:Parameter: *pvObject* (PvObject) - PV object that will be assigned to channel PV according to the specified request descriptor\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n::\n\n    channel = Channel('enum01')\n\n    channel.put(PvInt(1), 'field(value.index)')\n\n")
         .def("put", static_cast<void(Channel::*)(const PvObject&)>(&Channel::put), args("pvObject"), "Assigns PV data to the channel process variable using the default request descriptor 'field(value)'.\n\n:Parameter: *pvObject* (PvObject) - PV object that will be assigned to the channel process variable\n\n::\n\n    channel = Channel('int01')\n\n    channel.put(PvInt(1))\n\n")
 
@@ -1370,6 +1451,8 @@ BOOST_PYTHON_MODULE(pvaccess)
         .def("putString", static_cast<void(Channel::*)(const std::string&)>(&Channel::put), args("value"), "Assigns string data to the channel PV using the default request descriptor 'field(value)'.\n\n:Parameter: *value* (str) - string value that will be assigned to the channel PV\n\n::\n\n    channel = Channel('string01')\n\n    channel.putString('string value')\n\n")
         .def("put", static_cast<void(Channel::*)(const std::string&)>(&Channel::put), args("value"), "Assigns string data to the channel PV using the default request descriptor 'field(value)'.\n\n:Parameter: *value* (str) - string value that will be assigned to the channel PV\n\n::\n\n    channel = Channel('string01')\n\n    channel.put('string value')\n\n")
 
+        .def("putScalarArray", static_cast<void(Channel::*)(const boost::python::object&, const std::string&)>(&Channel::put), args("valueArray", "requestDescriptor"), "Assigns scalar array data to the channel PV from an object that supports python buffer protocol (e.g., NumPy array).\n\n:Parameter: *valueArray* (object) - array of scalar values that will be assigned to channel data according to the specified request descriptor\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n")
+        .def("putScalarArray", static_cast<void(Channel::*)(const boost::python::object&)>(&Channel::put), args("valueArray"), "Assigns scalar array data to the channel PV from an object that supports python buffer protocol (e.g., NumPy array) using the default request descriptor 'field(value)'.\n\n:Parameter: *valueArray* (object) - array of scalar values that will be assigned to the channel PV\n\n")
         .def("putScalarArray", static_cast<void(Channel::*)(const boost::python::list&, const std::string&)>(&Channel::put), args("valueList", "requestDescriptor"), "Assigns scalar array data to the channel PV using the default request descriptor 'field(value)'.\n\n:Parameter: *valueList* (list) - list of scalar values that will be assigned to the channel PV\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n")
         .def("put", static_cast<void(Channel::*)(const boost::python::list&, const std::string&)>(&Channel::put), args("valueList", "requestDescriptor"), "Assigns scalar array data to the channel PV using the default request descriptor 'field(value)'.\n\n:Parameter: *valueList* (list) - list of scalar values that will be assigned to the channel PV\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n")
         .def("putScalarArray", static_cast<void(Channel::*)(const boost::python::list&)>(&Channel::put), args("valueList"), "Assigns scalar array data to the channel PV using the default request descriptor 'field(value)'.\n\n:Parameter: *valueList* (list) - list of scalar values that will be assigned to the channel PV\n\n::\n\n    channel = Channel('intArray01')\n\n    channel.putScalarArray([0,1,2,3,4])\n\n")
@@ -1429,7 +1512,13 @@ BOOST_PYTHON_MODULE(pvaccess)
         .def("putDouble", static_cast<void(Channel::*)(double)>(&Channel::put), args("value"), "Puts double data into the channel using the default request descriptor 'field(value)'.\n\n:Parameter: *value* (float) - double value that will be assigned to the channel PV\n\n::\n\n    channel = Channel('double01')\n\n    channel.putDouble(1.1)\n\n")
         .def("put", static_cast<void(Channel::*)(double)>(&Channel::put), args("value"), "Puts double data into the channel using the default request descriptor 'field(value)'.\n\n:Parameter: *value* (float) - double value that will be assigned to the channel PV\n\n::\n\n    channel = Channel('double01')\n\n    channel.put(1.1)\n\n")
 
+        .def("asyncGet", static_cast<void(Channel::*)(const boost::python::object&, const boost::python::object&, const std::string&)>(&Channel::asyncGet), args("callback", "errorCallback", "requestDescriptor"), "Asynchronously retrieves PV data from the channel. Method returns immediately; callbacks are invoked from a separate thread once request completes. Requests issued in a sequence are processed in parallel.\n\n:Parameter: *callback* (object) - python object (e.g., python function) that will be invoked with channel PV data (PvObject) as argument\n\n:Parameter: *errorCallback* (object) - python object that will be invoked with error message (str) as argument if request fails; if None, error is logged\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n::\n\n    def echo(pv):\n\n        print 'PV value: ', pv\n\n    def error(message):\n\n        print 'Get failed: ', message\n\n    channel = Channel('enum01')\n\n    channel.asyncGet(echo, error, 'field(value.index)')\n\n")
+        .def("asyncGet", static_cast<void(Channel::*)(const boost::python::object&, const boost::python::object&)>(&Channel::asyncGet), args("callback", "errorCallback"), "Asynchronously retrieves PV data from the channel using the default request descriptor 'field(value)'.\n\n:Parameter: *callback* (object) - python object (e.g., python function) that will be invoked with channel PV data (PvObject) as argument\n\n:Parameter: *errorCallback* (object) - python object that will be invoked with error message (str) as argument if request fails; if None, error is logged\n\n::\n\n    channel.asyncGet(echo, error)\n\n")
+        .def("asyncPut", static_cast<void(Channel::*)(const PvObject&, const boost::python::object&, const boost::python::object&, const std::string&)>(&Channel::asyncPut), args("pvObject", "callback", "errorCallback", "requestDescriptor"), "Asynchronously assigns PV data to the channel. Method returns immediately; callbacks are invoked from a separate thread once request completes. Requests issued in a sequence are processed in parallel.\n\n:Parameter: *pvObject* (PvObject) - PV object that will be assigned to channel data according to the specified request descriptor\n\n:Parameter: *callback* (object) - python object (e.g., python function) that will be invoked without arguments after successful put\n\n:Parameter: *errorCallback* (object) - python object that will be invoked with error message (str) as argument if request fails; if None, error is logged\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n::\n\n    def done():\n\n        print 'Put done'\n\n    channel = Channel('enum01')\n\n    channel.asyncPut(PvInt(1), done, None, 'field(value.index)')\n\n")
+        .def("asyncPut", static_cast<void(Channel::*)(const PvObject&, const boost::python::object&, const boost::python::object&)>(&Channel::asyncPut), args("pvObject", "callback", "errorCallback"), "Asynchronously assigns PV data to the channel using the default request descriptor 'field(value)'.\n\n:Parameter: *pvObject* (PvObject) - PV object that will be assigned to channel data\n\n:Parameter: *callback* (object) - python object (e.g., python function) that will be invoked without arguments after successful put\n\n:Parameter: *errorCallback* (object) - python object that will be invoked with error message (str) as argument if request fails; if None, error is logged\n\n::\n\n    channel = Channel('float01')\n\n    channel.asyncPut(PvFloat(1.1), done, error)\n\n")
+
         .def("subscribe", &Channel::subscribe, args("subscriberName", "subscriber"), "Subscribes python object to notifications of changes in PV value. Channel can have any number of subscribers that start receiving PV updates after *startMonitor()* is invoked. Updates stop after channel monitor is stopped via *stopMonitor()* call, or object is unsubscribed from notifications using *unsubscribe()* call.\n\n:Parameter: *fieldName* (str) - subscriber object name\n\n:Parameter: *subscriber* (object) - reference to python subscriber object (e.g., python function) that will be executed when PV value changes\n\nThe following code snippet defines a simple subscriber object, subscribes it to PV value changes, and starts channel monitor:\n\n::\n\n    def echo(x):\n\n        print 'New PV value: ', x\n\n    channel = Channel('float01')\n\n    channel.subscribe('echo', echo)\n\n    channel.startMonitor()\n\n")
+        .def("subscribeBatch", &Channel::subscribeBatch, args("subscriberName", "subscriber"), "Subscribes python object to batched notifications of changes in PV value. Batch subscriber is called with a list of PV objects, containing all updates processed together (see *setMonitorBatchSize()* and *setMonitorBatchTime()*), so that python GIL is acquired once per batch rather than once per update. Subscriber names are shared with *subscribe()*.\n\n:Parameter: *subscriberName* (str) - subscriber object name\n\n:Parameter: *subscriber* (object) - reference to python subscriber object (e.g., python function) that will be executed with list of PV objects\n\n::\n\n    def echoBatch(pvObjects):\n\n        print 'Received %d updates' % len(pvObjects)\n\n    channel = Channel('float01')\n\n    channel.setMonitorBatchSize(100)\n\n    channel.subscribeBatch('echoBatch', echoBatch)\n\n    channel.startMonitor()\n\n")
         .def("unsubscribe", &Channel::unsubscribe, args("fieldName"), "Unsubscribes subscriber object from notifications of changes in PV value.\n\n:Parameter: *fieldName* (str) - subscriber name\n\n::\n\n    channel.unsubscribe('echo')\n\n")
         .def("startMonitor", static_cast<void(Channel::*)(const std::string&)>(&Channel::startMonitor), args("requestDescriptor"), "Starts channel monitor for PV value changes.\n\n:Parameter: *requestDescriptor* (str) - describes what PV data should be sent to subscribed channel clients\n\n::\n\n    channel.startMonitor('field(value.index)')\n\n")
         .def("startMonitor", static_cast<void(Channel::*)()>(&Channel::startMonitor), "Starts channel monitor for PV value changes using the default request descriptor 'field(value)'.\n\n::\n\n    channel.startMonitor()\n\n")
@@ -1437,12 +1526,47 @@ BOOST_PYTHON_MODULE(pvaccess)
         .def("getTimeout", &Channel::getTimeout, "Retrieves channel timeout.\n\n:Returns: channel timeout in seconds\n\n::\n\n    timeout = channel.getTimeout()\n\n")
         .def("setTimeout", &Channel::setTimeout, args("timeout"), "Sets channel timeout.\n\n:Parameter: *timeout* (float) - channel timeout in seconds\n\n::\n\n    channel.setTimeout(10.0)\n\n")
         .def("getMonitorMaxQueueLength", &Channel::getMonitorMaxQueueLength, "Retrieves maximum monitor queue length.\n\n:Returns: maximum monitor queue length\n\n::\n\n    maxQueueLength = channel.getMonitorMaxQueueLength()\n\n")
-        .def("setMonitorMaxQueueLength", &Channel::setMonitorMaxQueueLength, args("maxQueueLength"), "Sets maximum monitor queue length. In case subscribers cannot process incoming PV objects quickly enough, oldest PV object will be discarded after monitoring queue reaches maximum size. Default monitor queue length is unlimited.\n\n:Parameter: *maxQueueLength* (int) - maximum queue length\n\n::\n\n    channel.setMonitorMaxQueueLengthTimeout(10)\n\n")
+        .def("setMonitorMaxQueueLength", &Channel::setMonitorMaxQueueLength, args("maxQueueLength"), "Sets maximum monitor queue length. In case subscribers cannot process incoming PV objects quickly enough, monitor queue overflow policy determines what happens after monitoring queue reaches maximum size; by default, oldest PV object will be discarded. Default monitor queue length is unlimited.\n\n:Parameter: *maxQueueLength* (int) - maximum queue length\n\n::\n\n    channel.setMonitorMaxQueueLengthTimeout(10)\n\n")
+        .def("setMonitorQueueLockFree", &Channel::setMonitorQueueLockFree, args("lockFree"), "Selects monitor queue implementation. Lock-free queue is a preallocated ring buffer that avoids locking and per-update signaling between the threads receiving and processing PV updates, and is recommended for high-rate monitors. Its size is given by the maximum monitor queue length (1024 if unlimited), applied when monitor is started; updates received while queue is full are dropped regardless of the overflow policy. Queue type cannot be changed while monitor is running.\n\n:Parameter: *lockFree* (bool) - if True, lock-free queue will be used\n\n:Raises: *InvalidRequest* - if monitor is running\n\n::\n\n    channel.setMonitorQueueLockFree(True)\n\n")
+        .def("setMonitorOverflowPolicy", &Channel::setMonitorOverflowPolicy, args("overflowPolicy"), "Sets monitor queue overflow policy, which determines what happens to PV updates received while monitor queue has maximum length: DROP_OLDEST discards the oldest queued update (default), DROP_NEWEST discards the received update, COALESCE_TO_LATEST replaces the newest queued update with the received one, whose changed fields include those of the replaced update, and BLOCK_PRODUCER stops taking updates from pvAccess while the queue is full, so that no updates are lost by the monitor queue itself; pvAccess then holds updates back in its own queue, where overruns are reported in the overrun bit set, and pvAccess threads are never blocked. Policy is not used by the lock-free queue.\n\n:Parameter: *overflowPolicy* (QueueOverflowPolicy) - monitor queue overflow policy\n\n::\n\n    channel.setMonitorMaxQueueLength(100)\n\n    channel.setMonitorOverflowPolicy(pvaccess.COALESCE_TO_LATEST)\n\n")
+        .def("getMonitorOverflowPolicy", &Channel::getMonitorOverflowPolicy, "Retrieves monitor queue overflow policy.\n\n:Returns: monitor queue overflow policy\n\n::\n\n    overflowPolicy = channel.getMonitorOverflowPolicy()\n\n")
+        .def("getMonitorStatistics", &Channel::getMonitorStatistics, "Retrieves monitor queue statistics, which are reset when monitor is started. Returned dictionary contains number of updates received by the monitor ('received'), delivered to subscribers ('delivered') and dropped by the queue ('dropped', including updates discarded when monitor is stopped), as well as maximum ('maxQueueDepth') and current ('queueDepth') number of queued updates. Number of received updates equals the sum of delivered, dropped and queued updates.\n\n:Returns: dictionary of monitor statistics\n\n::\n\n    statistics = channel.getMonitorStatistics()\n\n")
+        .def("isMonitorQueueLockFree", &Channel::isMonitorQueueLockFree, "Checks whether lock-free monitor queue is selected.\n\n:Returns: True if lock-free monitor queue is used, False otherwise\n\n::\n\n    lockFree = channel.isMonitorQueueLockFree()\n\n")
+        .def("setMonitorCopyOnChange", &Channel::setMonitorCopyOnChange, args("copyOnChange"), "Selects copy-on-change monitor mode. Instead of copying entire PV structure for every update, monitor reuses preallocated PV objects that are no longer referenced, and copies into them only fields that have changed; array data is shared rather than copied. PV objects received by subscribers in this mode must not be modified. Mode cannot be changed while monitor is running.\n\n:Parameter: *copyOnChange* (bool) - if True, copy-on-change mode will be used\n\n:Raises: *InvalidRequest* - if monitor is running\n\n::\n\n    channel.setMonitorCopyOnChange(True)\n\n")
+        .def("isMonitorCopyOnChange", &Channel::isMonitorCopyOnChange, "Checks whether copy-on-change monitor mode is selected.\n\n:Returns: True if copy-on-change mode is used, False otherwise\n\n::\n\n    copyOnChange = channel.isMonitorCopyOnChange()\n\n")
+        .def("setMonitorBatchSize", &Channel::setMonitorBatchSize, args("batchSize"), "Sets maximum number of queued PV updates that are processed together. All subscribers for the whole batch are called while python GIL is acquired once, and batch subscribers receive list of PV objects. Default batch size is 1.\n\n:Parameter: *batchSize* (int) - maximum number of PV updates per batch\n\n:Raises: *InvalidArgument* - if batch size is not positive\n\n::\n\n    channel.setMonitorBatchSize(100)\n\n")
+        .def("getMonitorBatchSize", &Channel::getMonitorBatchSize, "Retrieves maximum number of PV updates processed together.\n\n:Returns: maximum monitor batch size\n\n::\n\n    batchSize = channel.getMonitorBatchSize()\n\n")
+        .def("setMonitorBatchTime", &Channel::setMonitorBatchTime, args("batchTime"), "Sets time budget for collecting PV updates into a batch. After the first update of a batch is received, processing thread waits up to this time for the batch to fill up. Default batch time is 0, in which case only updates that are already queued are batched together.\n\n:Parameter: *batchTime* (float) - batch time in seconds\n\n:Raises: *InvalidArgument* - if batch time is negative\n\n::\n\n    channel.setMonitorBatchTime(0.01)\n\n")
+        .def("getMonitorBatchTime", &Channel::getMonitorBatchTime, "Retrieves time budget for collecting PV updates into a batch.\n\n:Returns: monitor batch time in seconds\n\n::\n\n    batchTime = channel.getMonitorBatchTime()\n\n")
+        .def("setMonitorWorkerPoolSize", &Channel::setMonitorWorkerPoolSize, args("workerPoolSize"), "Sets number of worker threads that deliver monitor updates to subscribers. Worker threads are shared by all monitored channels, and updates for any given channel are always delivered in order, by one worker at a time. Default pool size is 4; values smaller than 1 restore the default.\n\n:Parameter: *workerPoolSize* (int) - number of monitor worker threads\n\n::\n\n    Channel.setMonitorWorkerPoolSize(8)\n\n")
+        .staticmethod("setMonitorWorkerPoolSize")
+        .def("getMonitorWorkerPoolSize", &Channel::getMonitorWorkerPoolSize, "Retrieves number of worker threads that deliver monitor updates to subscribers.\n\n:Returns: number of monitor worker threads\n\n::\n\n    workerPoolSize = Channel.getMonitorWorkerPoolSize()\n\n")
+        .staticmethod("getMonitorWorkerPoolSize")
+        ;
+
+    // Channel Group
+    class_<ChannelGroup>("ChannelGroup", "This class represents a group of PV channels that are connected, read and written together. Connections and requests for all channels are issued before waiting for any of them to complete, so that group operations take about as long as a single channel operation.\n\n**ChannelGroup(names [, providerType=PVA])**\n\n\t:Parameter: *names* (list) - list of channel names\n\n\t:Parameter: *providerType* (PROVIDERTYPE) - provider type, either PVA (PV Access) or CA (Channel Access)\n\n\tConstructor waits for channel connections up to the default channel timeout. Channels that fail to connect do not cause exception; their connection errors are reported by *getStatus()*.\n\n\t::\n\n\t\tgroup = ChannelGroup(['float01', 'float02', 'enum01'])\n\n", init<boost::python::list>())
+        .def(init<boost::python::list, PvProvider::ProviderType>())
+        .def("getChannelNames", &ChannelGroup::getChannelNames, "Retrieves names of channels in the group.\n\n:Returns: list of channel names\n\n::\n\n    names = group.getChannelNames()\n\n")
+        .def("get", static_cast<boost::python::dict(ChannelGroup::*)(const std::string&)>(&ChannelGroup::get), args("requestDescriptor"), "Retrieves PV data from all connected channels in the group.\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n:Returns: dictionary of channel PV data (PvObject) keyed by channel name; channels for which request failed are omitted, and their errors are reported by *getStatus()*\n\n::\n\n    pvDict = group.get('field(value,timeStamp)')\n\n")
+        .def("get", static_cast<boost::python::dict(ChannelGroup::*)()>(&ChannelGroup::get), "Retrieves PV data from all connected channels in the group using the default request descriptor 'field(value)'.\n\n:Returns: dictionary of channel PV data (PvObject) keyed by channel name\n\n::\n\n    pvDict = group.get()\n\n")
+        .def("put", static_cast<void(ChannelGroup::*)(const boost::python::dict&, const std::string&)>(&ChannelGroup::put), args("pvObjectDict", "requestDescriptor"), "Assigns PV data to group channels. Failed requests do not cause exception; errors are reported by *getStatus()*.\n\n:Parameter: *pvObjectDict* (dict) - dictionary of PV objects keyed by channel name\n\n:Parameter: *requestDescriptor* (str) - PV request descriptor\n\n:Raises: *ObjectNotFound* - if dictionary contains channel that is not a group member\n\n::\n\n    group.put({'float01' : PvFloat(1.1), 'float02' : PvFloat(2.2)}, 'field(value)')\n\n")
+        .def("put", static_cast<void(ChannelGroup::*)(const boost::python::dict&)>(&ChannelGroup::put), args("pvObjectDict"), "Assigns PV data to group channels using the default request descriptor 'field(value)'.\n\n:Parameter: *pvObjectDict* (dict) - dictionary of PV objects keyed by channel name\n\n:Raises: *ObjectNotFound* - if dictionary contains channel that is not a group member\n\n::\n\n    group.put({'float01' : PvFloat(1.1), 'float02' : PvFloat(2.2)})\n\n")
+        .def("getStatus", &ChannelGroup::getStatus, "Retrieves status of the most recent connection attempt or request for each channel in the group.\n\n:Returns: dictionary of error messages keyed by channel name; empty string denotes success\n\n::\n\n    for (name,error) in group.getStatus().items():\n\n        if error:\n\n            print name, error\n\n")
+        .def("connect", &ChannelGroup::connect, "Waits up to the group timeout for disconnected channels to connect. Connection errors are reported by *getStatus()*.\n\n::\n\n    group.connect()\n\n")
+        .def("getTimeout", &ChannelGroup::getTimeout, "Retrieves group timeout.\n\n:Returns: group timeout in seconds\n\n::\n\n    timeout = group.getTimeout()\n\n")
+        .def("setTimeout", &ChannelGroup::setTimeout, args("timeout"), "Sets group timeout used for connections.\n\n:Parameter: *timeout* (float) - group timeout in seconds\n\n::\n\n    group.setTimeout(10.0)\n\n")
         ;
 
     // RPC Client
     class_<RpcClient>("RpcClient", "RpcClient is a client class for PVA RPC services.\n\n**RpcClient(channelName)**\n\n\t:Parameter: *channelName* (str) - RPC service channel name\n\n\tThis example creates RPC client for channel 'createNtTable':\n\n\t::\n\n\t\trpcClient = RpcClient('createNtTable')\n\n", init<std::string>())
-        .def("invoke", &RpcClient::invoke, return_value_policy<manage_new_object>(), args("pvRequest"), "Invokes RPC call against service registered on the PV specified channel.\n\n:Parameter: *pvRequest* (PvObject) - PV request object with a structure conforming to requirements of the RPC service registered on the given PV channel\n\n:Returns: PV response object\n\nThe following code works with the above RPC service example:\n\n::\n\n    pvRequest = PvObject({'nRows' : INT, 'nColumns' : INT})\n\n    pvRequest.set({'nRows' : 10, 'nColumns' : 10})\n\n    pvResponse = rpcClient(pvRequest)\n\n    ntTable = NtTable(pvRequest)\n\n")
+        .def("invoke", static_cast<PvObject*(RpcClient::*)(const PvObject&)>(&RpcClient::invoke), return_value_policy<manage_new_object>(), args("pvRequest"), "Invokes RPC call against service registered on the PV specified channel, using default timeout of 1 second.\n\n:Parameter: *pvRequest* (PvObject) - PV request object with a structure conforming to requirements of the RPC service registered on the given PV channel\n\n:Returns: PV response object\n\nThe following code works with the above RPC service example:\n\n::\n\n    pvRequest = PvObject({'nRows' : INT, 'nColumns' : INT})\n\n    pvRequest.set({'nRows' : 10, 'nColumns' : 10})\n\n    pvResponse = rpcClient(pvRequest)\n\n    ntTable = NtTable(pvRequest)\n\n")
+        .def("invoke", static_cast<PvObject*(RpcClient::*)(const PvObject&, double)>(&RpcClient::invoke), return_value_policy<manage_new_object>(), args("pvRequest", "timeout"), "Invokes RPC call against service registered on the PV specified channel.\n\n:Parameter: *pvRequest* (PvObject) - PV request object\n\n:Parameter: *timeout* (float) - time in seconds to wait for response\n\n:Returns: PV response object\n\n::\n\n    pvResponse = rpcClient.invoke(pvRequest, 5.0)\n\n")
+        .def("invokeAsync", &RpcClient::invokeAsync, RpcClientInvokeAsync(args("pvRequest", "callback", "errorCallback=None", "timeout=1.0"), "Asynchronously invokes RPC call against service registered on the PV specified channel. Method returns immediately; callbacks are invoked from a separate thread once request completes. Requests issued in a sequence are in flight at the same time, each using its own pooled service connection; new connections needed for such requests are established in parallel, before any request is sent. Idle connections are kept for reuse, up to the limit set with setConnectionPoolSize() (by default, as many as were in use at the same time).\n\n:Parameter: *pvRequest* (PvObject) - PV request object\n\n:Parameter: *callback* (object) - python object (e.g., python function) that will be invoked with PV response object as argument\n\n:Parameter: *errorCallback* (object) - python object that will be invoked with error message (str) as argument if request fails; if None, error is logged\n\n:Parameter: *timeout* (float) - time in seconds to wait for response\n\n::\n\n    def echo(pvResponse):\n\n        print 'Response: ', pvResponse\n\n    def error(message):\n\n        print 'Request failed: ', message\n\n    for i in range(0,100):\n\n        rpcClient.invokeAsync(pvRequest, echo, error)\n\n"))
+        .def("setConnectionPoolSize", &RpcClient::setConnectionPoolSize, args("connectionPoolSize"), "Sets maximum number of idle service connections kept for reuse per RPC service channel. Connections are shared by all RPC clients in the process. By default, there is no limit, so that pool keeps as many connections as there were requests in flight at the same time.\n\n:Parameter: *connectionPoolSize* (int) - maximum number of idle connections per channel (0 means no limit; negative values restore default of no limit)\n\n::\n\n    RpcClient.setConnectionPoolSize(32)\n\n")
+        .staticmethod("setConnectionPoolSize")
+        .def("getConnectionPoolSize", &RpcClient::getConnectionPoolSize, "Retrieves maximum number of idle service connections kept for reuse per RPC service channel.\n\n:Returns: maximum number of idle connections per channel, or 0 if there is no limit\n\n::\n\n    connectionPoolSize = RpcClient.getConnectionPoolSize()\n\n")
+        .staticmethod("getConnectionPoolSize")
         ;
     
     // RPC Service Impl
@@ -1450,15 +1574,38 @@ BOOST_PYTHON_MODULE(pvaccess)
         ;
 
     // RPC Server
-    class_<RpcServer>("RpcServer", "RpcServer is class used for hosting PVA RPC services. One instance of RpcServer can host multiple RPC services.\n\n**RpcServer()**:\n\n\t::\n\n\t\trpcServer = RpcServer()\n\n", init<>())
-        .def("registerService", &RpcServer::registerService, args("serviceName", "serviceImpl"), "Registers service implementation with RPC server. Typically, all services are registered before RPC server starts listening for client requests.\n\n:Parameter: *serviceName* (str) - service name (name of the PV channel used for RPC client/server communication)\n\n:Parameter: *serviceImpl* (object) - reference to service implementation object (e.g., python function) that returns PV Object upon invocation\n\nThe following is an example of RPC service that creates NT Table according to client specifications:\n\n::\n\n    import pvaccess\n\n    import random\n\n    def createNtTable(pvRequest):\n\n        nRows = x.getInt('nRows')\n\n        nColumns = x.getInt('nColumns')\n\n        print 'Creating table with %d rows and %d columns' % (nRows, nColumns)\n\n        ntTable = pvaccess.NtTable(nColumns, pvaccess.DOUBLE)\n\n        labels = []\n\n        for j in range (0, nColumns):\n\n            labels.append('Column%s' % j)\n\n            column = []\n\n            for i in range (0, nRows):\n\n                column.append(random.uniform(0,1))\n\n            ntTable.setColumn(j, column)\n\n        ntTable.setLabels(labels)\n\n        ntTable.setDescriptor('Automatically created by pvaPy RPC Server')\n\n        return ntTable\n\n    \n\n    rpcServer = pvaccess.RpcServer()\n\n    rpcServer.registerService('createNtTable', createNtTable)\n\n    rpcServer.listen()\n\n")
+    class_<RpcServer, boost::noncopyable>("RpcServer", "RpcServer is class used for hosting PVA RPC services. One instance of RpcServer can host multiple RPC services.\n\n**RpcServer()**:\n\n\t::\n\n\t\trpcServer = RpcServer()\n\n", init<>())
+        .def("registerService", &RpcServer::registerService, RpcServerRegisterService(args("serviceName", "serviceImpl", "maxConcurrentRequests=0"), "Registers service implementation with RPC server. Typically, all services are registered before RPC server starts listening for client requests. Service requests are processed by the server worker threads.\n\n:Parameter: *serviceName* (str) - service name (name of the PV channel used for RPC client/server communication)\n\n:Parameter: *serviceImpl* (object) - reference to service implementation object (e.g., python function) that returns PV Object upon invocation\n\n:Parameter: *maxConcurrentRequests* (int) - maximum number of requests for this service that are processed at the same time (0 indicates no limit other than the worker pool size)\n\nThe following is an example of RPC service that creates NT Table according to client specifications:\n\n::\n\n    import pvaccess\n\n    import random\n\n    def createNtTable(pvRequest):\n\n        nRows = x.getInt('nRows')\n\n        nColumns = x.getInt('nColumns')\n\n        print 'Creating table with %d rows and %d columns' % (nRows, nColumns)\n\n        ntTable = pvaccess.NtTable(nColumns, pvaccess.DOUBLE)\n\n        labels = []\n\n        for j in range (0, nColumns):\n\n            labels.append('Column%s' % j)\n\n            column = []\n\n            for i in range (0, nRows):\n\n                column.append(random.uniform(0,1))\n\n            ntTable.setColumn(j, column)\n\n        ntTable.setLabels(labels)\n\n        ntTable.setDescriptor('Automatically created by pvaPy RPC Server')\n\n        return ntTable\n\n    \n\n    rpcServer = pvaccess.RpcServer()\n\n    rpcServer.registerService('createNtTable', createNtTable)\n\n    rpcServer.listen()\n\n"))
         .def("unregisterService", &RpcServer::unregisterService, args("serviceName"), "Unregisters given service from RPC server.\n\n:Parameter: *serviceName* (str) - service name (name of the PV channel used for RPC client/server communication)\n\n::\n\n    rpcServer.unregisterService('createNtTable')\n\n")
+        .def("setWorkerPoolSize", &RpcServer::setWorkerPoolSize, args("workerPoolSize"), "Sets number of worker threads that process RPC requests for all services registered with this server.\n\n:Parameter: *workerPoolSize* (int) - number of worker threads (values smaller than 1 restore default size of 4)\n\n::\n\n    rpcServer.setWorkerPoolSize(16)\n\n")
+        .def("getWorkerPoolSize", &RpcServer::getWorkerPoolSize, "Retrieves number of worker threads that process RPC requests.\n\n:Returns: number of worker threads\n\n::\n\n    workerPoolSize = rpcServer.getWorkerPoolSize()\n\n")
+        .def("setMaxPendingRequests", &RpcServer::setMaxPendingRequests, args("maxPendingRequests"), "Sets maximum number of requests waiting to be processed. Requests received while this many requests are waiting are rejected with error status.\n\n:Parameter: *maxPendingRequests* (int) - maximum number of pending requests (values smaller than 1 restore default of 1000)\n\n::\n\n    rpcServer.setMaxPendingRequests(100)\n\n")
+        .def("getMaxPendingRequests", &RpcServer::getMaxPendingRequests, "Retrieves maximum number of requests waiting to be processed.\n\n:Returns: maximum number of pending requests\n\n::\n\n    maxPendingRequests = rpcServer.getMaxPendingRequests()\n\n")
+        .def("setServiceConcurrencyLimit", &RpcServer::setServiceConcurrencyLimit, args("serviceName", "maxConcurrentRequests"), "Sets maximum number of requests for given service that are processed at the same time. Other requests for this service wait in the pending queue, while requests for other services may proceed.\n\n:Parameter: *serviceName* (str) - service name\n\n:Parameter: *maxConcurrentRequests* (int) - maximum number of concurrent requests (0 indicates no limit other than the worker pool size)\n\n::\n\n    rpcServer.setServiceConcurrencyLimit('createNtTable', 2)\n\n")
+        .def("getServiceConcurrencyLimit", &RpcServer::getServiceConcurrencyLimit, args("serviceName"), "Retrieves maximum number of requests for given service that are processed at the same time.\n\n:Parameter: *serviceName* (str) - service name\n\n:Returns: maximum number of concurrent requests (0 indicates no limit)\n\n::\n\n    maxConcurrentRequests = rpcServer.getServiceConcurrencyLimit('createNtTable')\n\n")
         .def("startListener", &RpcServer::startListener, "Starts RPC listener in its own thread. This method is typically used for multi-threaded programs, or for testing and debugging in python interactive mode. It should be used in conjunction with *stopListener()* call.\n\n::\n\n    rpcServer.startListener()")
-        .def("stopListener", &RpcServer::stopListener, "Stops RPC listener thread. This method is used in conjunction with *startListener()* call.\n\n::\n\n    rpcServer.stopListener()\n\n")
+        .def("stopListener", &RpcServer::stopListener, RpcServerStopListener(args("drainTimeout=5.0"), "Stops RPC listener thread. This method is used in conjunction with *startListener()* call. Server stops accepting new requests, waits for accepted requests to complete, and returns after listener thread exits.\n\n:Parameter: *drainTimeout* (float) - maximum time in seconds to wait for accepted requests; requests still waiting to be processed after that are rejected, while requests in progress are allowed to complete\n\n::\n\n    rpcServer.stopListener()\n\n"))
         .def("start", &RpcServer::start, "Start serving RPC requests. This method is equivalent to *listen()*, and blocks until either *stop()* or *shutdown()* methods are invoked.\n\n::\n\n    rpcServer.start()")
-        .def("stop", &RpcServer::stop, "Stop serving RPC requests. This method is equivalent to *shutdown()*.\n\n::\n\n    rpcServer.stop()")
+        .def("stop", &RpcServer::stop, RpcServerStop(args("drainTimeout=5.0"), "Stop serving RPC requests. This method is equivalent to *shutdown()*.\n\n:Parameter: *drainTimeout* (float) - maximum time in seconds to wait for accepted requests to complete\n\n::\n\n    rpcServer.stop()"))
         .def("listen", static_cast<void(RpcServer::*)(int)>(&RpcServer::listen), RpcServerListen(args("seconds=0"), "Start serving RPC requests.\n\n:Parameter: *seconds* (int) - specifies the amount of time server should be listening for requests (0 indicates 'forever')\n\n::\n\n    rpcServer.listen(60)\n\n"))
-        .def("shutdown", &RpcServer::shutdown, "Stop serving RPC requests. This method is equivalent to *stop()*.\n\n::\n\n    rpcServer.shutdown()")
+        .def("shutdown", &RpcServer::shutdown, RpcServerShutdown(args("drainTimeout=5.0"), "Stop serving RPC requests. Server stops accepting new requests, and waits for accepted requests to complete before it is destroyed. This method is equivalent to *stop()*.\n\n:Parameter: *drainTimeout* (float) - maximum time in seconds to wait for accepted requests; requests still waiting to be processed after that are rejected, while requests in progress are allowed to complete\n\n::\n\n    rpcServer.shutdown(10.0)"))
+        .def("getMetrics", &RpcServer::getMetrics, "Retrieves metrics for all registered services. Metrics of each service include numbers of processed ('requests'), failed ('errors') and rejected ('rejected') requests, request rate in requests per second ('requestRate'), average and maximum latency in seconds ('averageLatency', 'maxLatency'), and latency histogram ('latencyHistogram'), whose buckets are limited by upper bounds in seconds given in 'latencyHistogramBounds' list; the last histogram bucket counts requests above the last bound. Latency includes time that request waits to be processed. Metrics are collected since service registration or since the last metrics reset ('elapsedTime').\n\n:Returns: dictionary of service metrics dictionaries, keyed by service name\n\n::\n\n    metrics = rpcServer.getMetrics()\n\n    print metrics['createNtTable']['requestRate']\n\n")
+        .def("getServiceMetrics", &RpcServer::getServiceMetrics, args("serviceName"), "Retrieves metrics for given service (see *getMetrics()*).\n\n:Parameter: *serviceName* (str) - service name\n\n:Returns: service metrics dictionary\n\n:Raises: *ObjectNotFound* - if service is not registered\n\n::\n\n    metrics = rpcServer.getServiceMetrics('createNtTable')\n\n")
+        .def("resetMetrics", &RpcServer::resetMetrics, "Resets metrics for all registered services.\n\n::\n\n    rpcServer.resetMetrics()\n\n")
+        ;
+
+    // PVA Server
+    class_<PvaServer, boost::noncopyable>("PvaServer", "PvaServer is a PV access server that publishes PV objects as channels. Clients can get, put and monitor published channels; their requests are served by server threads, and do not need python GIL. Server starts serving requests as soon as it is created.\n\n**PvaServer()**:\n\n\tCreates server without any published channels.\n\n\t::\n\n\t\tpvaServer = PvaServer()\n\n**PvaServer(channelName, pvObject)**:\n\n\t:Parameter: *channelName* (str) - channel name\n\n\t:Parameter: *pvObject* (PvObject) - initial channel value\n\n\tCreates server that publishes single channel.\n\n\t::\n\n\t\tpvaServer = PvaServer('pair', PvObject({'x' : INT, 'y' : INT}, {'x' : 0, 'y' : 0}))\n\n", init<>())
+        .def(init<std::string, PvObject>())
+        .def("addRecord", &PvaServer::addRecord, args("channelName", "pvObject"), "Publishes PV object as a new channel. Structure of channel value is given by the PV object, and cannot be changed by subsequent updates.\n\n:Parameter: *channelName* (str) - channel name\n\n:Parameter: *pvObject* (PvObject) - initial channel value\n\n::\n\n    pvaServer.addRecord('pair', PvObject({'x' : INT, 'y' : INT}))\n\n")
+        .def("removeRecord", &PvaServer::removeRecord, args("channelName"), "Stops publishing given channel.\n\n:Parameter: *channelName* (str) - channel name\n\n:Raises: *ObjectNotFound* - if channel is not published by this server\n\n::\n\n    pvaServer.removeRecord('pair')\n\n")
+        .def("hasRecord", &PvaServer::hasRecord, args("channelName"), "Checks whether given channel is published by this server.\n\n:Parameter: *channelName* (str) - channel name\n\n:Returns: True if channel is published, False otherwise\n\n::\n\n    if pvaServer.hasRecord('pair'):\n\n        print 'Channel pair is published'\n\n")
+        .def("getRecordNames", &PvaServer::getRecordNames, "Retrieves names of all channels published by this server.\n\n:Returns: list of channel names\n\n::\n\n    channelNames = pvaServer.getRecordNames()\n\n")
+        .def("update", static_cast<void(PvaServer::*)(const PvObject&)>(&PvaServer::update), args("pvObject"), "Updates value of the only channel published by this server, and sends the new value to all channel monitors.\n\n:Parameter: *pvObject* (PvObject) - new channel value, which must have the same structure as the published PV object\n\n:Raises: *InvalidRequest* - if server does not publish exactly one channel\n\n:Raises: *InvalidArgument* - if PV object structure does not match channel structure\n\n::\n\n    pvaServer.update(PvObject({'x' : INT, 'y' : INT}, {'x' : 1, 'y' : 2}))\n\n")
+        .def("update", static_cast<void(PvaServer::*)(const std::string&, const PvObject&)>(&PvaServer::update), args("channelName", "pvObject"), "Updates value of the given channel, and sends the new value to all channel monitors. Python GIL is released while updates are prepared for the monitors.\n\n:Parameter: *channelName* (str) - channel name\n\n:Parameter: *pvObject* (PvObject) - new channel value, which must have the same structure as the published PV object\n\n:Raises: *ObjectNotFound* - if channel is not published by this server\n\n:Raises: *InvalidArgument* - if PV object structure does not match channel structure\n\n::\n\n    pvaServer.update('pair', PvObject({'x' : INT, 'y' : INT}, {'x' : 1, 'y' : 2}))\n\n")
+        .def("start", &PvaServer::start, "Starts serving client requests, if server was stopped.\n\n::\n\n    pvaServer.start()\n\n")
+        .def("stop", &PvaServer::stop, "Stops serving client requests and disconnects all clients. Published channels are retained, and are served again after *start()*.\n\n::\n\n    pvaServer.stop()\n\n")
+        .def("isRunning", &PvaServer::isRunning, "Checks whether server is serving client requests.\n\n:Returns: True if server is running, False otherwise\n\n::\n\n    running = pvaServer.isRunning()\n\n")
         ;
     
 }
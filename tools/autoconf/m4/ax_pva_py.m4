@@ -107,6 +107,22 @@ AC_DEFUN([AX_PVA_PY],
         fi
     fi
 
+    # check for numpy (optional)
+    AC_MSG_CHECKING(for numpy)
+    if test -z "$PYTHON"; then
+        ac_numpy_python=python
+    else
+        ac_numpy_python=$PYTHON
+    fi
+    NUMPY_INCLUDE_DIR=`$ac_numpy_python -c "import numpy; print(numpy.get_include())" 2> /dev/null`
+    if test -z "$NUMPY_INCLUDE_DIR"; then
+        AC_MSG_RESULT([no])
+        NUMPY_CPPFLAGS=""
+    else
+        AC_MSG_RESULT([yes])
+        NUMPY_CPPFLAGS="-DPVA_PY_HAVE_NUMPY -I$NUMPY_INCLUDE_DIR"
+    fi
+
     # check for epics base
     AC_MSG_CHECKING(for epics base)
     if test -z $EPICS_BASE; then
@@ -134,7 +150,7 @@ AC_DEFUN([AX_PVA_PY],
     AC_MSG_NOTICE([created $release_local file])
 
     # create CONFIG_SITE.local
-    echo "PVA_PY_CPPFLAGS = $BOOST_CPPFLAGS $PYTHON_CPPFLAGS" >> $config_site_local
+    echo "PVA_PY_CPPFLAGS = $BOOST_CPPFLAGS $PYTHON_CPPFLAGS $NUMPY_CPPFLAGS" >> $config_site_local
     echo "PVA_PY_LDFLAGS = $BOOST_LDFLAGS $PYTHON_LDFLAGS" >> $config_site_local
     echo "PVA_PY_SYS_LIBS = $BOOST_PYTHON_LIB" >> $config_site_local
     echo "PVA_API_VERSION = $PVA_API_VERSION" >> $config_site_local